@@ -78,7 +78,7 @@ function(ppc_configure_subproject SUBDIR)
 
   # Register functional and performance test runners
   add_tests(USE_FUNC_TESTS ${FUNC_TEST_EXEC} functional)
-  add_tests(USE_PERF_TESTS ${PERF_TEST_EXEC} performance)
+  add_tests(USE_PERF_TESTS ${PERF_TEST_OBJECTS} performance)
 
   message(STATUS "${SUBDIR}")
 
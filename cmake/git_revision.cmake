@@ -0,0 +1,22 @@
+# Writes the git revision of SOURCE_DIR into OUTPUT as PPC_GIT_REVISION. Run with
+# cmake -P at build time by the ppc_git_revision target; OUTPUT is only touched
+# when the revision changes, so nothing is rebuilt otherwise.
+set(PPC_GIT_REVISION "unknown")
+if(GIT_EXECUTABLE)
+  execute_process(
+    COMMAND ${GIT_EXECUTABLE} rev-parse --short=12 HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE revision
+    OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET
+    RESULT_VARIABLE result)
+  if(result EQUAL 0 AND revision)
+    set(PPC_GIT_REVISION "${revision}")
+  endif()
+endif()
+
+file(
+  CONFIGURE
+  OUTPUT ${OUTPUT}
+  CONTENT
+    "#pragma once\n\n#define PPC_GIT_REVISION \"@PPC_GIT_REVISION@\"\n"
+  @ONLY)
@@ -25,3 +25,13 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(USE_MPI_PROFILE "Link the PMPI profiling layer into performance tests" ON)
+if(USE_MPI_PROFILE)
+  message(STATUS "Enable MPI profiling in performance tests")
+endif(USE_MPI_PROFILE)
+
+option(USE_ALLOC_PROFILE "Link the allocation hooks into performance tests" OFF)
+if(USE_ALLOC_PROFILE)
+  message(STATUS "Enable allocation accounting in performance tests")
+endif(USE_ALLOC_PROFILE)
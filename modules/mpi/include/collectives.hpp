@@ -0,0 +1,288 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+
+namespace ppc::mpi {
+
+/// @brief A contiguous range of known size, e.g. `std::vector`, `std::array` or `std::span`.
+template <typename Range>
+concept ContiguousBuffer = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>;
+
+template <ContiguousBuffer Range>
+using BufferValue = std::remove_cv_t<std::ranges::range_value_t<Range>>;
+
+/// @brief Returns the rank of the calling process in comm.
+int CommRank(MPI_Comm comm);
+
+/// @brief Returns the number of processes in comm.
+int CommSize(MPI_Comm comm);
+
+namespace detail {
+
+/// @throws std::invalid_argument If actual differs from expected.
+void CheckCount(std::string_view what, std::size_t actual, std::size_t expected);
+
+/// @throws std::invalid_argument If the distribution does not have one part per process of comm.
+void CheckParts(int parts, MPI_Comm comm);
+
+/// @brief Collects buffer size mismatches of the calling process, so that every process of a collective can throw
+/// together instead of leaving the others blocked in it.
+class CountCheck {
+ public:
+  /// @brief Records a mismatch if actual differs from expected; only the first one is kept.
+  void Expect(std::string_view what, std::size_t actual, std::size_t expected);
+
+  /// @brief Agrees on the outcome with all processes of comm; collective.
+  /// @throws std::invalid_argument On every process if any process recorded a mismatch.
+  void Agree(MPI_Comm comm) const;
+
+ private:
+  std::string error_;
+};
+
+void ExchangeHalo(void *data, std::size_t owned, std::size_t halo, MPI_Datatype type, MPI_Comm comm);
+
+/// @brief Reorders cyclically distributed items between rank-major order (as exchanged by MPI) and global order.
+template <typename T>
+void Reorder(std::span<const T> from, std::span<T> to, const CyclicDistribution &dist, std::size_t unit,
+             bool to_global) {
+  std::size_t packed = 0;
+  for (int part = 0; part < dist.Parts(); ++part) {
+    for (int local = 0; local < dist.Count(part); ++local) {
+      const std::size_t global = static_cast<std::size_t>(dist.ToGlobal(part, local)) * unit;
+      for (std::size_t i = 0; i < unit; ++i) {
+        if (to_global) {
+          to[global + i] = from[packed + i];
+        } else {
+          to[packed + i] = from[global + i];
+        }
+      }
+      packed += unit;
+    }
+  }
+}
+
+}  // namespace detail
+
+/// @brief Broadcasts buffer from root; every process must pass a buffer of the same size.
+template <ContiguousBuffer Buffer>
+void Bcast(Buffer &&buffer, int root, MPI_Comm comm) {
+  using T = BufferValue<Buffer>;
+  MPI_Bcast(std::ranges::data(buffer), static_cast<int>(std::ranges::size(buffer)), GetDatatype<T>(), root, comm);
+}
+
+/// @brief Scatters blocks of `unit` elements per item from root, e.g. rows of a row-major matrix with
+/// `unit = cols`. Only root reads send; recv must hold `dist.Count(rank) * unit` elements.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Send, ContiguousBuffer Recv>
+void Scatter(const Send &send, Recv &&recv, const BlockDistribution &dist, int root, MPI_Comm comm, int unit = 1) {
+  using T = BufferValue<Recv>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const auto counts = dist.Counts(unit);
+  const auto displs = dist.Displs(unit);
+  detail::CountCheck check;
+  check.Expect("Scatter receive buffer", std::ranges::size(recv), counts[rank]);
+  if (rank == root) {
+    check.Expect("Scatter send buffer", std::ranges::size(send), static_cast<std::size_t>(dist.Total()) * unit);
+  }
+  check.Agree(comm);
+  MPI_Scatterv(std::ranges::data(send), counts.data(), displs.data(), GetDatatype<T>(), std::ranges::data(recv),
+               counts[rank], GetDatatype<T>(), root, comm);
+}
+
+/// @brief Gathers the blocks of all processes into recv on root; recv is ignored elsewhere.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Send, ContiguousBuffer Recv>
+void Gather(const Send &send, Recv &&recv, const BlockDistribution &dist, int root, MPI_Comm comm, int unit = 1) {
+  using T = BufferValue<Send>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const auto counts = dist.Counts(unit);
+  const auto displs = dist.Displs(unit);
+  detail::CountCheck check;
+  check.Expect("Gather send buffer", std::ranges::size(send), counts[rank]);
+  if (rank == root) {
+    check.Expect("Gather receive buffer", std::ranges::size(recv), static_cast<std::size_t>(dist.Total()) * unit);
+  }
+  check.Agree(comm);
+  MPI_Gatherv(std::ranges::data(send), counts[rank], GetDatatype<T>(), std::ranges::data(recv), counts.data(),
+              displs.data(), GetDatatype<T>(), root, comm);
+}
+
+/// @brief Gathers the blocks of all processes into recv on every process.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Send, ContiguousBuffer Recv>
+void Allgather(const Send &send, Recv &&recv, const BlockDistribution &dist, MPI_Comm comm, int unit = 1) {
+  using T = BufferValue<Send>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const auto counts = dist.Counts(unit);
+  const auto displs = dist.Displs(unit);
+  detail::CountCheck check;
+  check.Expect("Allgather send buffer", std::ranges::size(send), counts[rank]);
+  check.Expect("Allgather receive buffer", std::ranges::size(recv), static_cast<std::size_t>(dist.Total()) * unit);
+  check.Agree(comm);
+  MPI_Allgatherv(std::ranges::data(send), counts[rank], GetDatatype<T>(), std::ranges::data(recv), counts.data(),
+                 displs.data(), GetDatatype<T>(), comm);
+}
+
+/// @brief Scatters cyclically distributed items from root; recv holds the items of this process in local order,
+/// see CyclicDistribution::ToGlobal(). Root packs the items into rank order before a single MPI_Scatterv.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Send, ContiguousBuffer Recv>
+void Scatter(const Send &send, Recv &&recv, const CyclicDistribution &dist, int root, MPI_Comm comm, int unit = 1) {
+  using T = BufferValue<Recv>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const auto counts = dist.Counts(unit);
+  const auto total = static_cast<std::size_t>(dist.Total()) * unit;
+  detail::CountCheck check;
+  check.Expect("Scatter receive buffer", std::ranges::size(recv), counts[rank]);
+  if (rank == root) {
+    check.Expect("Scatter send buffer", std::ranges::size(send), total);
+  }
+  check.Agree(comm);
+  std::vector<T> packed;
+  if (rank == root) {
+    packed.resize(total);
+    detail::Reorder<T>(std::span<const T>(std::ranges::data(send), total), packed, dist, unit, false);
+  }
+  std::vector<int> displs(counts.size(), 0);
+  for (std::size_t part = 1; part < counts.size(); ++part) {
+    displs[part] = displs[part - 1] + counts[part - 1];
+  }
+  MPI_Scatterv(packed.data(), counts.data(), displs.data(), GetDatatype<T>(), std::ranges::data(recv), counts[rank],
+               GetDatatype<T>(), root, comm);
+}
+
+/// @brief Gathers cyclically distributed items into global order on root; recv is ignored elsewhere.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Send, ContiguousBuffer Recv>
+void Gather(const Send &send, Recv &&recv, const CyclicDistribution &dist, int root, MPI_Comm comm, int unit = 1) {
+  using T = BufferValue<Send>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const auto counts = dist.Counts(unit);
+  const auto total = static_cast<std::size_t>(dist.Total()) * unit;
+  detail::CountCheck check;
+  check.Expect("Gather send buffer", std::ranges::size(send), counts[rank]);
+  if (rank == root) {
+    check.Expect("Gather receive buffer", std::ranges::size(recv), total);
+  }
+  check.Agree(comm);
+  std::vector<T> packed;
+  if (rank == root) {
+    packed.resize(total);
+  }
+  std::vector<int> displs(counts.size(), 0);
+  for (std::size_t part = 1; part < counts.size(); ++part) {
+    displs[part] = displs[part - 1] + counts[part - 1];
+  }
+  MPI_Gatherv(std::ranges::data(send), counts[rank], GetDatatype<T>(), packed.data(), counts.data(), displs.data(),
+              GetDatatype<T>(), root, comm);
+  if (rank == root) {
+    detail::Reorder<T>(packed, std::span<T>(std::ranges::data(recv), total), dist, unit, true);
+  }
+}
+
+/// @brief Gathers cyclically distributed items into global order on every process.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Send, ContiguousBuffer Recv>
+void Allgather(const Send &send, Recv &&recv, const CyclicDistribution &dist, MPI_Comm comm, int unit = 1) {
+  using T = BufferValue<Send>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const auto counts = dist.Counts(unit);
+  const auto total = static_cast<std::size_t>(dist.Total()) * unit;
+  detail::CountCheck check;
+  check.Expect("Allgather send buffer", std::ranges::size(send), counts[rank]);
+  check.Expect("Allgather receive buffer", std::ranges::size(recv), total);
+  check.Agree(comm);
+  std::vector<T> packed(total);
+  std::vector<int> displs(counts.size(), 0);
+  for (std::size_t part = 1; part < counts.size(); ++part) {
+    displs[part] = displs[part - 1] + counts[part - 1];
+  }
+  MPI_Allgatherv(std::ranges::data(send), counts[rank], GetDatatype<T>(), packed.data(), counts.data(),
+                 displs.data(), GetDatatype<T>(), comm);
+  detail::Reorder<T>(packed, std::span<T>(std::ranges::data(recv), total), dist, unit, true);
+}
+
+/// @brief Scatters column blocks of a row-major `rows x cols` matrix from root without packing it.
+/// @details dist splits the columns; local receives the `rows x dist.Count(rank)` block, row-major. Column
+/// datatypes describe the strided layout on both sides, so neither root nor the receivers copy into staging buffers.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Matrix, ContiguousBuffer Local>
+void ScatterColumns(const Matrix &matrix, int rows, int cols, Local &&local, const BlockDistribution &dist, int root,
+                    MPI_Comm comm) {
+  using T = BufferValue<Local>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const int local_cols = dist.Count(rank);
+  detail::CountCheck check;
+  check.Expect("ScatterColumns column count", static_cast<std::size_t>(cols), static_cast<std::size_t>(dist.Total()));
+  check.Expect("ScatterColumns receive buffer", std::ranges::size(local), static_cast<std::size_t>(rows) * local_cols);
+  if (rank == root) {
+    check.Expect("ScatterColumns send buffer", std::ranges::size(matrix), static_cast<std::size_t>(rows) * cols);
+  }
+  check.Agree(comm);
+  const auto send_column = Datatype::Column(rows, cols, GetDatatype<T>());
+  const auto recv_column = Datatype::Column(rows, local_cols, GetDatatype<T>());
+  const auto counts = dist.Counts();
+  const auto displs = dist.Displs();
+  MPI_Scatterv(std::ranges::data(matrix), counts.data(), displs.data(), send_column.Get(), std::ranges::data(local),
+               local_cols, recv_column.Get(), root, comm);
+}
+
+/// @brief Gathers the column blocks scattered by ScatterColumns() back into a row-major matrix on root.
+/// @throws std::invalid_argument On every process if the buffer sizes of any process do not match the distribution.
+template <ContiguousBuffer Local, ContiguousBuffer Matrix>
+void GatherColumns(const Local &local, Matrix &&matrix, int rows, int cols, const BlockDistribution &dist, int root,
+                   MPI_Comm comm) {
+  using T = BufferValue<Local>;
+  detail::CheckParts(dist.Parts(), comm);
+  const int rank = CommRank(comm);
+  const int local_cols = dist.Count(rank);
+  detail::CountCheck check;
+  check.Expect("GatherColumns column count", static_cast<std::size_t>(cols), static_cast<std::size_t>(dist.Total()));
+  check.Expect("GatherColumns send buffer", std::ranges::size(local), static_cast<std::size_t>(rows) * local_cols);
+  if (rank == root) {
+    check.Expect("GatherColumns receive buffer", std::ranges::size(matrix), static_cast<std::size_t>(rows) * cols);
+  }
+  check.Agree(comm);
+  const auto send_column = Datatype::Column(rows, local_cols, GetDatatype<T>());
+  const auto recv_column = Datatype::Column(rows, cols, GetDatatype<T>());
+  const auto counts = dist.Counts();
+  const auto displs = dist.Displs();
+  MPI_Gatherv(std::ranges::data(local), local_cols, send_column.Get(), std::ranges::data(matrix), counts.data(),
+              displs.data(), recv_column.Get(), root, comm);
+}
+
+/// @brief Refreshes the ghost cells of a block distributed 1D domain.
+/// @details data is laid out as `[halo | owned | halo]`; the first and last `halo` owned elements go to the previous
+/// and next rank, whose boundary elements fill the ghost cells. Ghost cells of the first and last rank stay
+/// untouched. For rows of a row-major grid, pass `halo = ghost_rows * cols`.
+/// @throws std::invalid_argument If fewer than `halo` elements are owned.
+template <ContiguousBuffer Buffer>
+void ExchangeHalo(Buffer &&data, std::size_t halo, MPI_Comm comm) {
+  using T = BufferValue<Buffer>;
+  const std::size_t size = std::ranges::size(data);
+  if (size < 3 * halo) {
+    detail::CheckCount("ExchangeHalo buffer", size, 3 * halo);
+  }
+  detail::ExchangeHalo(std::ranges::data(data), size - (2 * halo), halo, GetDatatype<T>(), comm);
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+
+namespace ppc::mpi {
+
+/// @brief Returns a committed contiguous datatype of size bytes, created once per size and never freed.
+MPI_Datatype GetBytesDatatype(std::size_t size);
+
+/// @brief Returns the MPI datatype of T.
+/// @details Arithmetic types, bool, std::byte and std::complex map to predefined datatypes; other trivially
+/// copyable types, e.g. plain structs, are sent as contiguous bytes. Byte datatypes are not converted
+/// between nodes with different representations.
+template <typename T>
+MPI_Datatype GetDatatype() {
+  using Value = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<Value, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<Value, signed char>) {
+    return MPI_SIGNED_CHAR;
+  } else if constexpr (std::is_same_v<Value, unsigned char>) {
+    return MPI_UNSIGNED_CHAR;
+  } else if constexpr (std::is_same_v<Value, short>) {
+    return MPI_SHORT;
+  } else if constexpr (std::is_same_v<Value, unsigned short>) {
+    return MPI_UNSIGNED_SHORT;
+  } else if constexpr (std::is_same_v<Value, int>) {
+    return MPI_INT;
+  } else if constexpr (std::is_same_v<Value, unsigned int>) {
+    return MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<Value, long>) {
+    return MPI_LONG;
+  } else if constexpr (std::is_same_v<Value, unsigned long>) {
+    return MPI_UNSIGNED_LONG;
+  } else if constexpr (std::is_same_v<Value, long long>) {
+    return MPI_LONG_LONG;
+  } else if constexpr (std::is_same_v<Value, unsigned long long>) {
+    return MPI_UNSIGNED_LONG_LONG;
+  } else if constexpr (std::is_same_v<Value, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<Value, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<Value, long double>) {
+    return MPI_LONG_DOUBLE;
+  } else if constexpr (std::is_same_v<Value, bool>) {
+    return MPI_CXX_BOOL;
+  } else if constexpr (std::is_same_v<Value, std::byte>) {
+    return MPI_BYTE;
+  } else if constexpr (std::is_same_v<Value, std::complex<float>>) {
+    return MPI_CXX_FLOAT_COMPLEX;
+  } else if constexpr (std::is_same_v<Value, std::complex<double>>) {
+    return MPI_CXX_DOUBLE_COMPLEX;
+  } else {
+    static_assert(std::is_trivially_copyable_v<Value>, "MPI buffers must hold trivially copyable values");
+    return GetBytesDatatype(sizeof(Value));
+  }
+}
+
+/// @brief Owns a committed derived datatype and frees it on destruction.
+class Datatype {
+ public:
+  Datatype() = default;
+  /// @brief Takes ownership of a committed datatype.
+  explicit Datatype(MPI_Datatype type) : type_(type) {}
+  ~Datatype();
+
+  Datatype(const Datatype &) = delete;
+  Datatype &operator=(const Datatype &) = delete;
+  Datatype(Datatype &&other) noexcept;
+  Datatype &operator=(Datatype &&other) noexcept;
+
+  /// @brief Creates `count` blocks of `block_length` elements spaced `stride` elements apart, e.g. a column block
+  /// of a row-major matrix with `count = rows` and `stride = cols`.
+  static Datatype Vector(int count, int block_length, int stride, MPI_Datatype base);
+
+  /// @brief Creates one column of `rows` elements spaced `stride` elements apart, resized so that consecutive
+  /// columns start one element apart. Sending `n` of them transfers `n` adjacent columns of a row-major matrix.
+  static Datatype Column(int rows, int stride, MPI_Datatype base);
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  void Free();
+
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+};
+
+}  // namespace ppc::mpi
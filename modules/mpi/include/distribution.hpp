@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+namespace ppc::mpi {
+
+/// @brief Splits `total` items into contiguous blocks over `parts` processes.
+/// @details The first `total % parts` processes get one extra item, so block sizes differ by at most one.
+/// Items are rows, columns or elements; the `unit` argument of Counts()/Displs() converts items to elements.
+class BlockDistribution {
+ public:
+  /// @throws std::invalid_argument If total is negative or parts is not positive.
+  BlockDistribution(int total, int parts);
+
+  [[nodiscard]] int Total() const {
+    return total_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+
+  /// @brief Returns the number of items of part.
+  [[nodiscard]] int Count(int part) const;
+  /// @brief Returns the index of the first item of part.
+  [[nodiscard]] int Offset(int part) const;
+  /// @brief Returns the part that holds item index.
+  /// @throws std::out_of_range If index is not in [0, Total()).
+  [[nodiscard]] int Owner(int index) const;
+
+  /// @brief Returns Count() of every part multiplied by unit, as passed to MPI_Scatterv and friends.
+  /// @throws std::overflow_error If a count does not fit into int.
+  [[nodiscard]] std::vector<int> Counts(int unit = 1) const;
+  /// @brief Returns Offset() of every part multiplied by unit.
+  /// @throws std::overflow_error If a displacement does not fit into int.
+  [[nodiscard]] std::vector<int> Displs(int unit = 1) const;
+
+ private:
+  int total_;
+  int parts_;
+  int base_;
+  int remainder_;
+};
+
+/// @brief Deals `total` items to `parts` processes in blocks of `block` items, round robin.
+/// @details Part p holds the blocks p, p + parts, p + 2 * parts, ...; the last block may be shorter. Cyclic
+/// distributions balance work that grows or shrinks along the index, e.g. rows of a triangular matrix.
+class CyclicDistribution {
+ public:
+  /// @throws std::invalid_argument If total is negative, or parts or block is not positive.
+  CyclicDistribution(int total, int parts, int block = 1);
+
+  [[nodiscard]] int Total() const {
+    return total_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+  [[nodiscard]] int Block() const {
+    return block_;
+  }
+
+  /// @brief Returns the number of items of part.
+  [[nodiscard]] int Count(int part) const;
+  /// @brief Returns the part that holds item index.
+  /// @throws std::out_of_range If index is not in [0, Total()).
+  [[nodiscard]] int Owner(int index) const;
+  /// @brief Returns the global index of the item stored at local_index on part.
+  [[nodiscard]] int ToGlobal(int part, int local_index) const;
+  /// @brief Returns the position of item index on its owner.
+  [[nodiscard]] int ToLocal(int index) const;
+
+  /// @brief Returns Count() of every part multiplied by unit.
+  /// @throws std::overflow_error If a count does not fit into int.
+  [[nodiscard]] std::vector<int> Counts(int unit = 1) const;
+
+ private:
+  int total_;
+  int parts_;
+  int block_;
+};
+
+}  // namespace ppc::mpi
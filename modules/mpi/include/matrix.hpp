@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "mpi/include/collectives.hpp"
+#include "mpi/include/datatype.hpp"
+#include "util/include/matrix.hpp"
+
+namespace ppc::mpi {
+
+/// @brief Returns a datatype describing one element of view's shape, so that
+/// `MPI_Send(view.Data(), 1, type.Get(), ...)` sends a tile or a column without packing it.
+/// @throws std::invalid_argument If the shape does not fit into int.
+template <typename T>
+Datatype ViewDatatype(const util::MatrixView<T> &view) {
+  constexpr auto kMaxInt = static_cast<std::size_t>(std::numeric_limits<int>::max());
+  if (view.Rows() > kMaxInt || view.Cols() > kMaxInt || view.Stride() > kMaxInt) {
+    throw std::invalid_argument("Matrix view is too large for an MPI datatype");
+  }
+  return Datatype::Vector(static_cast<int>(view.Rows()), static_cast<int>(view.Cols()),
+                          static_cast<int>(view.Stride()), GetDatatype<T>());
+}
+
+/// @brief Broadcasts the shape and the elements of matrix from root, resizing it on the other processes.
+template <typename T>
+void Bcast(util::Matrix<T> &matrix, int root, MPI_Comm comm) {
+  std::array<std::size_t, 2> shape = {matrix.Rows(), matrix.Cols()};
+  Bcast(shape, root, comm);
+  if (CommRank(comm) != root) {
+    matrix = util::Matrix<T>(shape[0], shape[1]);
+  }
+  Bcast(matrix.Flat(), root, comm);
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace ppc::mpi {
+
+/// @brief Read-only memory that exists once per node and is mapped by every process of the node.
+/// @details Backed by an MPI-3 shared window over the processes of comm that share a node
+/// (`MPI_COMM_TYPE_SHARED`). Construction and destruction are collective over the communicator used to create it,
+/// so every process must destroy its object at the same point of the program.
+class NodeSharedMemory {
+ public:
+  NodeSharedMemory() = default;
+  ~NodeSharedMemory();
+
+  NodeSharedMemory(const NodeSharedMemory &) = delete;
+  NodeSharedMemory &operator=(const NodeSharedMemory &) = delete;
+  NodeSharedMemory(NodeSharedMemory &&other) noexcept;
+  NodeSharedMemory &operator=(NodeSharedMemory &&other) noexcept;
+
+  /// @brief Largest piece sent by one MPI_Bcast between node leaders, well below the int count limit.
+  static constexpr std::size_t kMaxChunkBytes = std::size_t{1} << 30;
+
+  /// @brief Copies `bytes` bytes at data on root into one shared segment per node.
+  /// @details Root leads its node and sends the data once to the leader of each other node, in pieces of at most
+  /// chunk_bytes; processes within a node read the leader's copy instead of receiving their own. Only root reads
+  /// data and bytes.
+  /// @throws std::invalid_argument If chunk_bytes is 0 or does not fit into int.
+  static NodeSharedMemory Broadcast(const void *data, std::size_t bytes, int root, MPI_Comm comm,
+                                    std::size_t chunk_bytes = kMaxChunkBytes);
+
+  [[nodiscard]] const void *Data() const {
+    return data_;
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return bytes_;
+  }
+
+ private:
+  void Free();
+
+  MPI_Win win_ = MPI_WIN_NULL;
+  void *data_ = nullptr;
+  std::size_t bytes_ = 0;
+};
+
+/// @brief Array of T broadcast from root with one copy per node, see NodeSharedMemory.
+/// @details Use it for large read-only inputs that every process needs in full, e.g. a graph or a matrix operand;
+/// N processes on a node then hold one copy instead of N.
+template <typename T>
+class NodeSharedArray {
+  static_assert(std::is_trivially_copyable_v<T>, "Shared arrays must hold trivially copyable values");
+
+ public:
+  NodeSharedArray() = default;
+
+  /// @brief Collective over comm; data is only read on root.
+  static NodeSharedArray Broadcast(std::span<const T> data, int root, MPI_Comm comm,
+                                   std::size_t chunk_bytes = NodeSharedMemory::kMaxChunkBytes) {
+    NodeSharedArray array;
+    array.memory_ = NodeSharedMemory::Broadcast(data.data(), data.size_bytes(), root, comm, chunk_bytes);
+    return array;
+  }
+
+  [[nodiscard]] std::span<const T> View() const {
+    return {static_cast<const T *>(memory_.Data()), Size()};
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return memory_.Size() / sizeof(T);
+  }
+  const T &operator[](std::size_t index) const {
+    return View()[index];
+  }
+
+ private:
+  NodeSharedMemory memory_;
+};
+
+}  // namespace ppc::mpi
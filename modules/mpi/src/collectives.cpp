@@ -0,0 +1,79 @@
+#include "mpi/include/collectives.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace ppc::mpi {
+
+int CommRank(MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  return rank;
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  return size;
+}
+
+namespace detail {
+
+void CheckCount(std::string_view what, std::size_t actual, std::size_t expected) {
+  if (actual != expected) {
+    throw std::invalid_argument(std::string(what) + " holds " + std::to_string(actual) + " elements, expected " +
+                                std::to_string(expected));
+  }
+}
+
+void CheckParts(int parts, MPI_Comm comm) {
+  const int size = CommSize(comm);
+  if (parts != size) {
+    throw std::invalid_argument("Distribution over " + std::to_string(parts) + " parts used on a communicator of " +
+                                std::to_string(size) + " processes");
+  }
+}
+
+void CountCheck::Expect(std::string_view what, std::size_t actual, std::size_t expected) {
+  if (actual != expected && error_.empty()) {
+    error_ = std::string(what) + " holds " + std::to_string(actual) + " elements, expected " + std::to_string(expected);
+  }
+}
+
+void CountCheck::Agree(MPI_Comm comm) const {
+  int failed = error_.empty() ? 0 : 1;
+  MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+  if (failed != 0) {
+    throw std::invalid_argument(error_.empty() ? "Buffer size mismatch on another process" : error_);
+  }
+}
+
+void ExchangeHalo(void *data, std::size_t owned, std::size_t halo, MPI_Datatype type, MPI_Comm comm) {
+  if (owned < halo) {
+    throw std::invalid_argument("ExchangeHalo needs at least " + std::to_string(halo) + " owned elements, got " +
+                                std::to_string(owned));
+  }
+  const int rank = CommRank(comm);
+  const int size = CommSize(comm);
+  const int prev = rank > 0 ? rank - 1 : MPI_PROC_NULL;
+  const int next = rank + 1 < size ? rank + 1 : MPI_PROC_NULL;
+
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lower_bound, &extent);
+  auto *bytes = static_cast<char *>(data);
+  const auto at = [&](std::size_t element) { return bytes + (static_cast<MPI_Aint>(element) * extent); };
+  const int count = static_cast<int>(halo);
+
+  // Leading owned elements go down while the trailing ghost cells come up, then the other way round
+  MPI_Sendrecv(at(halo), count, type, prev, 0, at(halo + owned), count, type, next, 0, comm, MPI_STATUS_IGNORE);
+  MPI_Sendrecv(at(owned), count, type, next, 1, at(0), count, type, prev, 1, comm, MPI_STATUS_IGNORE);
+}
+
+}  // namespace detail
+
+}  // namespace ppc::mpi
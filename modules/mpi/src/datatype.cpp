@@ -0,0 +1,78 @@
+#include "mpi/include/datatype.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ppc::mpi {
+
+MPI_Datatype GetBytesDatatype(std::size_t size) {
+  if (size == 0 || size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("Unsupported MPI element size: " + std::to_string(size));
+  }
+  static std::mutex mutex;
+  static std::map<std::size_t, MPI_Datatype> types;
+  const std::scoped_lock lock(mutex);
+  auto it = types.find(size);
+  if (it == types.end()) {
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    MPI_Type_contiguous(static_cast<int>(size), MPI_BYTE, &type);
+    MPI_Type_commit(&type);
+    it = types.emplace(size, type).first;
+  }
+  return it->second;
+}
+
+Datatype::~Datatype() {
+  Free();
+}
+
+Datatype::Datatype(Datatype &&other) noexcept : type_(std::exchange(other.type_, MPI_DATATYPE_NULL)) {}
+
+Datatype &Datatype::operator=(Datatype &&other) noexcept {
+  if (this != &other) {
+    Free();
+    type_ = std::exchange(other.type_, MPI_DATATYPE_NULL);
+  }
+  return *this;
+}
+
+Datatype Datatype::Vector(int count, int block_length, int stride, MPI_Datatype base) {
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_vector(count, block_length, stride, base, &type);
+  MPI_Type_commit(&type);
+  return Datatype(type);
+}
+
+Datatype Datatype::Column(int rows, int stride, MPI_Datatype base) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(base, &lower_bound, &extent);
+  MPI_Datatype column = MPI_DATATYPE_NULL;
+  MPI_Type_vector(rows, 1, stride, base, &column);
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(column, 0, extent, &type);
+  MPI_Type_free(&column);
+  MPI_Type_commit(&type);
+  return Datatype(type);
+}
+
+void Datatype::Free() {
+  if (type_ == MPI_DATATYPE_NULL) {
+    return;
+  }
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized == 0) {
+    MPI_Type_free(&type_);
+  }
+  type_ = MPI_DATATYPE_NULL;
+}
+
+}  // namespace ppc::mpi
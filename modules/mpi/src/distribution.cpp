@@ -0,0 +1,121 @@
+#include "mpi/include/distribution.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::mpi {
+
+namespace {
+
+int Scale(int value, int unit) {
+  const auto scaled = static_cast<int64_t>(value) * unit;
+  if (scaled > std::numeric_limits<int>::max()) {
+    throw std::overflow_error("MPI count " + std::to_string(scaled) + " does not fit into int");
+  }
+  return static_cast<int>(scaled);
+}
+
+void CheckIndex(int index, int total) {
+  if (index < 0 || index >= total) {
+    throw std::out_of_range("Item " + std::to_string(index) + " outside a distribution of " + std::to_string(total) +
+                            " items");
+  }
+}
+
+void CheckShape(int total, int parts) {
+  if (total < 0) {
+    throw std::invalid_argument("Distribution of a negative number of items: " + std::to_string(total));
+  }
+  if (parts <= 0) {
+    throw std::invalid_argument("Distribution over " + std::to_string(parts) + " parts");
+  }
+}
+
+}  // namespace
+
+BlockDistribution::BlockDistribution(int total, int parts)
+    : total_(total), parts_(parts), base_(0), remainder_(0) {
+  CheckShape(total, parts);
+  base_ = total / parts;
+  remainder_ = total % parts;
+}
+
+int BlockDistribution::Count(int part) const {
+  return base_ + (part < remainder_ ? 1 : 0);
+}
+
+int BlockDistribution::Offset(int part) const {
+  return (part * base_) + std::min(part, remainder_);
+}
+
+int BlockDistribution::Owner(int index) const {
+  CheckIndex(index, total_);
+  // The first remainder_ parts hold base_ + 1 items each
+  const int long_items = remainder_ * (base_ + 1);
+  if (index < long_items) {
+    return index / (base_ + 1);
+  }
+  return remainder_ + ((index - long_items) / base_);
+}
+
+std::vector<int> BlockDistribution::Counts(int unit) const {
+  std::vector<int> counts(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; ++part) {
+    counts[part] = Scale(Count(part), unit);
+  }
+  return counts;
+}
+
+std::vector<int> BlockDistribution::Displs(int unit) const {
+  std::vector<int> displs(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; ++part) {
+    displs[part] = Scale(Offset(part), unit);
+  }
+  return displs;
+}
+
+CyclicDistribution::CyclicDistribution(int total, int parts, int block) : total_(total), parts_(parts), block_(block) {
+  CheckShape(total, parts);
+  if (block <= 0) {
+    throw std::invalid_argument("Cyclic distribution with block size " + std::to_string(block));
+  }
+}
+
+int CyclicDistribution::Count(int part) const {
+  const int blocks = (total_ + block_ - 1) / block_;
+  const int last_block = blocks - 1;
+  int count = ((blocks / parts_) + (part < blocks % parts_ ? 1 : 0)) * block_;
+  if (blocks > 0 && last_block % parts_ == part) {
+    // The last block may be shorter than block_
+    count -= (blocks * block_) - total_;
+  }
+  return count;
+}
+
+int CyclicDistribution::Owner(int index) const {
+  CheckIndex(index, total_);
+  return (index / block_) % parts_;
+}
+
+int CyclicDistribution::ToGlobal(int part, int local_index) const {
+  const int round = local_index / block_;
+  return (((round * parts_) + part) * block_) + (local_index % block_);
+}
+
+int CyclicDistribution::ToLocal(int index) const {
+  return ((index / block_ / parts_) * block_) + (index % block_);
+}
+
+std::vector<int> CyclicDistribution::Counts(int unit) const {
+  std::vector<int> counts(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; ++part) {
+    counts[part] = Scale(Count(part), unit);
+  }
+  return counts;
+}
+
+}  // namespace ppc::mpi
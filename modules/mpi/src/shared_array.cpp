@@ -0,0 +1,98 @@
+#include "mpi/include/shared_array.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "mpi/include/collectives.hpp"
+
+namespace ppc::mpi {
+
+NodeSharedMemory::~NodeSharedMemory() {
+  Free();
+}
+
+NodeSharedMemory::NodeSharedMemory(NodeSharedMemory &&other) noexcept
+    : win_(std::exchange(other.win_, MPI_WIN_NULL)),
+      data_(std::exchange(other.data_, nullptr)),
+      bytes_(std::exchange(other.bytes_, 0)) {}
+
+NodeSharedMemory &NodeSharedMemory::operator=(NodeSharedMemory &&other) noexcept {
+  if (this != &other) {
+    Free();
+    win_ = std::exchange(other.win_, MPI_WIN_NULL);
+    data_ = std::exchange(other.data_, nullptr);
+    bytes_ = std::exchange(other.bytes_, 0);
+  }
+  return *this;
+}
+
+NodeSharedMemory NodeSharedMemory::Broadcast(const void *data, std::size_t bytes, int root, MPI_Comm comm,
+                                             std::size_t chunk_bytes) {
+  if (chunk_bytes == 0 || chunk_bytes > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("Unsupported broadcast chunk of " + std::to_string(chunk_bytes) + " bytes");
+  }
+  const int rank = CommRank(comm);
+  auto total = static_cast<std::uint64_t>(bytes);
+  MPI_Bcast(&total, 1, MPI_UINT64_T, root, comm);
+
+  // Key 0 makes root the first process of its node and of the leader communicator
+  const int key = rank == root ? 0 : 1;
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &node_comm);
+  const bool leader = CommRank(node_comm) == 0;
+  MPI_Comm leader_comm = MPI_COMM_NULL;
+  MPI_Comm_split(comm, leader ? 0 : MPI_UNDEFINED, key, &leader_comm);
+
+  NodeSharedMemory memory;
+  memory.bytes_ = static_cast<std::size_t>(total);
+  void *base = nullptr;
+  MPI_Win_allocate_shared(leader ? static_cast<MPI_Aint>(total) : 0, 1, MPI_INFO_NULL, node_comm, &base,
+                          &memory.win_);
+  MPI_Aint segment_size = 0;
+  int disp_unit = 0;
+  MPI_Win_shared_query(memory.win_, 0, &segment_size, &disp_unit, static_cast<void *>(&memory.data_));
+
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, memory.win_);
+  if (leader_comm != MPI_COMM_NULL) {
+    auto *segment = static_cast<char *>(memory.data_);
+    if (rank == root && memory.bytes_ > 0) {
+      std::memcpy(segment, data, memory.bytes_);
+    }
+    for (std::size_t offset = 0; offset < memory.bytes_; offset += chunk_bytes) {
+      const std::size_t chunk = std::min(chunk_bytes, memory.bytes_ - offset);
+      MPI_Bcast(segment + offset, static_cast<int>(chunk), MPI_BYTE, 0, leader_comm);
+    }
+    MPI_Comm_free(&leader_comm);
+  }
+  // Publish the leader's writes to the other processes of the node
+  MPI_Win_sync(memory.win_);
+  MPI_Barrier(node_comm);
+  MPI_Win_sync(memory.win_);
+  MPI_Win_unlock_all(memory.win_);
+  MPI_Comm_free(&node_comm);
+  return memory;
+}
+
+void NodeSharedMemory::Free() {
+  if (win_ == MPI_WIN_NULL) {
+    return;
+  }
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized == 0) {
+    MPI_Win_free(&win_);
+  }
+  win_ = MPI_WIN_NULL;
+  data_ = nullptr;
+  bytes_ = 0;
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,131 @@
+#include "mpi/include/collectives.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/distribution.hpp"
+
+namespace {
+
+// Items beyond a multiple of the number of processes, so that the blocks of the processes differ in size
+struct CollectivesParam {
+  std::string name;
+  int extra_items = 0;
+};
+
+// Run by the MPI runs of core_func_tests on several processes; skipped when the tests start without mpirun
+class CollectivesTest : public ::testing::TestWithParam<CollectivesParam> {
+ protected:
+  void SetUp() override {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0) {
+      GTEST_SKIP() << "MPI is not initialized";
+    }
+    rank_ = ppc::mpi::CommRank(MPI_COMM_WORLD);
+    size_ = ppc::mpi::CommSize(MPI_COMM_WORLD);
+  }
+
+  int rank_ = 0;
+  int size_ = 1;
+};
+
+TEST_P(CollectivesTest, ExchangeHaloFillsGhostCellsFromNeighbours) {
+  constexpr std::size_t kHalo = 2;
+  const auto owned = kHalo + static_cast<std::size_t>(GetParam().extra_items);
+  // Owned elements hold rank * 100 + position; ghost cells start as -1
+  std::vector<int> data(owned + (2 * kHalo), -1);
+  for (std::size_t i = 0; i < owned; ++i) {
+    data[kHalo + i] = (rank_ * 100) + static_cast<int>(i);
+  }
+
+  ppc::mpi::ExchangeHalo(data, kHalo, MPI_COMM_WORLD);
+
+  for (std::size_t i = 0; i < kHalo; ++i) {
+    const int lower = rank_ > 0 ? ((rank_ - 1) * 100) + static_cast<int>(owned - kHalo + i) : -1;
+    const int upper = rank_ + 1 < size_ ? ((rank_ + 1) * 100) + static_cast<int>(i) : -1;
+    EXPECT_EQ(data[i], lower) << "lower ghost cell " << i;
+    EXPECT_EQ(data[kHalo + owned + i], upper) << "upper ghost cell " << i;
+  }
+  for (std::size_t i = 0; i < owned; ++i) {
+    EXPECT_EQ(data[kHalo + i], (rank_ * 100) + static_cast<int>(i));
+  }
+}
+
+TEST_P(CollectivesTest, GatherColumnsRestoresScatteredMatrix) {
+  constexpr int kRows = 3;
+  const int cols = (2 * size_) + GetParam().extra_items;
+  const ppc::mpi::BlockDistribution dist(cols, size_);
+  std::vector<double> matrix(static_cast<std::size_t>(kRows) * static_cast<std::size_t>(cols));
+  std::iota(matrix.begin(), matrix.end(), 0.0);
+
+  std::vector<double> local(static_cast<std::size_t>(kRows) * static_cast<std::size_t>(dist.Count(rank_)));
+  ppc::mpi::ScatterColumns(matrix, kRows, cols, local, dist, 0, MPI_COMM_WORLD);
+  for (int row = 0; row < kRows; ++row) {
+    for (int col = 0; col < dist.Count(rank_); ++col) {
+      EXPECT_EQ(local[(static_cast<std::size_t>(row) * dist.Count(rank_)) + col],
+                matrix[(static_cast<std::size_t>(row) * cols) + dist.Offset(rank_) + col]);
+    }
+  }
+
+  std::vector<double> gathered(rank_ == 0 ? matrix.size() : 0);
+  ppc::mpi::GatherColumns(local, gathered, kRows, cols, dist, 0, MPI_COMM_WORLD);
+  if (rank_ == 0) {
+    EXPECT_EQ(gathered, matrix);
+  }
+}
+
+TEST_P(CollectivesTest, BufferMismatchOnRootThrowsOnEveryProcess) {
+  const int rows = size_ + GetParam().extra_items;
+  constexpr int kCols = 2;
+  const ppc::mpi::BlockDistribution dist(rows, size_);
+  // Root holds one row too few; the other processes pass valid buffers and must not be left inside MPI_Scatterv
+  std::vector<int> matrix(rank_ == 0 ? static_cast<std::size_t>(rows - 1) * kCols : 0);
+  std::vector<int> local(static_cast<std::size_t>(dist.Count(rank_)) * kCols);
+
+  EXPECT_THROW(ppc::mpi::Scatter(matrix, local, dist, 0, MPI_COMM_WORLD, kCols), std::invalid_argument);
+
+  std::vector<int> gathered(rank_ == 0 ? matrix.size() : 0);
+  EXPECT_THROW(ppc::mpi::Gather(local, gathered, dist, 0, MPI_COMM_WORLD, kCols), std::invalid_argument);
+
+  // The processes are still in step: a valid collective afterwards completes
+  matrix.resize(static_cast<std::size_t>(rows) * kCols);
+  std::iota(matrix.begin(), matrix.end(), 0);
+  ppc::mpi::Scatter(matrix, local, dist, 0, MPI_COMM_WORLD, kCols);
+  EXPECT_EQ(local.front(), dist.Offset(rank_) * kCols);
+}
+
+TEST_P(CollectivesTest, VectorDatatypeSelectsStridedBlocks) {
+  // Every process sends blocks of 2 out of every 3 elements to the next one, around a ring
+  const int count = 2 + GetParam().extra_items;
+  const auto vector = ppc::mpi::Datatype::Vector(count, 2, 3, MPI_INT);
+  std::vector<int> send(static_cast<std::size_t>(3 * count));
+  std::iota(send.begin(), send.end(), rank_ * 1000);
+  std::vector<int> recv(static_cast<std::size_t>(2 * count), -1);
+  const int next = (rank_ + 1) % size_;
+  const int prev = (rank_ + size_ - 1) % size_;
+
+  MPI_Sendrecv(send.data(), 1, vector.Get(), next, 0, recv.data(), 2 * count, MPI_INT, prev, 0, MPI_COMM_WORLD,
+               MPI_STATUS_IGNORE);
+
+  for (int block = 0; block < count; ++block) {
+    EXPECT_EQ(recv[2 * block], (prev * 1000) + (3 * block));
+    EXPECT_EQ(recv[(2 * block) + 1], (prev * 1000) + (3 * block) + 1);
+  }
+}
+
+// Named like MPI task tests, so that the `_mpi_` runs select them
+INSTANTIATE_TEST_SUITE_P(
+    Collectives, CollectivesTest,
+    ::testing::Values(CollectivesParam{.name = "collectives_mpi_even_blocks"},
+                      CollectivesParam{.name = "collectives_mpi_uneven_blocks", .extra_items = 1}),
+    [](const ::testing::TestParamInfo<CollectivesParam> &info) { return info.param.name; });
+
+}  // namespace
@@ -0,0 +1,92 @@
+#include "mpi/include/distribution.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "mpi/include/datatype.hpp"
+
+TEST(DistributionTest, BlockGivesRemainderToFirstParts) {
+  const ppc::mpi::BlockDistribution dist(10, 4);
+  EXPECT_EQ(dist.Counts(), (std::vector<int>{3, 3, 2, 2}));
+  EXPECT_EQ(dist.Displs(), (std::vector<int>{0, 3, 6, 8}));
+  EXPECT_EQ(dist.Counts(5), (std::vector<int>{15, 15, 10, 10}));
+  EXPECT_EQ(dist.Displs(5), (std::vector<int>{0, 15, 30, 40}));
+}
+
+TEST(DistributionTest, BlockOwnerMatchesOffsets) {
+  for (int total : {0, 1, 7, 12, 13}) {
+    for (int parts : {1, 2, 5, 16}) {
+      const ppc::mpi::BlockDistribution dist(total, parts);
+      for (int part = 0; part < parts; ++part) {
+        for (int index = dist.Offset(part); index < dist.Offset(part) + dist.Count(part); ++index) {
+          EXPECT_EQ(dist.Owner(index), part) << total << " items over " << parts << " parts";
+        }
+      }
+    }
+  }
+}
+
+TEST(DistributionTest, CyclicDealsBlocksRoundRobin) {
+  const ppc::mpi::CyclicDistribution dist(11, 3, 2);
+  // Blocks {0,1} {2,3} {4,5} {6,7} {8,9} {10}
+  EXPECT_EQ(dist.Counts(), (std::vector<int>{4, 4, 3}));
+  EXPECT_EQ(dist.Owner(7), 0);
+  EXPECT_EQ(dist.Owner(10), 2);
+  EXPECT_EQ(dist.ToGlobal(2, 2), 10);
+  EXPECT_EQ(dist.ToLocal(7), 3);
+}
+
+TEST(DistributionTest, CyclicLocalAndGlobalIndicesRoundTrip) {
+  for (int total : {0, 1, 9, 17}) {
+    for (int parts : {1, 3, 20}) {
+      for (int block : {1, 2, 4}) {
+        const ppc::mpi::CyclicDistribution dist(total, parts, block);
+        int seen = 0;
+        for (int part = 0; part < parts; ++part) {
+          for (int local = 0; local < dist.Count(part); ++local) {
+            const int index = dist.ToGlobal(part, local);
+            EXPECT_EQ(dist.Owner(index), part);
+            EXPECT_EQ(dist.ToLocal(index), local);
+            ++seen;
+          }
+        }
+        EXPECT_EQ(seen, total);
+      }
+    }
+  }
+}
+
+TEST(DistributionTest, RejectsInvalidShapes) {
+  EXPECT_THROW(ppc::mpi::BlockDistribution(-1, 2), std::invalid_argument);
+  EXPECT_THROW(ppc::mpi::BlockDistribution(4, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::mpi::CyclicDistribution(4, 2, 0), std::invalid_argument);
+}
+
+TEST(DistributionTest, OwnerRejectsItemsOutsideTheDistribution) {
+  // Fewer items than parts: every part holds at most one item
+  const ppc::mpi::BlockDistribution block(2, 4);
+  EXPECT_EQ(block.Owner(1), 1);
+  EXPECT_THROW((void)block.Owner(2), std::out_of_range);
+  EXPECT_THROW((void)block.Owner(-1), std::out_of_range);
+  EXPECT_THROW((void)ppc::mpi::BlockDistribution(0, 3).Owner(0), std::out_of_range);
+  EXPECT_THROW((void)ppc::mpi::CyclicDistribution(5, 2).Owner(5), std::out_of_range);
+}
+
+TEST(DistributionTest, RejectsCountsOverflowingInt) {
+  const ppc::mpi::BlockDistribution dist(1 << 20, 2);
+  EXPECT_THROW((void)dist.Counts(1 << 12), std::overflow_error);
+}
+
+TEST(DatatypeTest, MapsArithmeticTypesToPredefinedDatatypes) {
+  EXPECT_EQ(ppc::mpi::GetDatatype<int>(), MPI_INT);
+  EXPECT_EQ(ppc::mpi::GetDatatype<const double>(), MPI_DOUBLE);
+  EXPECT_EQ(ppc::mpi::GetDatatype<unsigned long long>(), MPI_UNSIGNED_LONG_LONG);
+  EXPECT_EQ(ppc::mpi::GetDatatype<bool>(), MPI_CXX_BOOL);
+  EXPECT_EQ(ppc::mpi::GetDatatype<std::byte>(), MPI_BYTE);
+  EXPECT_EQ(ppc::mpi::GetDatatype<std::complex<double>>(), MPI_CXX_DOUBLE_COMPLEX);
+}
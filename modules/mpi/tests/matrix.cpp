@@ -0,0 +1,106 @@
+#include "mpi/include/matrix.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mpi/include/collectives.hpp"
+#include "util/include/matrix.hpp"
+
+namespace {
+
+// Broadcast root: the first or the last process
+struct MatrixParam {
+  std::string name;
+  bool last_root = false;
+};
+
+// Every element holds rank * 1000 + its position, so that received blocks show where they came from
+ppc::util::Matrix<int> NumberedMatrix(std::size_t rows, std::size_t cols, int rank) {
+  ppc::util::Matrix<int> matrix(rows, cols);
+  std::iota(matrix.Flat().begin(), matrix.Flat().end(), rank * 1000);
+  return matrix;
+}
+
+// Run by the MPI runs of core_func_tests on several processes; skipped when the tests start without mpirun
+class MpiMatrixTest : public ::testing::TestWithParam<MatrixParam> {
+ protected:
+  void SetUp() override {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0) {
+      GTEST_SKIP() << "MPI is not initialized";
+    }
+    rank_ = ppc::mpi::CommRank(MPI_COMM_WORLD);
+    size_ = ppc::mpi::CommSize(MPI_COMM_WORLD);
+    root_ = GetParam().last_root ? size_ - 1 : 0;
+  }
+
+  int rank_ = 0;
+  int size_ = 1;
+  int root_ = 0;
+};
+
+TEST_P(MpiMatrixTest, BcastSendsShapeAndElements) {
+  const auto expected = NumberedMatrix(3, 5, root_);
+  // The other processes start with a matrix of another shape, which Bcast replaces
+  auto matrix = rank_ == root_ ? expected : ppc::util::Matrix<int>(1, 2, -1);
+
+  ppc::mpi::Bcast(matrix, root_, MPI_COMM_WORLD);
+
+  EXPECT_EQ(matrix.Rows(), 3U);
+  EXPECT_EQ(matrix.Cols(), 5U);
+  EXPECT_EQ(matrix, expected);
+}
+
+TEST_P(MpiMatrixTest, ViewDatatypeSendsColumnsAndTiles) {
+  // Every process sends column 1 and the 2 x 2 tile at (1, 2) of its matrix to the next one, around a ring
+  constexpr std::size_t kRows = 4;
+  constexpr std::size_t kCols = 5;
+  const auto matrix = NumberedMatrix(kRows, kCols, rank_);
+  const int next = (rank_ + 1) % size_;
+  const int prev = (rank_ + size_ - 1) % size_;
+  const auto prev_matrix = NumberedMatrix(kRows, kCols, prev);
+
+  const auto column = ppc::mpi::ViewDatatype(matrix.Column(1));
+  std::vector<int> column_recv(kRows, -1);
+  MPI_Sendrecv(matrix.Column(1).Data(), 1, column.Get(), next, 0, column_recv.data(), static_cast<int>(kRows),
+               MPI_INT, prev, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  for (std::size_t row = 0; row < kRows; ++row) {
+    EXPECT_EQ(column_recv[row], prev_matrix(row, 1)) << "row " << row;
+  }
+
+  // Received into the same place of a matrix, so that the datatype describes both ends
+  const auto tile = ppc::mpi::ViewDatatype(matrix.Tile(1, 2, 2, 2));
+  ppc::util::Matrix<int> tile_recv(kRows, kCols, -1);
+  MPI_Sendrecv(matrix.Tile(1, 2, 2, 2).Data(), 1, tile.Get(), next, 1, tile_recv.Tile(1, 2, 2, 2).Data(), 1,
+               tile.Get(), prev, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  for (std::size_t row = 0; row < kRows; ++row) {
+    for (std::size_t col = 0; col < kCols; ++col) {
+      const bool in_tile = row >= 1 && row < 3 && col >= 2 && col < 4;
+      EXPECT_EQ(tile_recv(row, col), in_tile ? prev_matrix(row, col) : -1) << "(" << row << ", " << col << ")";
+    }
+  }
+}
+
+TEST_P(MpiMatrixTest, ViewDatatypeRejectsShapesTheIntCountCannotHold) {
+  constexpr auto kTooLarge = static_cast<std::size_t>(std::numeric_limits<int>::max()) + 1;
+  EXPECT_THROW(ppc::mpi::ViewDatatype(ppc::util::MatrixView<const int>(nullptr, kTooLarge, 1, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::mpi::ViewDatatype(ppc::util::MatrixView<const int>(nullptr, 2, 1, kTooLarge)),
+               std::invalid_argument);
+}
+
+// Named like MPI task tests, so that the `_mpi_` runs select them
+INSTANTIATE_TEST_SUITE_P(MpiMatrix, MpiMatrixTest,
+                         ::testing::Values(MatrixParam{.name = "matrix_mpi_first_root"},
+                                           MatrixParam{.name = "matrix_mpi_last_root", .last_root = true}),
+                         [](const ::testing::TestParamInfo<MatrixParam> &info) { return info.param.name; });
+
+}  // namespace
@@ -0,0 +1,105 @@
+#include "mpi/include/shared_array.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mpi/include/collectives.hpp"
+
+namespace {
+
+// Small chunks make the leaders send the array in many pieces, the last one partial, as arrays larger than
+// NodeSharedMemory::kMaxChunkBytes are sent
+struct SharedArrayParam {
+  std::string name;
+  std::size_t chunk_bytes = ppc::mpi::NodeSharedMemory::kMaxChunkBytes;
+  bool last_root = false;
+};
+
+struct Point {
+  int x;
+  double y;
+};
+
+// Run by the MPI runs of core_func_tests on several processes; skipped when the tests start without mpirun
+class NodeSharedArrayTest : public ::testing::TestWithParam<SharedArrayParam> {
+ protected:
+  void SetUp() override {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0) {
+      GTEST_SKIP() << "MPI is not initialized";
+    }
+    rank_ = ppc::mpi::CommRank(MPI_COMM_WORLD);
+    size_ = ppc::mpi::CommSize(MPI_COMM_WORLD);
+    root_ = GetParam().last_root ? size_ - 1 : 0;
+  }
+
+  int rank_ = 0;
+  int size_ = 1;
+  int root_ = 0;
+};
+
+TEST_P(NodeSharedArrayTest, EveryProcessSeesTheRootData) {
+  std::vector<int> expected(1001);
+  std::iota(expected.begin(), expected.end(), -500);
+  // Only root may read its input
+  std::vector<int> input = rank_ == root_ ? expected : std::vector<int>{};
+
+  const auto array = ppc::mpi::NodeSharedArray<int>::Broadcast(input, root_, MPI_COMM_WORLD, GetParam().chunk_bytes);
+
+  ASSERT_EQ(array.Size(), expected.size());
+  const auto view = array.View();
+  EXPECT_EQ(std::vector<int>(view.begin(), view.end()), expected);
+  EXPECT_EQ(array[0], -500);
+  EXPECT_EQ(array[1000], 500);
+}
+
+TEST_P(NodeSharedArrayTest, KeepsStructValues) {
+  std::vector<Point> input;
+  if (rank_ == root_) {
+    for (int i = 0; i < 37; ++i) {
+      input.push_back({.x = i, .y = i * 0.5});
+    }
+  }
+
+  const auto array = ppc::mpi::NodeSharedArray<Point>::Broadcast(input, root_, MPI_COMM_WORLD, GetParam().chunk_bytes);
+
+  ASSERT_EQ(array.Size(), 37U);
+  for (std::size_t i = 0; i < array.Size(); ++i) {
+    EXPECT_EQ(array[i].x, static_cast<int>(i));
+    EXPECT_DOUBLE_EQ(array[i].y, static_cast<double>(i) * 0.5);
+  }
+}
+
+TEST_P(NodeSharedArrayTest, EmptyArrayHasNoElements) {
+  const auto array =
+      ppc::mpi::NodeSharedArray<int>::Broadcast(std::span<const int>{}, root_, MPI_COMM_WORLD, GetParam().chunk_bytes);
+
+  EXPECT_EQ(array.Size(), 0U);
+  EXPECT_TRUE(array.View().empty());
+}
+
+TEST_P(NodeSharedArrayTest, RejectsChunksTheIntCountCannotHold) {
+  const std::vector<int> input(4, rank_);
+  EXPECT_THROW(ppc::mpi::NodeSharedArray<int>::Broadcast(input, root_, MPI_COMM_WORLD, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::mpi::NodeSharedArray<int>::Broadcast(input, root_, MPI_COMM_WORLD, std::size_t{1} << 31),
+               std::invalid_argument);
+}
+
+// Named like MPI task tests, so that the `_mpi_` runs select them
+INSTANTIATE_TEST_SUITE_P(
+    SharedArray, NodeSharedArrayTest,
+    ::testing::Values(SharedArrayParam{.name = "shared_array_mpi_whole"},
+                      SharedArrayParam{.name = "shared_array_mpi_chunked", .chunk_bytes = 7},
+                      SharedArrayParam{
+                          .name = "shared_array_mpi_chunked_last_root", .chunk_bytes = 64, .last_root = true}),
+    [](const ::testing::TestParamInfo<SharedArrayParam> &info) { return info.param.name; });
+
+}  // namespace
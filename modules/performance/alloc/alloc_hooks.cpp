@@ -0,0 +1,248 @@
+// Allocation hooks. Compiled only into ppc_perf_tests (see tasks/CMakeLists.txt), where they feed
+// ppc::performance::AllocProfile. With glibc the C allocation functions are interposed and forwarded to the
+// __libc_* entry points, so operator new, the C++ library and C code are all counted; elsewhere only the
+// replaceable operator new/delete are, including their std::align_val_t overloads.
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "performance/include/alloc_profile.hpp"
+
+#ifdef __GLIBC__
+#  include <malloc.h>
+
+#  include <cerrno>
+
+// glibc's own allocator entry points, which the definitions below forward to
+// NOLINTBEGIN(bugprone-reserved-identifier)
+extern "C" void *__libc_malloc(std::size_t size);
+extern "C" void *__libc_calloc(std::size_t count, std::size_t size);
+extern "C" void *__libc_realloc(void *ptr, std::size_t size);
+extern "C" void *__libc_memalign(std::size_t alignment, std::size_t size);
+extern "C" void __libc_free(void *ptr);
+// NOLINTEND(bugprone-reserved-identifier)
+#endif
+
+namespace {
+
+using ppc::performance::AllocProfile;
+
+[[maybe_unused]] const bool kInterposed = AllocProfile::MarkInterposed();
+
+#ifdef __GLIBC__
+
+void *Counted(void *ptr) {
+  if (ptr != nullptr) {
+    AllocProfile::RecordAlloc(malloc_usable_size(ptr));
+  }
+  return ptr;
+}
+
+bool IsPowerOfTwo(std::size_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+#endif
+
+}  // namespace
+
+#ifdef __GLIBC__
+
+extern "C" {
+
+void *malloc(std::size_t size) noexcept {
+  return Counted(__libc_malloc(size));
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept {
+  return Counted(__libc_calloc(count, size));
+}
+
+void *realloc(void *ptr, std::size_t size) noexcept {
+  const std::size_t old_size = ptr != nullptr ? malloc_usable_size(ptr) : 0;
+  void *res = __libc_realloc(ptr, size);
+  if (res == nullptr && size != 0) {
+    // The old block is still allocated
+    return nullptr;
+  }
+  if (ptr != nullptr) {
+    AllocProfile::RecordFree(old_size);
+  }
+  return Counted(res);
+}
+
+void *memalign(std::size_t alignment, std::size_t size) noexcept {
+  return Counted(__libc_memalign(alignment, size));
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+  return Counted(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void **memptr, std::size_t alignment, std::size_t size) noexcept {
+  if (!IsPowerOfTwo(alignment) || alignment % sizeof(void *) != 0) {
+    return EINVAL;
+  }
+  void *ptr = Counted(__libc_memalign(alignment, size));
+  if (ptr == nullptr) {
+    return ENOMEM;
+  }
+  *memptr = ptr;
+  return 0;
+}
+
+void free(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  AllocProfile::RecordFree(malloc_usable_size(ptr));
+  __libc_free(ptr);
+}
+
+}  // extern "C"
+
+#else
+
+namespace {
+
+// Every block starts with a header holding the requested size, padded to keep the default new alignment
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+void *CountedNew(std::size_t size) noexcept {
+  auto *block = static_cast<unsigned char *>(std::malloc(size + kHeader));
+  if (block == nullptr) {
+    return nullptr;
+  }
+  *reinterpret_cast<std::size_t *>(block) = size;
+  AllocProfile::RecordAlloc(size);
+  return block + kHeader;
+}
+
+void CountedDelete(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto *block = static_cast<unsigned char *>(ptr) - kHeader;
+  AllocProfile::RecordFree(*reinterpret_cast<std::size_t *>(block));
+  std::free(block);
+}
+
+// Over-aligned blocks keep the requested size and the address returned by malloc in the two words before the
+// aligned pointer; alignments below the default are raised to it, so those words stay aligned
+void *CountedAlignedNew(std::size_t size, std::align_val_t align) noexcept {
+  const std::size_t alignment = std::max(static_cast<std::size_t>(align), alignof(std::max_align_t));
+  constexpr std::size_t kWords = 2 * sizeof(std::uintptr_t);
+  void *raw = std::malloc(size + alignment + kWords);
+  if (raw == nullptr) {
+    return nullptr;
+  }
+  const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + kWords + alignment - 1) & ~(alignment - 1);
+  auto *words = reinterpret_cast<std::uintptr_t *>(aligned) - 2;
+  words[0] = size;
+  words[1] = reinterpret_cast<std::uintptr_t>(raw);
+  AllocProfile::RecordAlloc(size);
+  return reinterpret_cast<void *>(aligned);
+}
+
+void CountedAlignedDelete(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  const auto *words = static_cast<std::uintptr_t *>(ptr) - 2;
+  AllocProfile::RecordFree(words[0]);
+  std::free(reinterpret_cast<void *>(words[1]));
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  void *ptr = CountedNew(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return CountedNew(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return CountedNew(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  CountedDelete(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  CountedDelete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  CountedDelete(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  CountedDelete(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  CountedDelete(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  CountedDelete(ptr);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  void *ptr = CountedAlignedNew(size, align);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+  return ::operator new(size, align);
+}
+
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t & /*tag*/) noexcept {
+  return CountedAlignedNew(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t & /*tag*/) noexcept {
+  return CountedAlignedNew(size, align);
+}
+
+void operator delete(void *ptr, std::align_val_t /*align*/) noexcept {
+  CountedAlignedDelete(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*align*/) noexcept {
+  CountedAlignedDelete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept {
+  CountedAlignedDelete(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept {
+  CountedAlignedDelete(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t /*align*/, const std::nothrow_t & /*tag*/) noexcept {
+  CountedAlignedDelete(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*align*/, const std::nothrow_t & /*tag*/) noexcept {
+  CountedAlignedDelete(ptr);
+}
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Allocation counters of the calling process at the start of a measured region.
+struct AllocSnapshot {
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+  int64_t live_bytes = 0;
+};
+
+/// @brief Allocations and memory of one part of a performance run on one process.
+struct PerfStageAlloc {
+  /// @brief Pipeline stage or one-off setup stage, as in PerfStageTime.
+  std::string name;
+  /// @brief Allocations per measured run (the single measurement for setup stages).
+  double allocations = 0.0;
+  /// @brief Bytes allocated per measured run; freed memory is not subtracted.
+  double bytes = 0.0;
+  /// @brief Largest growth of live heap memory above its level at the start of the stage, over all runs.
+  uint64_t peak_heap_bytes = 0;
+  /// @brief Peak resident set size of the process during the stage on Linux; the peak since the process started on
+  /// other systems, which cannot reset it.
+  uint64_t peak_rss_bytes = 0;
+};
+
+/// @brief Process-wide heap accounting fed by the allocation hooks linked into ppc_perf_tests.
+/// @details The hooks are only part of the performance test executable built with USE_ALLOC_PROFILE; in other
+/// binaries IsInterposed() returns false and nothing is counted. Counters are shared by all threads of the process.
+class AllocProfile {
+ public:
+  /// @brief Counts one allocation of bytes usable bytes.
+  static void RecordAlloc(std::size_t bytes);
+  /// @brief Counts the release of a block of bytes usable bytes.
+  static void RecordFree(std::size_t bytes);
+  /// @brief Called once by the allocation hooks during static initialization.
+  static bool MarkInterposed();
+  /// @brief Returns true if the allocation hooks are linked into the current executable.
+  static bool IsInterposed();
+  /// @brief Starts a measured region and restarts peak tracking from the current live heap size and, on Linux, from
+  /// the current resident set size.
+  static AllocSnapshot Begin();
+  /// @brief Returns the allocations since begin as one run of stage name.
+  static PerfStageAlloc End(const std::string &name, const AllocSnapshot &begin);
+  /// @brief Returns the peak resident set size of the process in bytes since the last Begin() on Linux (`VmHWM`),
+  /// since the process started on other systems, 0 where unavailable.
+  static uint64_t PeakRssBytes();
+  /// @brief Gathers the stage allocations of all processes on rank 0 and formats one line per rank.
+  /// @param prefix Prefix of every report line (e.g. "<test_id>:<type>").
+  /// @param collective Gather over ppc::util::GetTaskComm(); otherwise only the calling process is reported.
+  /// @return The report on rank 0, an empty string on other ranks.
+  /// @note Every process must pass the same stage names when collective; uses PMPI directly so that the MPI
+  /// profile does not count the gather.
+  static std::string GatherReport(const std::string &prefix, const std::vector<PerfStageAlloc> &stages,
+                                  bool collective);
+};
+
+}  // namespace ppc::performance
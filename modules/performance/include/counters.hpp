@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Hardware events sampled by HardwareCounters.
+enum class CounterEvent : uint8_t { kCycles, kInstructions, kLlcMisses, kBranchMisses, kDtlbMisses, kCount };
+
+/// @brief Raw event counts, indexed by CounterEvent.
+using CounterValues = std::array<uint64_t, static_cast<std::size_t>(CounterEvent::kCount)>;
+
+/// @brief Returns the name of a counter event as printed in the performance report.
+std::string GetCounterEventName(CounterEvent event);
+
+/// @brief Hardware counter summary attached to PerfResults.
+struct CounterResults {
+  /// @brief Counters were requested for the run.
+  bool enabled = false;
+  /// @brief At least one counter could be opened (false when the kernel forbids it).
+  bool available = false;
+  /// @brief Number of Task::Run() calls the totals were collected over.
+  uint64_t runs = 0;
+  /// @brief Per-event totals over all measured Task::Run() calls.
+  CounterValues totals{};
+  /// @brief Per-event flag telling whether the event is supported on this machine.
+  std::array<bool, static_cast<std::size_t>(CounterEvent::kCount)> supported{};
+  /// @brief Instructions per cycle.
+  double ipc = 0.0;
+  /// @brief Number of elements processed per run, used for the per-element metrics (0 if unknown).
+  uint64_t num_elements = 0;
+
+  /// @brief Returns the per-run average of an event divided by num_elements (or per-run average if 0).
+  [[nodiscard]] double PerElement(CounterEvent event) const;
+};
+
+/// @brief Linux perf_event_open counters of all threads of the process.
+/// @details Every event is opened on each thread running at construction, so OpenMP, TBB and ThreadPool workers
+/// started earlier are counted, and inherited by threads they start later. Every event is opened separately so
+/// that unsupported events (common in virtual machines) do not disable the others. On other platforms or when
+/// counters are forbidden (see /proc/sys/kernel/perf_event_paranoid) Available() returns false and Start()/Stop()
+/// are no-ops.
+class HardwareCounters {
+ public:
+  HardwareCounters();
+  ~HardwareCounters();
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+
+  /// @brief Returns true if at least one event is being counted.
+  [[nodiscard]] bool Available() const;
+  /// @brief Returns true if the given event is being counted.
+  [[nodiscard]] bool Supported(CounterEvent event) const;
+  /// @brief Starts counting.
+  void Start();
+  /// @brief Stops counting and adds the counts since Start() to the totals.
+  void Stop();
+  /// @brief Returns the accumulated counts.
+  [[nodiscard]] const CounterValues &Totals() const {
+    return totals_;
+  }
+
+ private:
+  [[nodiscard]] CounterValues Read() const;
+
+  std::array<std::vector<int>, static_cast<std::size_t>(CounterEvent::kCount)> fds_{};
+  CounterValues start_{};
+  CounterValues totals_{};
+};
+
+}  // namespace ppc::performance
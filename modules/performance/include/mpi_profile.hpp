@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ppc::performance {
+
+/// @brief MPI routines intercepted by the PMPI profiling layer.
+enum class MpiCall : uint8_t {
+  kSend,
+  kRecv,
+  kIsend,
+  kIrecv,
+  kSendrecv,
+  kWait,
+  kProbe,
+  kBarrier,
+  kBcast,
+  kScatter,
+  kScatterv,
+  kGather,
+  kGatherv,
+  kAllgather,
+  kAllgatherv,
+  kReduce,
+  kAllreduce,
+  kScan,
+  kAlltoall,
+  kAlltoallv,
+  kCount
+};
+
+/// @brief Returns the MPI routine name of a profiled call (e.g. "MPI_Bcast").
+std::string GetMpiCallName(MpiCall call);
+
+/// @brief Returns true for calls whose time is counted as blocked waiting (receives, waits, probes, barriers).
+bool IsMpiWaitCall(MpiCall call);
+
+/// @brief Accumulated statistics of one MPI routine on one process.
+struct MpiCallStats {
+  uint64_t calls = 0;
+  uint64_t bytes_sent = 0;
+  uint64_t bytes_received = 0;
+  double time_sec = 0.0;
+};
+
+/// @brief Per-process MPI profile.
+struct MpiProfileData {
+  std::array<MpiCallStats, static_cast<std::size_t>(MpiCall::kCount)> calls{};
+  /// @brief Time the test harness spent in its own MPI calls (start barriers, stop flags, sample reductions).
+  double harness_time_sec = 0.0;
+
+  /// @brief Total time spent inside profiled MPI routines.
+  [[nodiscard]] double MpiTime() const;
+  /// @brief Time spent in blocking receives, waits, probes and barriers.
+  [[nodiscard]] double WaitTime() const;
+  [[nodiscard]] uint64_t BytesSent() const;
+  [[nodiscard]] uint64_t BytesReceived() const;
+};
+
+/// @brief Process-wide accumulator fed by the PMPI wrappers linked into ppc_perf_tests.
+/// @details The wrappers are only part of the performance test executable; in other binaries
+/// IsInterposed() returns false and the profile stays empty.
+class MpiProfile {
+ public:
+  /// @brief Adds one completed MPI call to the profile of the calling process.
+  static void Record(MpiCall call, double time_sec, uint64_t bytes_sent, uint64_t bytes_received);
+  /// @brief Books time of a harness MPI call, made through PMPI so it is not profiled, apart from the task.
+  /// @details GatherReport() takes it out of the wall time, so it does not show up as compute either.
+  static void RecordHarness(double time_sec);
+  /// @brief Clears the profile of the calling process.
+  static void Reset();
+  /// @brief Returns the profile of the calling process.
+  static const MpiProfileData &Get();
+  /// @brief Called once by the PMPI wrappers during static initialization.
+  static bool MarkInterposed();
+  /// @brief Returns true if the PMPI wrappers are linked into the current executable.
+  static bool IsInterposed();
+  /// @brief Gathers the profiles of all processes on rank 0 and formats the per-rank report.
+  /// @param prefix Prefix of every report line (e.g. "<test_id>:<type>").
+  /// @param wall_time_sec Wall time of the profiled region on the calling process, including harness MPI calls.
+  /// @return The report on rank 0, an empty string on other ranks.
+  /// @note Collective over ppc::util::GetTaskComm(); uses PMPI directly so that it does not profile itself.
+  static std::string GatherReport(const std::string &prefix, double wall_time_sec);
+
+ private:
+  static MpiProfileData &Data();
+};
+
+}  // namespace ppc::performance
@@ -1,15 +1,27 @@
 #pragma once
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "performance/include/alloc_profile.hpp"
+#include "performance/include/counters.hpp"
 #include "task/include/task.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::performance {
@@ -18,18 +30,189 @@ inline double DefaultTimer() {
   return -1.0;
 }
 
+inline bool DefaultSyncStop(bool stop) {
+  return stop;
+}
+
+inline void DefaultSyncStart() {}
+
+/// @brief Per-run elapsed times reduced over the processes of a distributed run.
+struct RankSamples {
+  /// @brief Number of processes the samples were reduced over (1 for a local run).
+  int processes = 1;
+  /// @brief Fastest, mean and slowest elapsed time over the processes, one entry per measured run.
+  std::vector<double> min_sec;
+  std::vector<double> mean_sec;
+  std::vector<double> max_sec;
+  /// @brief Process with the largest total elapsed time over all runs.
+  int slowest_rank = 0;
+};
+
+inline RankSamples DefaultReduceSamples(const std::vector<double> &samples) {
+  return {.processes = 1, .min_sec = samples, .mean_sec = samples, .max_sec = samples, .slowest_rank = 0};
+}
+
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Number of unmeasured runs executed before the measured ones.
+  uint64_t num_warmup = 0;
+  /// @brief Keep running after num_running runs until the relative standard error reaches target_rse.
+  bool adaptive = false;
+  /// @brief Target relative standard error of the mean (stddev / sqrt(n) / mean) in adaptive mode.
+  double target_rse = 0.02;
+  /// @brief Upper bound on the number of measured runs in adaptive mode.
+  uint64_t max_running = 1000;
+  /// @brief Wall-clock budget in seconds for the measured runs in adaptive mode, GetPerfMaxTime() if not positive.
+  double time_budget_sec = 0.0;
+  /// @brief Collects hardware performance counters around every measured Task::Run() call.
+  bool collect_counters = false;
+  /// @brief Number of elements processed by one run, used to normalize counters (0 if unknown).
+  uint64_t num_elements = 0;
+  /// @brief Makes the adaptive stop decision identical on every process (e.g. broadcast from rank 0).
+  /// @cond
+  std::function<bool(bool)> sync_stop = DefaultSyncStop;
+  /// @endcond
+  /// @brief Called on every process right before each measured run starts, e.g. a barrier aligning the ranks.
+  /// @cond
+  std::function<void()> sync_start = DefaultSyncStart;
+  /// @endcond
+  /// @brief Reduces the per-run elapsed times of this process over all processes. With more than one process the
+  /// reported samples become the per-run maximum, i.e. the time of the slowest process.
+  /// @cond
+  std::function<RankSamples(const std::vector<double> &)> reduce_samples = DefaultReduceSamples;
+  /// @endcond
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
 };
 
+/// @brief Summary statistics over the per-iteration samples of a performance run.
+struct PerfStatistics {
+  double min_sec = 0.0;
+  double median_sec = 0.0;
+  double p90_sec = 0.0;
+  double p99_sec = 0.0;
+  double stddev_sec = 0.0;
+  /// @brief Relative standard error of the mean.
+  double rse = 0.0;
+  /// @brief Bounds of the bootstrap confidence interval of the mean.
+  double ci_low_sec = 0.0;
+  double ci_high_sec = 0.0;
+  constexpr static double kConfidenceLevel = 0.95;
+  constexpr static std::size_t kBootstrapResamples = 1000;
+  constexpr static std::uint32_t kBootstrapSeed = 42;
+};
+
+/// @brief Returns the q-quantile (0 <= q <= 1) of sorted samples using linear interpolation.
+inline double SortedQuantile(const std::vector<double> &sorted, double q) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double pos = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted.size() - 1);
+  const auto lo = static_cast<std::size_t>(std::floor(pos));
+  const auto hi = static_cast<std::size_t>(std::ceil(pos));
+  const double frac = pos - static_cast<double>(lo);
+  return sorted[lo] + ((sorted[hi] - sorted[lo]) * frac);
+}
+
+/// @brief Returns the sample standard deviation (n - 1 in the denominator).
+inline double SampleStdDev(const std::vector<double> &samples, double mean) {
+  if (samples.size() < 2) {
+    return 0.0;
+  }
+  double sq_sum = 0.0;
+  for (double s : samples) {
+    sq_sum += (s - mean) * (s - mean);
+  }
+  return std::sqrt(sq_sum / static_cast<double>(samples.size() - 1));
+}
+
+/// @brief Returns the relative standard error of the mean, 0 for empty or zero-mean samples.
+inline double RelativeStdError(const std::vector<double> &samples) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const auto n = static_cast<double>(samples.size());
+  const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  return mean > 0.0 ? SampleStdDev(samples, mean) / std::sqrt(n) / mean : 0.0;
+}
+
+/// @brief Computes min/median/percentiles/stddev and a bootstrap confidence interval of the mean.
+/// @details The bootstrap uses a fixed seed so that repeated reports of the same samples are identical.
+inline PerfStatistics ComputeStatistics(const std::vector<double> &samples) {
+  PerfStatistics stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::vector<double> sorted = samples;
+  std::ranges::sort(sorted);
+  const auto n = static_cast<double>(sorted.size());
+  const double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+
+  stats.min_sec = sorted.front();
+  stats.median_sec = SortedQuantile(sorted, 0.5);
+  stats.p90_sec = SortedQuantile(sorted, 0.9);
+  stats.p99_sec = SortedQuantile(sorted, 0.99);
+  stats.stddev_sec = SampleStdDev(sorted, mean);
+  stats.rse = mean > 0.0 ? stats.stddev_sec / std::sqrt(n) / mean : 0.0;
+
+  std::mt19937 gen(PerfStatistics::kBootstrapSeed);
+  std::uniform_int_distribution<std::size_t> pick(0, sorted.size() - 1);
+  std::vector<double> means(PerfStatistics::kBootstrapResamples);
+  for (double &resample_mean : means) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < sorted.size(); i++) {
+      sum += sorted[pick(gen)];
+    }
+    resample_mean = sum / n;
+  }
+  std::ranges::sort(means);
+  const double alpha = (1.0 - PerfStatistics::kConfidenceLevel) / 2.0;
+  stats.ci_low_sec = SortedQuantile(means, alpha);
+  stats.ci_high_sec = SortedQuantile(means, 1.0 - alpha);
+  return stats;
+}
+
+/// @brief Time spent in one part of a performance run.
+struct PerfStageTime {
+  /// @brief Pipeline stage ("Validation", "PreProcessing", "Run", "PostProcessing"), one-off setup stage
+  /// ("Construct") or the name of a ppc::util::trace::ScopedSpan recorded by the task.
+  std::string name;
+  /// @brief Mean time per measured run in seconds (the single measurement for setup stages).
+  double time_sec = 0.0;
+};
+
+/// @brief Spread of the measured runs over processes, averaged over the runs.
+struct PerfRankStatistics {
+  /// @brief Number of processes; 1 if the run was not reduced over processes.
+  int processes = 1;
+  double min_sec = 0.0;
+  double mean_sec = 0.0;
+  double max_sec = 0.0;
+  /// @brief Load imbalance max_sec / mean_sec; 1 means every process took the same time.
+  double imbalance = 1.0;
+  int slowest_rank = 0;
+};
+
 struct PerfResults {
-  /// @brief Measured execution time in seconds.
+  /// @brief Measured execution time in seconds (mean over the measured runs).
   double time_sec = 0.0;
+  /// @brief Execution time of every measured run in seconds, warmup runs excluded.
+  std::vector<double> samples;
+  /// @brief Statistics computed over samples.
+  PerfStatistics statistics;
+  /// @brief Hardware counters collected around Task::Run() when PerfAttr::collect_counters is set.
+  CounterResults counters;
+  /// @brief Per-stage breakdown: setup stages, then the timed pipeline stages, then task spans.
+  /// @details Span times are summed over all threads of the process, so they may exceed the stage time.
+  std::vector<PerfStageTime> stages;
+  /// @brief Spread over processes when PerfAttr::reduce_samples combines several of them.
+  PerfRankStatistics ranks;
+  /// @brief Per-stage heap accounting of this process: setup stages, then the pipeline stages.
+  /// @details Empty unless the executable is built with the allocation hooks (USE_ALLOC_PROFILE).
+  std::vector<PerfStageAlloc> allocations;
   enum class TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone };
   TypeOfRunning type_of_running = TypeOfRunning::kNone;
   constexpr static double kMaxTime = 10.0;
@@ -41,18 +224,21 @@ class Perf {
   // Init performance analysis with an initialized task and initialized data
   explicit Perf(const ppc::task::TaskPtr<InType, OutType> &task_ptr) : task_(task_ptr) {
     task_ptr->GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+    task_ptr->PinThreads();
   }
   // Check performance of full task's pipeline:  PreProcessing() ->
   // Validation() -> Run() -> PostProcessing()
   void PipelineRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
+    BeginCounters(perf_attr);
     CommonRun(perf_attr, [&] {
-      task_->Validation();
-      task_->PreProcessing();
-      task_->Run();
-      task_->PostProcessing();
-    }, perf_results_);
+      TimedStage("Validation", [&] { task_->Validation(); });
+      TimedStage("PreProcessing", [&] { task_->PreProcessing(); });
+      TimedStage("Run", [&] { CountedRun(); });
+      TimedStage("PostProcessing", [&] { task_->PostProcessing(); });
+    });
+    EndCounters();
   }
   // Check performance of task's Run() function
   void TaskRun(const PerfAttr &perf_attr) {
@@ -60,7 +246,9 @@ class Perf {
 
     task_->Validation();
     task_->PreProcessing();
-    CommonRun(perf_attr, [&] { task_->Run(); }, perf_results_);
+    BeginCounters(perf_attr);
+    CommonRun(perf_attr, [&] { TimedStage("Run", [&] { CountedRun(); }); });
+    EndCounters();
     task_->PostProcessing();
 
     task_->Validation();
@@ -87,6 +275,14 @@ class Perf {
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      std::cout << test_id << ":" << type_test_name << ":stats:" << FormatStatistics() << '\n';
+      std::cout << test_id << ":" << type_test_name << ":stages:" << FormatStages() << '\n';
+      if (perf_results_.counters.enabled) {
+        std::cout << test_id << ":" << type_test_name << ":counters:" << FormatCounters() << '\n';
+      }
+      if (perf_results_.ranks.processes > 1) {
+        std::cout << test_id << ":" << type_test_name << ":ranks:" << FormatRanks() << '\n';
+      }
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -97,6 +293,14 @@ class Perf {
       throw std::runtime_error(err_msg.str().c_str());
     }
   }
+  /// @brief Adds a stage executed once before the measured runs (e.g. task construction) to the breakdown.
+  void RecordSetupStage(const std::string &name, double time_sec) {
+    setup_stages_.push_back({.name = name, .time_sec = time_sec});
+  }
+  /// @brief Adds the allocations of a stage executed once before the measured runs to the breakdown.
+  void RecordSetupAlloc(const PerfStageAlloc &alloc) {
+    setup_allocs_.push_back(alloc);
+  }
   /// @brief Retrieves the performance test results.
   /// @return The latest PerfResults structure.
   [[nodiscard]] PerfResults GetPerfResults() const {
@@ -106,13 +310,229 @@ class Perf {
  private:
   PerfResults perf_results_;
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
-    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+  std::unique_ptr<HardwareCounters> counters_;
+  std::vector<PerfStageTime> setup_stages_;
+  // Stage times summed over the measured runs
+  std::vector<PerfStageTime> stage_totals_;
+  std::vector<PerfStageAlloc> setup_allocs_;
+  // Allocations and bytes summed, peaks maximized over the measured runs
+  std::vector<PerfStageAlloc> alloc_totals_;
+  bool measuring_ = false;
+  void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline) {
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
       pipeline();
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    measuring_ = true;
+    stage_totals_.clear();
+    alloc_totals_.clear();
+    ppc::util::trace::BeginSpanTotals();
+    perf_results_.samples.clear();
+    perf_results_.samples.reserve(perf_attr.num_running);
+    auto measure = [&] {
+      perf_attr.sync_start();
+      auto begin = perf_attr.current_timer();
+      pipeline();
+      auto end = perf_attr.current_timer();
+      perf_results_.samples.push_back(end - begin);
+      return end;
+    };
+    if (perf_attr.adaptive) {
+      AdaptiveRun(perf_attr, measure, perf_results_.samples);
+    } else {
+      for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+        measure();
+      }
+    }
+    ReduceOverRanks(perf_attr);
+    const auto &samples = perf_results_.samples;
+    const double total = std::accumulate(samples.begin(), samples.end(), 0.0);
+    perf_results_.time_sec = samples.empty() ? 0.0 : total / static_cast<double>(samples.size());
+    perf_results_.statistics = ComputeStatistics(samples);
+    measuring_ = false;
+    CollectStages(ppc::util::trace::EndSpanTotals());
+  }
+  // Replaces the local samples by the per-run maximum over processes and records the spread
+  void ReduceOverRanks(const PerfAttr &perf_attr) {
+    auto &ranks = perf_results_.ranks;
+    ranks = PerfRankStatistics{};
+    RankSamples reduced = perf_attr.reduce_samples(perf_results_.samples);
+    const std::size_t runs = perf_results_.samples.size();
+    if (reduced.processes <= 1 || runs == 0 || reduced.min_sec.size() != runs || reduced.mean_sec.size() != runs ||
+        reduced.max_sec.size() != runs) {
+      return;
+    }
+    auto mean_of = [runs](const std::vector<double> &values) {
+      return std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(runs);
+    };
+    ranks.processes = reduced.processes;
+    ranks.min_sec = mean_of(reduced.min_sec);
+    ranks.mean_sec = mean_of(reduced.mean_sec);
+    ranks.max_sec = mean_of(reduced.max_sec);
+    ranks.imbalance = ranks.mean_sec > 0.0 ? ranks.max_sec / ranks.mean_sec : 1.0;
+    ranks.slowest_rank = reduced.slowest_rank;
+    perf_results_.samples = std::move(reduced.max_sec);
+  }
+  // Runs one pipeline stage, accumulating its time while measured runs are in progress. Uses the local
+  // steady clock so that PerfAttr::current_timer keeps being called exactly twice per run
+  template <typename Stage>
+  void TimedStage(const char *name, Stage &&stage) {
+    if (!measuring_) {
+      stage();
+      return;
+    }
+    const bool count_allocs = AllocProfile::IsInterposed();
+    const AllocSnapshot alloc_begin = count_allocs ? AllocProfile::Begin() : AllocSnapshot{};
+    const auto begin = std::chrono::steady_clock::now();
+    stage();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (count_allocs) {
+      AccumulateAlloc(AllocProfile::End(name, alloc_begin));
+    }
+    auto it = std::ranges::find_if(stage_totals_, [&](const PerfStageTime &s) { return s.name == name; });
+    if (it == stage_totals_.end()) {
+      stage_totals_.push_back({.name = name, .time_sec = elapsed});
+    } else {
+      it->time_sec += elapsed;
+    }
+  }
+  void AccumulateAlloc(const PerfStageAlloc &alloc) {
+    auto it = std::ranges::find_if(alloc_totals_, [&](const PerfStageAlloc &s) { return s.name == alloc.name; });
+    if (it == alloc_totals_.end()) {
+      alloc_totals_.push_back(alloc);
+      return;
+    }
+    it->allocations += alloc.allocations;
+    it->bytes += alloc.bytes;
+    it->peak_heap_bytes = std::max(it->peak_heap_bytes, alloc.peak_heap_bytes);
+    it->peak_rss_bytes = std::max(it->peak_rss_bytes, alloc.peak_rss_bytes);
+  }
+  void CollectStages(const std::vector<std::pair<std::string, double>> &span_totals) {
+    const auto runs = static_cast<double>(std::max<std::size_t>(perf_results_.samples.size(), 1));
+    auto &stages = perf_results_.stages;
+    stages = setup_stages_;
+    for (const auto &stage : stage_totals_) {
+      stages.push_back({.name = stage.name, .time_sec = stage.time_sec / runs});
+    }
+    for (const auto &[name, total] : span_totals) {
+      stages.push_back({.name = name, .time_sec = total / runs});
+    }
+    auto &allocations = perf_results_.allocations;
+    allocations = setup_allocs_;
+    for (auto alloc : alloc_totals_) {
+      alloc.allocations /= runs;
+      alloc.bytes /= runs;
+      allocations.push_back(alloc);
+    }
+  }
+  // Task::Run() wrapped with hardware counters while measured runs are in progress
+  void CountedRun() {
+    if (!measuring_ || !counters_) {
+      task_->Run();
+      return;
+    }
+    counters_->Start();
+    task_->Run();
+    counters_->Stop();
+    perf_results_.counters.runs++;
+  }
+  void BeginCounters(const PerfAttr &perf_attr) {
+    perf_results_.counters = CounterResults{};
+    counters_.reset();
+    if (!perf_attr.collect_counters) {
+      return;
+    }
+    counters_ = std::make_unique<HardwareCounters>();
+    perf_results_.counters.enabled = true;
+    perf_results_.counters.available = counters_->Available();
+    perf_results_.counters.num_elements = perf_attr.num_elements;
+  }
+  void EndCounters() {
+    if (!counters_) {
+      return;
+    }
+    auto &counters = perf_results_.counters;
+    counters.totals = counters_->Totals();
+    for (std::size_t i = 0; i < counters.supported.size(); i++) {
+      counters.supported[i] = counters_->Supported(static_cast<CounterEvent>(i));
+    }
+    const auto cycles = counters.totals[static_cast<std::size_t>(CounterEvent::kCycles)];
+    const auto instructions = counters.totals[static_cast<std::size_t>(CounterEvent::kInstructions)];
+    counters.ipc = cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+    counters_.reset();
+  }
+  // Comma-separated key=value list with per-run counter averages of the last run
+  [[nodiscard]] std::string FormatCounters() const {
+    const auto &counters = perf_results_.counters;
+    if (!counters.available) {
+      return "unavailable";
+    }
+    std::stringstream out;
+    out << std::fixed << std::setprecision(4) << "runs=" << counters.runs << ",ipc=" << counters.ipc;
+    for (std::size_t i = 0; i < counters.supported.size(); i++) {
+      if (!counters.supported[i]) {
+        continue;
+      }
+      const auto event = static_cast<CounterEvent>(i);
+      const auto per_run = counters.runs == 0 ? 0 : counters.totals[i] / counters.runs;
+      out << "," << GetCounterEventName(event) << "=" << per_run;
+      if (counters.num_elements != 0 && event != CounterEvent::kCycles && event != CounterEvent::kInstructions) {
+        out << "," << GetCounterEventName(event) << "_per_element=" << counters.PerElement(event);
+      }
+    }
+    return out.str();
+  }
+  // Runs at least num_running (and at least two) iterations, then continues until the samples converge,
+  // max_running is reached or the time budget is spent
+  static void AdaptiveRun(const PerfAttr &perf_attr, const std::function<double()> &measure,
+                          const std::vector<double> &samples) {
+    const double budget = perf_attr.time_budget_sec > 0.0 ? perf_attr.time_budget_sec : ppc::util::GetPerfMaxTime();
+    const uint64_t min_running = std::max<uint64_t>(perf_attr.num_running, 2);
+    const uint64_t max_running = std::max(perf_attr.max_running, min_running);
+    const double start = perf_attr.current_timer();
+    bool stop = false;
+    while (!stop) {
+      const double now = measure();
+      const uint64_t done = samples.size();
+      if (done < min_running) {
+        continue;
+      }
+      stop = done >= max_running || (now - start) >= budget ||
+             RelativeStdError(samples) <= perf_attr.target_rse;
+      stop = perf_attr.sync_stop(stop);
+    }
+  }
+  static bool IsStageNameSeparator(char c) {
+    return c == ',' || c == '=' || c == ':' || std::isspace(static_cast<unsigned char>(c)) != 0;
+  }
+  // Comma-separated name=seconds list of the stage breakdown; separators in span names are replaced
+  [[nodiscard]] std::string FormatStages() const {
+    std::stringstream out;
+    out << std::fixed << std::setprecision(10);
+    for (std::size_t i = 0; i < perf_results_.stages.size(); i++) {
+      std::string name = perf_results_.stages[i].name;
+      std::ranges::replace_if(name, IsStageNameSeparator, '_');
+      out << (i == 0 ? "" : ",") << name << "=" << perf_results_.stages[i].time_sec;
+    }
+    return out.str();
+  }
+  // Comma-separated key=value list with the spread of the last run over processes
+  [[nodiscard]] std::string FormatRanks() const {
+    const auto &ranks = perf_results_.ranks;
+    std::stringstream out;
+    out << std::fixed << std::setprecision(10) << "np=" << ranks.processes << ",min=" << ranks.min_sec
+        << ",mean=" << ranks.mean_sec << ",max=" << ranks.max_sec << std::setprecision(4)
+        << ",imbalance=" << ranks.imbalance << ",slowest_rank=" << ranks.slowest_rank;
+    return out.str();
+  }
+  // Comma-separated key=value list with the statistics of the last run
+  [[nodiscard]] std::string FormatStatistics() const {
+    const auto &stats = perf_results_.statistics;
+    std::stringstream out;
+    out << std::fixed << std::setprecision(10) << "n=" << perf_results_.samples.size()
+        << ",mean=" << perf_results_.time_sec << ",min=" << stats.min_sec << ",median=" << stats.median_sec
+        << ",p90=" << stats.p90_sec << ",p99=" << stats.p99_sec << ",stddev=" << stats.stddev_sec
+        << ",ci_low=" << stats.ci_low_sec << ",ci_high=" << stats.ci_high_sec << ",rse=" << stats.rse;
+    return out.str();
   }
 };
 
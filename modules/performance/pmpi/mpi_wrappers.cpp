@@ -0,0 +1,195 @@
+// PMPI interposition layer. Compiled only into ppc_perf_tests (see tasks/CMakeLists.txt), where the
+// definitions below take precedence over the MPI library and feed ppc::performance::MpiProfile.
+#include <mpi.h>
+
+#include <cstdint>
+
+#include "performance/include/mpi_profile.hpp"
+
+namespace {
+
+using ppc::performance::MpiCall;
+using ppc::performance::MpiProfile;
+
+[[maybe_unused]] const bool kInterposed = MpiProfile::MarkInterposed();
+
+uint64_t Bytes(int count, MPI_Datatype datatype) {
+  if (count <= 0) {
+    return 0;
+  }
+  int size = 0;
+  PMPI_Type_size(datatype, &size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(size);
+}
+
+uint64_t Bytes(const int *counts, int n, MPI_Datatype datatype) {
+  uint64_t total = 0;
+  for (int i = 0; counts != nullptr && i < n; i++) {
+    total += Bytes(counts[i], datatype);
+  }
+  return total;
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 1;
+  PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+// Times a PMPI call and records it with the given byte counts
+template <typename Call>
+int Profile(MpiCall call, uint64_t bytes_sent, uint64_t bytes_received, Call &&pmpi_call) {
+  const double start = PMPI_Wtime();
+  const int res = pmpi_call();
+  MpiProfile::Record(call, PMPI_Wtime() - start, bytes_sent, bytes_received);
+  return res;
+}
+
+}  // namespace
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return Profile(MpiCall::kSend, Bytes(count, datatype), 0,
+                 [&] { return PMPI_Send(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  MPI_Status local_status;
+  MPI_Status *st = (status == MPI_STATUS_IGNORE) ? &local_status : status;
+  const double start = PMPI_Wtime();
+  const int res = PMPI_Recv(buf, count, datatype, source, tag, comm, st);
+  const double elapsed = PMPI_Wtime() - start;
+  int received = 0;
+  PMPI_Get_count(st, datatype, &received);
+  MpiProfile::Record(MpiCall::kRecv, elapsed, 0, Bytes(received, datatype));
+  return res;
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return Profile(MpiCall::kIsend, Bytes(count, datatype), 0,
+                 [&] { return PMPI_Isend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request *request) {
+  return Profile(MpiCall::kIrecv, 0, Bytes(count, datatype),
+                 [&] { return PMPI_Irecv(buf, count, datatype, source, tag, comm, request); });
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  return Profile(MpiCall::kSendrecv, Bytes(sendcount, sendtype), Bytes(recvcount, recvtype), [&] {
+    return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                         comm, status);
+  });
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  return Profile(MpiCall::kWait, 0, 0, [&] { return PMPI_Wait(request, status); });
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]) {
+  return Profile(MpiCall::kWait, 0, 0, [&] { return PMPI_Waitall(count, array_of_requests, array_of_statuses); });
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  return Profile(MpiCall::kProbe, 0, 0, [&] { return PMPI_Probe(source, tag, comm, status); });
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  return Profile(MpiCall::kBarrier, 0, 0, [&] { return PMPI_Barrier(comm); });
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = Bytes(count, datatype);
+  return Profile(MpiCall::kBcast, is_root ? bytes : 0, is_root ? 0 : bytes,
+                 [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t sent = IsRoot(root, comm) ? Bytes(sendcount, sendtype) * CommSize(comm) : 0;
+  return Profile(MpiCall::kScatter, sent, Bytes(recvcount, recvtype), [&] {
+    return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t sent = IsRoot(root, comm) ? Bytes(sendcounts, CommSize(comm), sendtype) : 0;
+  return Profile(MpiCall::kScatterv, sent, Bytes(recvcount, recvtype), [&] {
+    return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t received = IsRoot(root, comm) ? Bytes(recvcount, recvtype) * CommSize(comm) : 0;
+  return Profile(MpiCall::kGather, Bytes(sendcount, sendtype), received, [&] {
+    return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t received = IsRoot(root, comm) ? Bytes(recvcounts, CommSize(comm), recvtype) : 0;
+  return Profile(MpiCall::kGatherv, Bytes(sendcount, sendtype), received, [&] {
+    return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+  });
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  return Profile(MpiCall::kAllgather, Bytes(sendcount, sendtype), Bytes(recvcount, recvtype) * CommSize(comm), [&] {
+    return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t received = Bytes(recvcounts, CommSize(comm), recvtype);
+  return Profile(MpiCall::kAllgatherv, Bytes(sendcount, sendtype), received, [&] {
+    return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+  });
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  const uint64_t bytes = Bytes(count, datatype);
+  return Profile(MpiCall::kReduce, bytes, IsRoot(root, comm) ? bytes : 0,
+                 [&] { return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const uint64_t bytes = Bytes(count, datatype);
+  return Profile(MpiCall::kAllreduce, bytes, bytes,
+                 [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const uint64_t bytes = Bytes(count, datatype);
+  return Profile(MpiCall::kScan, bytes, bytes,
+                 [&] { return PMPI_Scan(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  const int size = CommSize(comm);
+  return Profile(MpiCall::kAlltoall, Bytes(sendcount, sendtype) * size, Bytes(recvcount, recvtype) * size, [&] {
+    return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const int size = CommSize(comm);
+  return Profile(MpiCall::kAlltoallv, Bytes(sendcounts, size, sendtype), Bytes(recvcounts, size, recvtype), [&] {
+    return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+  });
+}
@@ -0,0 +1,191 @@
+#include "performance/include/alloc_profile.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#  include <fcntl.h>
+#  include <unistd.h>
+#elif defined(__APPLE__)
+#  include <sys/resource.h>
+#endif
+
+#include "util/include/comm.hpp"
+
+namespace ppc::performance {
+
+namespace {
+
+// Constant-initialized, so the hooks may count allocations made during static initialization
+std::atomic<bool> interposed{false};
+std::atomic<uint64_t> total_allocations{0};
+std::atomic<uint64_t> total_bytes{0};
+std::atomic<int64_t> live_bytes{0};
+std::atomic<int64_t> peak_live_bytes{0};
+
+// (allocations, bytes, peak_heap_bytes, peak_rss_bytes) per stage
+constexpr std::size_t kFieldsPerStage = 4;
+
+std::vector<double> Pack(const std::vector<PerfStageAlloc> &stages) {
+  std::vector<double> packed;
+  packed.reserve(stages.size() * kFieldsPerStage);
+  for (const auto &stage : stages) {
+    packed.push_back(stage.allocations);
+    packed.push_back(stage.bytes);
+    packed.push_back(static_cast<double>(stage.peak_heap_bytes));
+    packed.push_back(static_cast<double>(stage.peak_rss_bytes));
+  }
+  return packed;
+}
+
+std::string FormatReport(const std::string &prefix, const std::vector<PerfStageAlloc> &stages,
+                         const std::vector<double> &all, int num_ranks) {
+  const std::size_t packed_size = stages.size() * kFieldsPerStage;
+  std::stringstream out;
+  for (int rank = 0; rank < num_ranks; rank++) {
+    const double *packed = all.data() + (static_cast<std::size_t>(rank) * packed_size);
+    double peak_rss = 0.0;
+    for (std::size_t i = 0; i < stages.size(); i++) {
+      peak_rss = std::max(peak_rss, packed[(i * kFieldsPerStage) + 3]);
+    }
+    out << prefix << ":alloc:rank=" << rank << ",peak_rss=" << static_cast<uint64_t>(peak_rss);
+    for (std::size_t i = 0; i < stages.size(); i++) {
+      const double *fields = packed + (i * kFieldsPerStage);
+      out << "," << stages[i].name << "=" << std::llround(fields[0]) << "/" << std::llround(fields[1]) << "/"
+          << static_cast<uint64_t>(fields[2]);
+    }
+    out << '\n';
+  }
+  return out.str();
+}
+
+#if defined(__linux__)
+// Plain file descriptors and stack buffers, so that reading the counters allocates nothing
+
+// Writing 5 to clear_refs resets VmHWM, the peak resident set size, to the current resident set size
+void ResetPeakRss() {
+  const int fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  [[maybe_unused]] const auto written = write(fd, "5", 1);
+  close(fd);
+}
+
+uint64_t ReadPeakRssKb() {
+  const int fd = open("/proc/self/status", O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return 0;
+  }
+  std::array<char, 4096> buffer{};
+  const auto size = read(fd, buffer.data(), buffer.size());
+  close(fd);
+  const std::string_view status(buffer.data(), size > 0 ? static_cast<std::size_t>(size) : 0);
+  const std::size_t key = status.find("VmHWM:");
+  if (key == std::string_view::npos) {
+    return 0;
+  }
+  std::size_t value = key + std::string_view("VmHWM:").size();
+  while (value < status.size() && (status[value] == ' ' || status[value] == '\t')) {
+    ++value;
+  }
+  uint64_t kb = 0;
+  std::from_chars(status.data() + value, status.data() + status.size(), kb);
+  return kb;
+}
+#endif
+
+}  // namespace
+
+void AllocProfile::RecordAlloc(std::size_t bytes) {
+  total_allocations.fetch_add(1, std::memory_order_relaxed);
+  total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  const int64_t live = live_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                       static_cast<int64_t>(bytes);
+  int64_t peak = peak_live_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void AllocProfile::RecordFree(std::size_t bytes) {
+  live_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+bool AllocProfile::MarkInterposed() {
+  interposed.store(true);
+  return true;
+}
+
+bool AllocProfile::IsInterposed() {
+  return interposed.load();
+}
+
+AllocSnapshot AllocProfile::Begin() {
+#if defined(__linux__)
+  ResetPeakRss();
+#endif
+  const int64_t live = live_bytes.load(std::memory_order_relaxed);
+  peak_live_bytes.store(live, std::memory_order_relaxed);
+  return {.allocations = total_allocations.load(std::memory_order_relaxed),
+          .bytes = total_bytes.load(std::memory_order_relaxed),
+          .live_bytes = live};
+}
+
+PerfStageAlloc AllocProfile::End(const std::string &name, const AllocSnapshot &begin) {
+  const int64_t peak_growth = peak_live_bytes.load(std::memory_order_relaxed) - begin.live_bytes;
+  return {.name = name,
+          .allocations = static_cast<double>(total_allocations.load(std::memory_order_relaxed) - begin.allocations),
+          .bytes = static_cast<double>(total_bytes.load(std::memory_order_relaxed) - begin.bytes),
+          .peak_heap_bytes = static_cast<uint64_t>(std::max<int64_t>(peak_growth, 0)),
+          .peak_rss_bytes = PeakRssBytes()};
+}
+
+uint64_t AllocProfile::PeakRssBytes() {
+#if defined(__linux__)
+  return ReadPeakRssKb() * 1024;
+#elif defined(__APPLE__)
+  // macOS cannot reset ru_maxrss, so this is the peak since the process started
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  return 0;
+#endif
+}
+
+std::string AllocProfile::GatherReport(const std::string &prefix, const std::vector<PerfStageAlloc> &stages,
+                                       bool collective) {
+  const std::vector<double> local = Pack(stages);
+  int initialized = 0;
+  int finalized = 0;
+  PMPI_Initialized(&initialized);
+  PMPI_Finalized(&finalized);
+  if (!collective || initialized == 0 || finalized != 0) {
+    return FormatReport(prefix, stages, local, 1);
+  }
+
+  int rank = 0;
+  int size = 1;
+  MPI_Comm comm = ppc::util::GetTaskComm();
+  PMPI_Comm_rank(comm, &rank);
+  PMPI_Comm_size(comm, &size);
+  std::vector<double> all(rank == 0 ? local.size() * static_cast<std::size_t>(size) : 0);
+  PMPI_Gather(local.data(), static_cast<int>(local.size()), MPI_DOUBLE, all.data(), static_cast<int>(local.size()),
+              MPI_DOUBLE, 0, comm);
+  return rank == 0 ? FormatReport(prefix, stages, all, size) : std::string{};
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,188 @@
+#include "performance/include/counters.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <array>
+#  include <cstdlib>
+#  include <cstring>
+#  include <filesystem>
+#  include <system_error>
+#  include <vector>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+constexpr std::size_t kNumEvents = static_cast<std::size_t>(CounterEvent::kCount);
+
+#ifdef __linux__
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr std::array<EventConfig, kNumEvents> kEventConfigs = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)},
+}};
+
+// Counts tid and, through inherit, the threads it creates afterwards
+int OpenEvent(const EventConfig &event, pid_t tid) {
+  perf_event_attr attr{};
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+// Threads of this process, including OpenMP, TBB and ThreadPool workers started before the counters
+std::vector<pid_t> ProcessThreads() {
+  std::vector<pid_t> tids;
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    tids.push_back(static_cast<pid_t>(std::strtol(entry.path().filename().c_str(), nullptr, 10)));
+  }
+  if (tids.empty()) {
+    tids.push_back(0);
+  }
+  return tids;
+}
+
+// Scales the raw count when the kernel multiplexed the event with others
+uint64_t ReadScaled(int fd) {
+  std::array<uint64_t, 3> buf{};
+  if (read(fd, buf.data(), sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) {
+    return 0;
+  }
+  const auto [value, enabled, running] = buf;
+  if (running == 0 || running == enabled) {
+    return value;
+  }
+  return static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) /
+                               static_cast<double>(running));
+}
+#endif
+
+}  // namespace
+
+std::string GetCounterEventName(CounterEvent event) {
+  switch (event) {
+    case CounterEvent::kCycles:
+      return "cycles";
+    case CounterEvent::kInstructions:
+      return "instructions";
+    case CounterEvent::kLlcMisses:
+      return "llc_misses";
+    case CounterEvent::kBranchMisses:
+      return "branch_misses";
+    case CounterEvent::kDtlbMisses:
+      return "dtlb_misses";
+    case CounterEvent::kCount:
+      break;
+  }
+  return "unknown";
+}
+
+double CounterResults::PerElement(CounterEvent event) const {
+  if (runs == 0) {
+    return 0.0;
+  }
+  const double per_run = static_cast<double>(totals[static_cast<std::size_t>(event)]) / static_cast<double>(runs);
+  return num_elements == 0 ? per_run : per_run / static_cast<double>(num_elements);
+}
+
+HardwareCounters::HardwareCounters() {
+#ifdef __linux__
+  const std::vector<pid_t> tids = ProcessThreads();
+  for (std::size_t i = 0; i < kNumEvents; i++) {
+    for (pid_t tid : tids) {
+      // A thread may exit between listing and opening; the event is still supported if others open
+      const int fd = OpenEvent(kEventConfigs[i], tid);
+      if (fd >= 0) {
+        fds_[i].push_back(fd);
+      }
+    }
+  }
+#endif
+}
+
+HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (const auto &event_fds : fds_) {
+    for (int fd : event_fds) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+bool HardwareCounters::Available() const {
+  for (std::size_t i = 0; i < kNumEvents; i++) {
+    if (Supported(static_cast<CounterEvent>(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HardwareCounters::Supported(CounterEvent event) const {
+  return !fds_[static_cast<std::size_t>(event)].empty();
+}
+
+void HardwareCounters::Start() {
+  start_ = Read();
+#ifdef __linux__
+  for (const auto &event_fds : fds_) {
+    for (int fd : event_fds) {
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void HardwareCounters::Stop() {
+#ifdef __linux__
+  for (const auto &event_fds : fds_) {
+    for (int fd : event_fds) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+#endif
+  const CounterValues end = Read();
+  for (std::size_t i = 0; i < kNumEvents; i++) {
+    totals_[i] += end[i] >= start_[i] ? end[i] - start_[i] : 0;
+  }
+}
+
+CounterValues HardwareCounters::Read() const {
+  CounterValues values{};
+#ifdef __linux__
+  for (std::size_t i = 0; i < kNumEvents; i++) {
+    for (int fd : fds_[i]) {
+      values[i] += ReadScaled(fd);
+    }
+  }
+#endif
+  return values;
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,204 @@
+#include "performance/include/mpi_profile.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "util/include/comm.hpp"
+
+namespace ppc::performance {
+
+namespace {
+
+constexpr std::size_t kNumCalls = static_cast<std::size_t>(MpiCall::kCount);
+// wall time followed by (calls, bytes_sent, bytes_received, time) per routine
+constexpr std::size_t kFieldsPerCall = 4;
+constexpr std::size_t kPackedSize = 1 + (kNumCalls * kFieldsPerCall);
+
+std::atomic<bool> interposed{false};
+
+std::vector<double> Pack(const MpiProfileData &data, double wall_time_sec) {
+  std::vector<double> packed;
+  packed.reserve(kPackedSize);
+  packed.push_back(wall_time_sec);
+  for (const auto &stats : data.calls) {
+    packed.push_back(static_cast<double>(stats.calls));
+    packed.push_back(static_cast<double>(stats.bytes_sent));
+    packed.push_back(static_cast<double>(stats.bytes_received));
+    packed.push_back(stats.time_sec);
+  }
+  return packed;
+}
+
+MpiProfileData Unpack(const double *packed) {
+  MpiProfileData data;
+  for (std::size_t i = 0; i < kNumCalls; i++) {
+    const double *fields = packed + 1 + (i * kFieldsPerCall);
+    data.calls[i].calls = static_cast<uint64_t>(fields[0]);
+    data.calls[i].bytes_sent = static_cast<uint64_t>(fields[1]);
+    data.calls[i].bytes_received = static_cast<uint64_t>(fields[2]);
+    data.calls[i].time_sec = fields[3];
+  }
+  return data;
+}
+
+std::string FormatReport(const std::string &prefix, const std::vector<double> &all, int num_ranks) {
+  std::stringstream out;
+  out << std::fixed << std::setprecision(10);
+  std::array<MpiCallStats, kNumCalls> totals{};
+  for (int rank = 0; rank < num_ranks; rank++) {
+    const double *packed = all.data() + (static_cast<std::size_t>(rank) * kPackedSize);
+    const double wall = packed[0];
+    const MpiProfileData data = Unpack(packed);
+    out << prefix << ":mpi:rank=" << rank << ",wall=" << wall << ",compute=" << std::max(0.0, wall - data.MpiTime())
+        << ",mpi=" << data.MpiTime() << ",wait=" << data.WaitTime() << ",bytes_sent=" << data.BytesSent()
+        << ",bytes_received=" << data.BytesReceived() << '\n';
+    for (std::size_t i = 0; i < kNumCalls; i++) {
+      totals[i].calls += data.calls[i].calls;
+      totals[i].bytes_sent += data.calls[i].bytes_sent;
+      totals[i].bytes_received += data.calls[i].bytes_received;
+      totals[i].time_sec = std::max(totals[i].time_sec, data.calls[i].time_sec);
+    }
+  }
+  for (std::size_t i = 0; i < kNumCalls; i++) {
+    if (totals[i].calls == 0) {
+      continue;
+    }
+    out << prefix << ":mpi_call:" << GetMpiCallName(static_cast<MpiCall>(i)) << ":calls=" << totals[i].calls
+        << ",bytes_sent=" << totals[i].bytes_sent << ",bytes_received=" << totals[i].bytes_received
+        << ",max_time=" << totals[i].time_sec << '\n';
+  }
+  return out.str();
+}
+
+}  // namespace
+
+std::string GetMpiCallName(MpiCall call) {
+  constexpr std::array<const char *, kNumCalls> kNames = {
+      "MPI_Send",
+      "MPI_Recv",
+      "MPI_Isend",
+      "MPI_Irecv",
+      "MPI_Sendrecv",
+      "MPI_Wait",
+      "MPI_Probe",
+      "MPI_Barrier",
+      "MPI_Bcast",
+      "MPI_Scatter",
+      "MPI_Scatterv",
+      "MPI_Gather",
+      "MPI_Gatherv",
+      "MPI_Allgather",
+      "MPI_Allgatherv",
+      "MPI_Reduce",
+      "MPI_Allreduce",
+      "MPI_Scan",
+      "MPI_Alltoall",
+      "MPI_Alltoallv",
+  };
+  const auto index = static_cast<std::size_t>(call);
+  return index < kNumCalls ? kNames[index] : "unknown";
+}
+
+bool IsMpiWaitCall(MpiCall call) {
+  return call == MpiCall::kRecv || call == MpiCall::kWait || call == MpiCall::kProbe || call == MpiCall::kBarrier;
+}
+
+double MpiProfileData::MpiTime() const {
+  double total = 0.0;
+  for (const auto &stats : calls) {
+    total += stats.time_sec;
+  }
+  return total;
+}
+
+double MpiProfileData::WaitTime() const {
+  double total = 0.0;
+  for (std::size_t i = 0; i < kNumCalls; i++) {
+    if (IsMpiWaitCall(static_cast<MpiCall>(i))) {
+      total += calls[i].time_sec;
+    }
+  }
+  return total;
+}
+
+uint64_t MpiProfileData::BytesSent() const {
+  uint64_t total = 0;
+  for (const auto &stats : calls) {
+    total += stats.bytes_sent;
+  }
+  return total;
+}
+
+uint64_t MpiProfileData::BytesReceived() const {
+  uint64_t total = 0;
+  for (const auto &stats : calls) {
+    total += stats.bytes_received;
+  }
+  return total;
+}
+
+MpiProfileData &MpiProfile::Data() {
+  static MpiProfileData data;
+  return data;
+}
+
+void MpiProfile::Record(MpiCall call, double time_sec, uint64_t bytes_sent, uint64_t bytes_received) {
+  auto &stats = Data().calls[static_cast<std::size_t>(call)];
+  stats.calls++;
+  stats.bytes_sent += bytes_sent;
+  stats.bytes_received += bytes_received;
+  stats.time_sec += time_sec;
+}
+
+void MpiProfile::RecordHarness(double time_sec) {
+  Data().harness_time_sec += time_sec;
+}
+
+void MpiProfile::Reset() {
+  Data() = MpiProfileData{};
+}
+
+const MpiProfileData &MpiProfile::Get() {
+  return Data();
+}
+
+bool MpiProfile::MarkInterposed() {
+  interposed.store(true);
+  return true;
+}
+
+bool MpiProfile::IsInterposed() {
+  return interposed.load();
+}
+
+std::string MpiProfile::GatherReport(const std::string &prefix, double wall_time_sec) {
+  const std::vector<double> local = Pack(Get(), std::max(0.0, wall_time_sec - Get().harness_time_sec));
+  int initialized = 0;
+  int finalized = 0;
+  PMPI_Initialized(&initialized);
+  PMPI_Finalized(&finalized);
+  if (initialized == 0 || finalized != 0) {
+    return FormatReport(prefix, local, 1);
+  }
+
+  int rank = 0;
+  int size = 1;
+  MPI_Comm comm = ppc::util::GetTaskComm();
+  PMPI_Comm_rank(comm, &rank);
+  PMPI_Comm_size(comm, &size);
+  std::vector<double> all(rank == 0 ? kPackedSize * static_cast<std::size_t>(size) : 0);
+  PMPI_Gather(local.data(), static_cast<int>(kPackedSize), MPI_DOUBLE, all.data(), static_cast<int>(kPackedSize),
+              MPI_DOUBLE, 0, comm);
+  return rank == 0 ? FormatReport(prefix, all, size) : std::string{};
+}
+
+}  // namespace ppc::performance
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -8,12 +10,17 @@
 #include <memory>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <thread>
 #include <vector>
 
+#include "performance/include/alloc_profile.hpp"
+#include "performance/include/counters.hpp"
+#include "performance/include/mpi_profile.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StatusOfTask;
@@ -350,6 +357,412 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, RecordsSamplesAndSkipsWarmup) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  int timer_calls = 0;
+  attr.num_running = 4;
+  attr.num_warmup = 3;
+  attr.current_timer = [&timer_calls]() {
+    timer_calls++;
+    return static_cast<double>(timer_calls * timer_calls);
+  };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  EXPECT_EQ(timer_calls, 8);
+  ASSERT_EQ(res.samples.size(), 4U);
+  EXPECT_DOUBLE_EQ(res.samples[0], 3.0);
+  EXPECT_DOUBLE_EQ(res.samples[3], 15.0);
+  EXPECT_DOUBLE_EQ(res.time_sec, 9.0);
+  EXPECT_DOUBLE_EQ(res.statistics.min_sec, 3.0);
+  EXPECT_DOUBLE_EQ(res.statistics.median_sec, 9.0);
+}
+
+TEST(PerfTest, ComputeStatisticsOnKnownSamples) {
+  std::vector<double> samples;
+  for (int i = 1; i <= 101; i++) {
+    samples.push_back(static_cast<double>(i));
+  }
+  const auto stats = ComputeStatistics(samples);
+  EXPECT_DOUBLE_EQ(stats.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(stats.median_sec, 51.0);
+  EXPECT_DOUBLE_EQ(stats.p90_sec, 91.0);
+  EXPECT_DOUBLE_EQ(stats.p99_sec, 100.0);
+  EXPECT_NEAR(stats.stddev_sec, 29.3002, 1e-4);
+  EXPECT_LT(stats.ci_low_sec, 51.0);
+  EXPECT_GT(stats.ci_high_sec, 51.0);
+  EXPECT_GT(stats.ci_low_sec, stats.min_sec);
+}
+
+TEST(PerfTest, ComputeStatisticsHandlesDegenerateSamples) {
+  const auto empty_stats = ComputeStatistics({});
+  EXPECT_DOUBLE_EQ(empty_stats.median_sec, 0.0);
+
+  const auto single_stats = ComputeStatistics({0.25});
+  EXPECT_DOUBLE_EQ(single_stats.min_sec, 0.25);
+  EXPECT_DOUBLE_EQ(single_stats.p99_sec, 0.25);
+  EXPECT_DOUBLE_EQ(single_stats.stddev_sec, 0.0);
+  EXPECT_DOUBLE_EQ(single_stats.ci_low_sec, 0.25);
+  EXPECT_DOUBLE_EQ(single_stats.ci_high_sec, 0.25);
+}
+
+TEST(PerfTest, AdaptiveRunStopsOnceConverged) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.adaptive = true;
+  attr.num_running = 3;
+  attr.current_timer = [&time]() {
+    time += 1.0;
+    return time;
+  };
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 3U);
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().statistics.rse, 0.0);
+}
+
+TEST(PerfTest, AdaptiveRunRespectsMaxRunningAndBudget) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  int calls = 0;
+  // Steadily growing samples never reach a 0.1% relative standard error
+  attr.current_timer = [&]() {
+    time += static_cast<double>(++calls);
+    return time;
+  };
+  attr.adaptive = true;
+  attr.target_rse = 0.001;
+  attr.max_running = 7;
+  attr.time_budget_sec = 1e9;
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 7U);
+
+  attr.max_running = 1000;
+  attr.time_budget_sec = 20.0;
+  perf.PipelineRun(attr);
+  EXPECT_LT(perf.GetPerfResults().samples.size(), 1000U);
+  EXPECT_GE(perf.GetPerfResults().samples.size(), attr.num_running);
+}
+
+TEST(PerfTest, AdaptiveRunUsesSyncStopDecision) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  int sync_calls = 0;
+  attr.current_timer = [&time]() {
+    time += 1.0;
+    return time;
+  };
+  attr.adaptive = true;
+  attr.num_running = 2;
+  attr.sync_stop = [&sync_calls](bool /*stop*/) { return ++sync_calls == 4; };
+  perf.TaskRun(attr);
+  EXPECT_EQ(sync_calls, 4);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 5U);
+}
+
+TEST(PerfTest, DistributedRunReportsSlowestProcess) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  int sync_starts = 0;
+  attr.num_running = 3;
+  attr.current_timer = [&time]() {
+    time += 1.0;
+    return time;
+  };
+  attr.sync_start = [&sync_starts]() { sync_starts++; };
+  // Two processes: this one took 1 s per run, the other one 3 s
+  attr.reduce_samples = [](const std::vector<double> &samples) {
+    return RankSamples{.processes = 2,
+                       .min_sec = samples,
+                       .mean_sec = std::vector<double>(samples.size(), 2.0),
+                       .max_sec = std::vector<double>(samples.size(), 3.0),
+                       .slowest_rank = 1};
+  };
+  perf.TaskRun(attr);
+
+  const auto res = perf.GetPerfResults();
+  EXPECT_EQ(sync_starts, 3);
+  EXPECT_DOUBLE_EQ(res.time_sec, 3.0);
+  EXPECT_EQ(res.ranks.processes, 2);
+  EXPECT_DOUBLE_EQ(res.ranks.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.ranks.max_sec, 3.0);
+  EXPECT_DOUBLE_EQ(res.ranks.imbalance, 1.5);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("ranks_line");
+  const std::string out = ::testing::internal::GetCapturedStdout();
+  EXPECT_NE(out.find("ranks_line:task_run:ranks:np=2,min=1.0000000000,mean=2.0000000000,max=3.0000000000,"
+                     "imbalance=1.5000,slowest_rank=1"),
+            std::string::npos)
+      << out;
+}
+
+TEST(PerfTest, LocalRunHasNoRankSpread) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.current_timer = [&time]() {
+    time += 0.5;
+    return time;
+  };
+  perf.TaskRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().ranks.processes, 1);
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().ranks.imbalance, 1.0);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("local_line");
+  EXPECT_EQ(::testing::internal::GetCapturedStdout().find(":ranks:"), std::string::npos);
+}
+
+TEST(PerfTest, PrintPerfStatisticEmitsStatsLine) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.current_timer = [&time]() {
+    time += 0.5;
+    return time;
+  };
+  perf.TaskRun(attr);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("stats_line");
+  const std::string out = ::testing::internal::GetCapturedStdout();
+  EXPECT_NE(out.find("stats_line:task_run:0.5000000000\n"), std::string::npos);
+  EXPECT_NE(out.find("stats_line:task_run:stats:n=5,mean=0.5000000000,min=0.5000000000"), std::string::npos);
+  EXPECT_NE(out.find(",ci_high=0.5000000000"), std::string::npos);
+}
+
+class SpanTask : public DummyTask {
+ public:
+  bool RunImpl() override {
+    {
+      const ppc::util::trace::ScopedSpan span("scatter");
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const ppc::util::trace::ScopedSpan span("compute, local");
+    return true;
+  }
+};
+
+TEST(PerfTest, PipelineRunReportsStageBreakdown) {
+  auto task_ptr = std::make_shared<SpanTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 1;
+  double time = 0.0;
+  attr.current_timer = [&time]() {
+    time += 1.0;
+    return time;
+  };
+  perf.RecordSetupStage("Construct", 0.25);
+  perf.PipelineRun(attr);
+
+  const auto stages = perf.GetPerfResults().stages;
+  std::vector<std::string> names;
+  for (const auto &stage : stages) {
+    names.push_back(stage.name);
+  }
+  const std::vector<std::string> expected = {"Construct",      "Validation", "PreProcessing", "Run",
+                                             "PostProcessing", "scatter",    "compute, local"};
+  ASSERT_EQ(names, expected);
+  EXPECT_DOUBLE_EQ(stages[0].time_sec, 0.25);
+  EXPECT_GE(stages[3].time_sec, 0.002);
+  EXPECT_GE(stages[5].time_sec, 0.002);
+  EXPECT_LE(stages[5].time_sec, stages[3].time_sec);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("stages_line");
+  const std::string out = ::testing::internal::GetCapturedStdout();
+  EXPECT_NE(out.find("stages_line:pipeline:stages:Construct=0.2500000000,Validation="), std::string::npos);
+  EXPECT_NE(out.find(",compute__local="), std::string::npos);
+}
+
+TEST(PerfTest, TaskRunTimesOnlyRunStage) {
+  auto task_ptr = std::make_shared<SpanTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 2;
+  double time = 0.0;
+  attr.current_timer = [&time]() {
+    time += 1.0;
+    return time;
+  };
+  perf.TaskRun(attr);
+
+  const auto stages = perf.GetPerfResults().stages;
+  ASSERT_EQ(stages.size(), 3U);
+  EXPECT_EQ(stages[0].name, "Run");
+  EXPECT_EQ(stages[1].name, "scatter");
+  EXPECT_FALSE(ppc::util::trace::IsRecording());
+}
+
+TEST(PerfTest, CountersAreCollectedOnlyWhenRequested) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.current_timer = [&time]() {
+    time += 1.0;
+    return time;
+  };
+  attr.num_warmup = 2;
+
+  perf.PipelineRun(attr);
+  EXPECT_FALSE(perf.GetPerfResults().counters.enabled);
+
+  attr.collect_counters = true;
+  attr.num_elements = 10;
+  perf.TaskRun(attr);
+  const auto counters = perf.GetPerfResults().counters;
+  EXPECT_TRUE(counters.enabled);
+  EXPECT_EQ(counters.num_elements, 10U);
+  EXPECT_EQ(counters.runs, attr.num_running);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("counters_line");
+  const std::string out = ::testing::internal::GetCapturedStdout();
+  EXPECT_NE(out.find(counters.available ? "counters_line:task_run:counters:runs=5,ipc="
+                                        : "counters_line:task_run:counters:unavailable"),
+            std::string::npos);
+}
+
+TEST(PerfTest, HardwareCountersDegradeGracefully) {
+  HardwareCounters counters;
+  counters.Start();
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 100000; i++) {
+    sum = sum + i;
+  }
+  counters.Stop();
+  if (!counters.Available()) {
+    for (auto value : counters.Totals()) {
+      EXPECT_EQ(value, 0U);
+    }
+  } else if (counters.Supported(CounterEvent::kInstructions)) {
+    EXPECT_GT(counters.Totals()[static_cast<std::size_t>(CounterEvent::kInstructions)], 0U);
+  }
+  EXPECT_EQ(GetCounterEventName(CounterEvent::kDtlbMisses), "dtlb_misses");
+}
+
+TEST(PerfTest, HardwareCountersCountThreadsStartedBefore) {
+  std::atomic<bool> go = false;
+  std::thread worker([&go] {
+    while (!go.load()) {
+      std::this_thread::yield();
+    }
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 10000000; i++) {
+      sum = sum + i;
+    }
+  });
+  HardwareCounters counters;
+  counters.Start();
+  go = true;
+  worker.join();
+  counters.Stop();
+  if (!counters.Supported(CounterEvent::kInstructions)) {
+    GTEST_SKIP() << "Instruction counter is not available";
+  }
+  EXPECT_GT(counters.Totals()[static_cast<std::size_t>(CounterEvent::kInstructions)], 10000000U);
+}
+
+TEST(MpiProfileTest, AccumulatesAndFormatsLocalProfile) {
+  MpiProfile::Reset();
+  MpiProfile::Record(MpiCall::kBcast, 0.5, 0, 64);
+  MpiProfile::Record(MpiCall::kBcast, 0.25, 0, 64);
+  MpiProfile::Record(MpiCall::kSend, 0.125, 32, 0);
+  MpiProfile::Record(MpiCall::kBarrier, 1.0, 0, 0);
+  MpiProfile::RecordHarness(0.5);
+
+  const auto &data = MpiProfile::Get();
+  EXPECT_EQ(data.calls[static_cast<std::size_t>(MpiCall::kBcast)].calls, 2U);
+  EXPECT_DOUBLE_EQ(data.MpiTime(), 1.875);
+  EXPECT_DOUBLE_EQ(data.WaitTime(), 1.0);
+  EXPECT_EQ(data.BytesSent(), 32U);
+  EXPECT_EQ(data.BytesReceived(), 128U);
+
+  const std::string report = MpiProfile::GatherReport("id:pipeline", 3.5);
+  EXPECT_NE(report.find("id:pipeline:mpi:rank=0,wall=3.0000000000,compute=1.1250000000"), std::string::npos);
+  EXPECT_NE(report.find("id:pipeline:mpi_call:MPI_Bcast:calls=2,bytes_sent=0,bytes_received=128"), std::string::npos);
+  EXPECT_EQ(report.find("MPI_Allreduce"), std::string::npos);
+
+  MpiProfile::Reset();
+  EXPECT_DOUBLE_EQ(MpiProfile::Get().MpiTime(), 0.0);
+  EXPECT_FALSE(MpiProfile::IsInterposed());
+}
+
+TEST(AllocProfileTest, TracksStageAllocationsAndPeak) {
+  // The hooks are not linked into this executable, so only the recorded blocks are counted
+  const AllocSnapshot begin = AllocProfile::Begin();
+  AllocProfile::RecordAlloc(100);
+  AllocProfile::RecordAlloc(300);
+  AllocProfile::RecordFree(300);
+  AllocProfile::RecordAlloc(50);
+  const PerfStageAlloc stage = AllocProfile::End("Run", begin);
+  AllocProfile::RecordFree(100);
+  AllocProfile::RecordFree(50);
+
+  EXPECT_EQ(stage.name, "Run");
+  EXPECT_DOUBLE_EQ(stage.allocations, 3.0);
+  EXPECT_DOUBLE_EQ(stage.bytes, 450.0);
+  EXPECT_EQ(stage.peak_heap_bytes, 400U);
+  EXPECT_FALSE(AllocProfile::IsInterposed());
+
+  const std::string report = AllocProfile::GatherReport(
+      "id:pipeline", {stage, {.name = "PostProcessing", .allocations = 0.5, .bytes = 8.0, .peak_rss_bytes = 4096}},
+      false);
+  EXPECT_EQ(report.find("id:pipeline:alloc:rank=0,peak_rss="), 0U);
+  EXPECT_NE(report.find(",Run=3/450/400,PostProcessing=1/8/0\n"), std::string::npos);
+}
+
+TEST(AllocProfileTest, PeakRssRestartsAtBegin) {
+#ifndef __linux__
+  GTEST_SKIP() << "Only Linux can reset the peak resident set size";
+#else
+  constexpr std::size_t kBlockBytes = std::size_t{64} << 20;
+  uint64_t peak_with_block = 0;
+  {
+    const std::vector<char> block(kBlockBytes, 1);
+    EXPECT_EQ(block.back(), 1);
+    peak_with_block = AllocProfile::PeakRssBytes();
+  }
+  ASSERT_GE(peak_with_block, kBlockBytes);
+
+  // The block is returned to the system, so a stage that starts afterwards stays well below the old peak
+  const AllocSnapshot begin = AllocProfile::Begin();
+  const PerfStageAlloc stage = AllocProfile::End("Run", begin);
+  EXPECT_GT(stage.peak_rss_bytes, 0U);
+  EXPECT_LT(stage.peak_rss_bytes, peak_with_block - (kBlockBytes / 2));
+#endif
+}
+
+TEST(PerfTest, AllocationsAreEmptyWithoutHooks) {
+  auto task_ptr = std::make_shared<ppc::test::TestPerfTask<std::vector<uint32_t>, uint32_t>>(
+      std::vector<uint32_t>(16, 1));
+  Perf<std::vector<uint32_t>, uint32_t> perf(task_ptr);
+  perf.RecordSetupAlloc({.name = "Construct", .allocations = 1.0, .bytes = 64.0});
+  PerfAttr attr;
+  attr.num_running = 2;
+  perf.PipelineRun(attr);
+
+  const auto &allocations = perf.GetPerfResults().allocations;
+  ASSERT_EQ(allocations.size(), 1U);
+  EXPECT_EQ(allocations[0].name, "Construct");
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <memory>
 #include <utility>
@@ -8,6 +9,8 @@
 namespace ppc::runners {
 
 /// @brief GTest event listener that checks for unread MPI messages after each test.
+/// @details Only ppc::util::GetTaskComm() is checked: in a sharded run other groups may still be exchanging
+/// messages on MPI_COMM_WORLD for their own tests.
 /// @note Used to detect unexpected inter-process communication leftovers.
 class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
  public:
@@ -16,6 +19,33 @@ class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
   void OnTestEnd(const ::testing::TestInfo & /*test_info*/) override;
 
  private:
+  /// @brief Aborts the MPI job if comm has a pending message for this process.
+  static void CheckUnreadMessages(MPI_Comm comm, int rank);
+};
+
+/// @brief GTest event listener that runs the tests of tasks using MPI_COMM_WORLD on all processes of a sharded run.
+/// @details Such tests (see ppc::util::IsWorldCommTest()) are not shared out between the groups; every process runs
+/// them, and while one runs ppc::util::GetTaskComm() is MPI_COMM_WORLD, so that the framework synchronizes the same
+/// processes as the task. Append it before UnreadMessagesDetector, which then checks MPI_COMM_WORLD after them.
+class WorldCommTestSwitcher : public ::testing::EmptyTestEventListener {
+ public:
+  /// @brief Switches the task communicator to MPI_COMM_WORLD for tests of tasks using it.
+  void OnTestStart(const ::testing::TestInfo &test_info) override;
+  /// @brief Restores the communicator of the group.
+  void OnTestEnd(const ::testing::TestInfo & /*test_info*/) override;
+
+ private:
+  MPI_Comm group_comm_ = MPI_COMM_NULL;
+  int group_ = -1;
+};
+
+/// @brief GTest event listener that releases the inputs shared through ppc::util::InputCache.
+/// @details Inputs are shared by the cases of one test suite only, so they are dropped when the suite ends
+/// to keep the peak memory of the test binary at one suite's inputs.
+class InputCacheReleaser : public ::testing::EmptyTestEventListener {
+ public:
+  /// @brief Called by GTest after all tests of a suite end. Clears the input cache.
+  void OnTestSuiteEnd(const ::testing::TestSuite & /*test_suite*/) override;
 };
 
 /// @brief GTest event listener that prints additional information on test failures in worker processes.
@@ -37,6 +67,11 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 };
 
 /// @brief Initializes the testing environment (e.g., MPI, logging).
+/// @details With PPC_MPI_GROUPS set (e.g. `2,4,8`), consecutive ranks are split into groups of these sizes
+/// whose communicators become ppc::util::GetTaskComm(); every group runs all tests concurrently on its own
+/// task instances. With PPC_MPI_SHARDS the groups split the selected tests instead (see ppc::util::AssignTestShards()),
+/// except that tests of tasks using MPI_COMM_WORLD run on all processes (see WorldCommTestSwitcher), and the result
+/// is the worst status of all groups.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS or MPI error code if initialization/
@@ -49,4 +84,10 @@ int Init(int argc, char **argv);
 /// @return Exit code from RUN_ALL_TESTS.
 int SimpleInit(int argc, char **argv);
 
+/// @brief Entry point of ppc_bench: runs one task registered with ppc::util::RegisterBenchTasks() outside GoogleTest.
+/// @details Takes the options of ppc::util::ParseBenchArgs(); MPI, thread limits and placement are set up as for
+/// the test runners. Rank 0 prints the result.
+/// @return EXIT_SUCCESS, or EXIT_FAILURE on invalid arguments, an unknown task or a wrong output.
+int Bench(int argc, char **argv);
+
 }  // namespace ppc::runners
@@ -3,7 +3,10 @@
 #include <gtest/gtest.h>
 #include <mpi.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
@@ -14,8 +17,15 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "oneapi/tbb/global_control.h"
+#include "task/include/task.hpp"
+#include "util/include/affinity.hpp"
+#include "util/include/bench.hpp"
+#include "util/include/comm.hpp"
+#include "util/include/input_cache.hpp"
+#include "util/include/shard.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
@@ -23,13 +33,20 @@ namespace ppc::runners {
 void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/) {
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // Groups of a sharded run execute different tests, so only the processes of one group can meet here, and
+  // messages of other groups may be in flight on MPI_COMM_WORLD
+  MPI_Comm comm = ppc::util::GetTaskComm();
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(comm);
+  CheckUnreadMessages(comm, rank);
+  MPI_Barrier(comm);
+}
 
+void UnreadMessagesDetector::CheckUnreadMessages(MPI_Comm comm, int rank) {
   int flag = -1;
   MPI_Status status;
 
-  const int iprobe_res = MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+  const int iprobe_res = MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm, &flag, &status);
   if (iprobe_res != MPI_SUCCESS) {
     std::cerr << std::format("[  PROCESS {}  ] [  ERROR  ] MPI_Iprobe failed with code {}", rank, iprobe_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, iprobe_res);
@@ -43,8 +60,27 @@ void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/
         << '\n';
     MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
   }
+}
+
+void WorldCommTestSwitcher::OnTestStart(const ::testing::TestInfo &test_info) {
+  if (!ppc::util::IsWorldCommTest(std::string(test_info.test_suite_name()) + "." + test_info.name())) {
+    return;
+  }
+  group_comm_ = ppc::util::GetTaskComm();
+  group_ = ppc::util::GetTaskCommGroup();
+  ppc::util::SetTaskComm(MPI_COMM_WORLD);
+}
 
-  MPI_Barrier(MPI_COMM_WORLD);
+void WorldCommTestSwitcher::OnTestEnd(const ::testing::TestInfo & /*test_info*/) {
+  if (group_comm_ == MPI_COMM_NULL) {
+    return;
+  }
+  ppc::util::SetTaskComm(group_comm_, group_);
+  group_comm_ = MPI_COMM_NULL;
+}
+
+void InputCacheReleaser::OnTestSuiteEnd(const ::testing::TestSuite & /*test_suite*/) {
+  ppc::util::InputCache::Clear();
 }
 
 void WorkerTestFailurePrinter::OnTestEnd(const ::testing::TestInfo &test_info) {
@@ -115,6 +151,213 @@ void SyncGTestFilter() {
   ::testing::GTEST_FLAG(filter) = filter;
 }
 
+// Pins threads according to PPC_THREAD_PLACEMENT; processes sharing a node get disjoint CPUs
+void ApplyThreadPlacement(int local_rank) {
+  try {
+    ppc::util::affinity::Apply(local_rank);
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    throw;
+  }
+}
+
+void ApplyThreadPlacementMPI() {
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int local_rank = 0;
+  MPI_Comm_rank(node_comm, &local_rank);
+  MPI_Comm_free(&node_comm);
+  try {
+    ApplyThreadPlacement(local_rank);
+  } catch (const std::exception &) {
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+}
+
+// Splits MPI_COMM_WORLD into the groups of PPC_MPI_GROUPS, so every group runs its own task instances, or of
+// PPC_MPI_SHARDS, so every group runs its share of the tests; returns the shard sizes, empty without sharding
+std::vector<int> SplitTaskComm() {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  int group = -1;
+  std::vector<int> shards;
+  try {
+    const std::vector<int> sizes = ppc::util::GetCommGroups();
+    shards = ppc::util::GetCommShards();
+    if (!sizes.empty() && !shards.empty()) {
+      throw std::invalid_argument("PPC_MPI_GROUPS and PPC_MPI_SHARDS cannot be set together");
+    }
+    if (sizes.empty() && shards.empty()) {
+      return {};
+    }
+    group = shards.empty() ? ppc::util::AssignCommGroup(sizes, rank, size)
+                           : ppc::util::AssignCommGroup(shards, rank, size, "PPC_MPI_SHARDS");
+  } catch (const std::exception &e) {
+    if (rank == 0) {
+      std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    }
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+  MPI_Comm group_comm = MPI_COMM_NULL;
+  MPI_Comm_split(MPI_COMM_WORLD, group, rank, &group_comm);
+  ppc::util::SetTaskComm(group_comm, group);
+  return shards;
+}
+
+std::string FullTestName(const ::testing::TestSuite &suite, const ::testing::TestInfo &info) {
+  return std::string(suite.name()) + "." + info.name();
+}
+
+// Returns `Suite.Test` of every test the filter selects, in registration order
+std::vector<std::string> SelectedTests() {
+  const std::string filter = ::testing::GTEST_FLAG(filter);
+  const bool run_disabled = ::testing::GTEST_FLAG(also_run_disabled_tests);
+  const auto *unit_test = ::testing::UnitTest::GetInstance();
+  std::vector<std::string> names;
+  for (int i = 0; i < unit_test->total_test_suite_count(); ++i) {
+    const auto *suite = unit_test->GetTestSuite(i);
+    for (int j = 0; j < suite->total_test_count(); ++j) {
+      std::string name = FullTestName(*suite, *suite->GetTestInfo(j));
+      if ((run_disabled || name.find("DISABLED_") == std::string::npos) && ppc::util::MatchesTestFilter(name, filter)) {
+        names.push_back(std::move(name));
+      }
+    }
+  }
+  return names;
+}
+
+// Narrows the filter of this process to the tests ppc::util::AssignTestShards() gives its group; every rank
+// enumerates the same tests in registration order, so all of them agree on the assignment. Tests of tasks using
+// MPI_COMM_WORLD stay selected everywhere and run on all processes, see WorldCommTestSwitcher
+void ApplyTestShard(const std::vector<int> &sizes) {
+  std::vector<ppc::util::ShardedTest> tests;
+  std::size_t world_tests = 0;
+  for (auto &name : SelectedTests()) {
+    if (ppc::util::IsWorldCommTest(name)) {
+      ++world_tests;
+      continue;
+    }
+    const int min_procs = ppc::util::GetTestMinProcs(name);
+    tests.push_back({.name = std::move(name), .min_procs = min_procs});
+  }
+  const std::vector<int> groups = ppc::util::AssignTestShards(tests, sizes);
+  std::vector<std::string> other_groups;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (groups[i] != ppc::util::GetTaskCommGroup()) {
+      other_groups.push_back(tests[i].name);
+    }
+  }
+  ::testing::GTEST_FLAG(filter) = ppc::util::ExcludeFromTestFilter(::testing::GTEST_FLAG(filter), other_groups);
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0 && world_tests > 0) {
+    std::cout << std::format("[  SHARDS  ] Running {} tests of tasks that use MPI_COMM_WORLD on all processes",
+                             world_tests)
+              << '\n';
+  }
+}
+
+// Drops the tests of tasks using MPI_COMM_WORLD directly from a PPC_MPI_GROUPS run: on a group they would exchange
+// messages with the processes of the other groups
+void SkipWorldCommTests() {
+  std::vector<std::string> world_tests;
+  for (auto &name : SelectedTests()) {
+    if (ppc::util::IsWorldCommTest(name)) {
+      world_tests.push_back(std::move(name));
+    }
+  }
+  ::testing::GTEST_FLAG(filter) = ppc::util::ExcludeFromTestFilter(::testing::GTEST_FLAG(filter), world_tests);
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0 && !world_tests.empty()) {
+    std::cout << std::format("[  GROUPS  ] Skipping {} tests of tasks that use MPI_COMM_WORLD instead of GetComm()",
+                             world_tests.size())
+              << '\n';
+  }
+}
+
+// Prints how many tests every shard ran and which failed on rank 0; returns the worst status of all processes
+int MergeShardResults(const std::vector<int> &sizes, int status) {
+  int rank = 0;
+  int size = 1;
+  int task_rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(ppc::util::GetTaskComm(), &task_rank);
+
+  const auto *unit_test = ::testing::UnitTest::GetInstance();
+  std::string failed;
+  if (task_rank == 0) {
+    for (int i = 0; i < unit_test->total_test_suite_count(); ++i) {
+      const auto *suite = unit_test->GetTestSuite(i);
+      for (int j = 0; j < suite->total_test_count(); ++j) {
+        const auto *info = suite->GetTestInfo(j);
+        std::string name = FullTestName(*suite, *info);
+        // Every group runs the tests on MPI_COMM_WORLD; the first one reports them
+        if (ppc::util::IsWorldCommTest(name) && ppc::util::GetTaskCommGroup() != 0) {
+          continue;
+        }
+        if (info->should_run() && info->result()->Failed()) {
+          failed += name + '\n';
+        }
+      }
+    }
+  }
+  const std::array<int, 3> counts = {task_rank == 0 ? ppc::util::GetTaskCommGroup() : -1,
+                                     unit_test->test_to_run_count(), static_cast<int>(failed.size())};
+  std::vector<int> all_counts(rank == 0 ? counts.size() * static_cast<std::size_t>(size) : 0);
+  MPI_Gather(counts.data(), static_cast<int>(counts.size()), MPI_INT, all_counts.data(),
+             static_cast<int>(counts.size()), MPI_INT, 0, MPI_COMM_WORLD);
+
+  const auto processes = static_cast<std::size_t>(size);
+  std::vector<int> lengths(processes, 0);
+  std::vector<int> offsets(processes, 0);
+  std::string all_failed;
+  if (rank == 0) {
+    for (std::size_t i = 0; i < processes; ++i) {
+      lengths[i] = all_counts[(i * counts.size()) + 2];
+      offsets[i] = i == 0 ? 0 : offsets[i - 1] + lengths[i - 1];
+    }
+    all_failed.resize(static_cast<std::size_t>(offsets.back() + lengths.back()));
+  }
+  MPI_Gatherv(failed.data(), counts[2], MPI_CHAR, all_failed.data(), lengths.data(), offsets.data(), MPI_CHAR, 0,
+              MPI_COMM_WORLD);
+
+  if (rank == 0) {
+    for (std::size_t i = 0; i < processes; ++i) {
+      const int group = all_counts[i * counts.size()];
+      if (group < 0) {
+        continue;
+      }
+      const std::string_view group_failed = std::string_view(all_failed).substr(
+          static_cast<std::size_t>(offsets[i]), static_cast<std::size_t>(lengths[i]));
+      std::cout << std::format("[  SHARDS  ] Group {} ({} processes): {} tests ran, {} failed", group,
+                               sizes[static_cast<std::size_t>(group)], all_counts[(i * counts.size()) + 1],
+                               std::ranges::count(group_failed, '\n'))
+                << '\n';
+      for (std::size_t begin = 0; begin < group_failed.size();) {
+        const std::size_t end = group_failed.find('\n', begin);
+        std::cout << std::format("[  SHARDS  ] FAILED {}", group_failed.substr(begin, end - begin)) << '\n';
+        begin = end + 1;
+      }
+    }
+  }
+
+  int merged = status;
+  MPI_Allreduce(&status, &merged, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  return merged;
+}
+
+void FreeTaskComm() {
+  MPI_Comm comm = ppc::util::GetTaskComm();
+  if (comm != MPI_COMM_WORLD) {
+    ppc::util::SetTaskComm(MPI_COMM_WORLD);
+    MPI_Comm_free(&comm);
+  }
+}
+
 bool HasFlag(int argc, char **argv, std::string_view flag) {
   for (int i = 1; i < argc; ++i) {
     if (argv[i] != nullptr && std::string_view(argv[i]) == flag) {
@@ -124,6 +367,51 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+// Runs the benchmark selected by args; returns the exit code, identical on every process
+int RunBench(const std::vector<std::string_view> &args) {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  ppc::util::BenchArgs parsed;
+  try {
+    parsed = ppc::util::ParseBenchArgs(args);
+  } catch (const std::invalid_argument &e) {
+    if (rank == 0) {
+      std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    }
+    return EXIT_FAILURE;
+  }
+
+  if (parsed.list) {
+    if (rank == 0) {
+      for (const auto *entry : ppc::util::BenchRegistry::Entries()) {
+        std::cout << entry->task << " " << ppc::task::TypeOfTaskToString(entry->type)
+                  << " size=" << entry->default_size << " work=" << entry->work_exponent << '\n';
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  const auto *entry = ppc::util::BenchRegistry::Find(parsed.task, parsed.type);
+  if (entry == nullptr) {
+    if (rank == 0) {
+      std::cerr << std::format("[  ERROR  ] Task {} has no registered {} implementation", parsed.task,
+                               ppc::task::TypeOfTaskToString(parsed.type))
+                << '\n';
+    }
+    return EXIT_FAILURE;
+  }
+
+  const ppc::util::BenchResult result = entry->run(parsed.options);
+  int processes = 1;
+  MPI_Comm_size(ppc::util::GetTaskComm(), &processes);
+  if (rank == 0) {
+    std::cout << ppc::util::FormatBenchResult(*entry, parsed.options, result, processes, parsed.json) << '\n';
+  }
+  int correct = result.correct ? 1 : 0;
+  MPI_Bcast(&correct, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return correct != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -149,24 +437,40 @@ int Init(int argc, char **argv) {
 
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  ApplyThreadPlacementMPI();
+  const std::vector<int> shards = SplitTaskComm();
 
   ::testing::InitGoogleTest(&argc, argv);
 
   // Synchronize GoogleTest internals across ranks to avoid divergence
   SyncGTestSeed();
   SyncGTestFilter();
+  if (!shards.empty()) {
+    ApplyTestShard(shards);
+  } else if (ppc::util::GetTaskCommGroup() >= 0) {
+    SkipWorldCommTests();
+  }
 
   auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
   int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // In a sharded run every group leader prints the results of its own tests
+  MPI_Comm_rank(shards.empty() ? MPI_COMM_WORLD : ppc::util::GetTaskComm(), &rank);
   const bool print_workers = HasFlag(argc, argv, "--print-workers");
   if (rank != 0 && !print_workers) {
     auto *listener = listeners.Release(listeners.default_result_printer());
     listeners.Append(new WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
   }
+  if (!shards.empty()) {
+    listeners.Append(new WorldCommTestSwitcher());
+  }
   listeners.Append(new UnreadMessagesDetector());
+  listeners.Append(new InputCacheReleaser());
 
-  const int status = RunAllTestsSafely();
+  int status = RunAllTestsSafely();
+  if (!shards.empty()) {
+    status = MergeShardResults(shards, status);
+  }
+  FreeTaskComm();
 
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
@@ -180,9 +484,40 @@ int Init(int argc, char **argv) {
 int SimpleInit(int argc, char **argv) {
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  ApplyThreadPlacement(0);
 
   testing::InitGoogleTest(&argc, argv);
+  ::testing::UnitTest::GetInstance()->listeners().Append(new InputCacheReleaser());
   return RunAllTests();
 }
 
+int Bench(int argc, char **argv) {
+  const int init_res = MPI_Init(&argc, &argv);
+  if (init_res != MPI_SUCCESS) {
+    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
+    MPI_Abort(MPI_COMM_WORLD, init_res);
+    return init_res;
+  }
+
+  // Limit the number of threads in TBB
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  ApplyThreadPlacementMPI();
+
+  const std::vector<std::string_view> args(argv + 1, argv + argc);
+  int status = EXIT_FAILURE;
+  try {
+    status = RunBench(args);
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+
+  const int finalize_res = MPI_Finalize();
+  if (finalize_res != MPI_SUCCESS) {
+    std::cerr << std::format("[  ERROR  ] MPI_Finalize failed with code {}", finalize_res) << '\n';
+    return finalize_res;
+  }
+  return status;
+}
+
 }  // namespace ppc::runners
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::task {
+
+/// @brief How BatchTask spreads the inputs of a batch over processes.
+enum class BatchMode : uint8_t {
+  /// Every process runs every input.
+  kSequential,
+  /// Every MPI process runs a contiguous block of the inputs; the outputs are gathered on all processes.
+  kDistributed,
+};
+
+/// @brief Creates the task that runs single inputs of a batch, e.g. `ppc::task::TaskGetter<SomeTaskSEQ, InType>`.
+template <typename InType, typename OutType>
+using ItemTaskFactory = std::function<TaskPtr<InType, OutType>(InType)>;
+
+/// @brief Runs a task over a batch of inputs, reusing one task instance for all inputs of a process.
+/// @details Many small inputs are dominated by per-run overhead: task construction, buffer allocation and,
+/// for MPI implementations, collectives that cost more than the work on a tiny input. BatchTask creates the
+/// item task once and switches inputs with Task::ResetInput(). In kDistributed mode whole inputs are spread
+/// over the processes, so the item task must not communicate (use the SEQ implementation) and its output
+/// type must be trivially copyable; the only collectives are one status reduction and one gather per run.
+/// @tparam InType Input type of a single item.
+/// @tparam OutType Output type of a single item.
+template <typename InType, typename OutType>
+class BatchTask : public Task<std::vector<InType>, std::vector<OutType>> {
+ public:
+  /// @brief Creates a batch task.
+  /// @param inputs Inputs of the batch.
+  /// @param make_item Factory of the item task, called with the first input of each process.
+  /// @param mode Whether every process runs all inputs or a block of them.
+  BatchTask(std::vector<InType> inputs, ItemTaskFactory<InType, OutType> make_item,
+            BatchMode mode = BatchMode::kDistributed)
+      : make_item_(std::move(make_item)), mode_(mode) {
+    this->SetTypeOfTask(mode_ == BatchMode::kDistributed ? TypeOfTask::kMPI : TypeOfTask::kSEQ);
+    this->GetInput() = std::move(inputs);
+  }
+
+  /// @brief Returns the number of items whose pipeline failed in the last run, summed over all processes.
+  [[nodiscard]] int GetFailedItems() const {
+    return failed_items_;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    if (mode_ == BatchMode::kDistributed && !std::is_trivially_copyable_v<OutType>) {
+      return false;
+    }
+    return make_item_ && !this->GetInputView().empty();
+  }
+
+  bool PreProcessingImpl() override {
+    const std::size_t count = this->GetInputView().size();
+    int rank = 0;
+    int size = 1;
+    if (mode_ == BatchMode::kDistributed && IsMpiInitialized()) {
+      MPI_Comm_rank(this->GetComm(), &rank);
+      MPI_Comm_size(this->GetComm(), &size);
+    }
+    counts_.assign(static_cast<std::size_t>(size), 0);
+    displs_.assign(static_cast<std::size_t>(size), 0);
+    for (int i = 0; i < size; ++i) {
+      const std::size_t begin = BlockBegin(count, size, i);
+      counts_[i] = static_cast<int>(BlockBegin(count, size, i + 1) - begin);
+      displs_[i] = static_cast<int>(begin);
+    }
+    first_ = static_cast<std::size_t>(displs_[rank]);
+    last_ = first_ + static_cast<std::size_t>(counts_[rank]);
+    this->GetOutput().resize(count);
+    return true;
+  }
+
+  bool RunImpl() override {
+    const auto &inputs = this->GetInputView();
+    int local_failed = 0;
+    for (std::size_t i = first_; i < last_; ++i) {
+      if (RunItem(inputs[i])) {
+        this->GetOutput()[i] = item_->GetOutput();
+      } else {
+        local_failed++;
+      }
+    }
+    failed_items_ = local_failed;
+    if (mode_ == BatchMode::kDistributed && IsMpiInitialized()) {
+      if constexpr (std::is_trivially_copyable_v<OutType>) {
+        MPI_Allreduce(&local_failed, &failed_items_, 1, MPI_INT, MPI_SUM, this->GetComm());
+        GatherOutputs();
+      }
+    }
+    return failed_items_ == 0;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+  void ReuseImpl() override {
+    this->GetOutput().clear();
+    failed_items_ = 0;
+  }
+
+ private:
+  static bool IsMpiInitialized() {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    return initialized != 0;
+  }
+
+  static std::size_t BlockBegin(std::size_t count, int size, int index) {
+    const auto parts = static_cast<std::size_t>(size);
+    const auto part = static_cast<std::size_t>(index);
+    return (part * (count / parts)) + std::min(part, count % parts);
+  }
+
+  // Runs the whole pipeline of one item; a failed item task is dropped and recreated for the next input
+  bool RunItem(const InType &input) {
+    try {
+      if (item_) {
+        item_->ResetInput(InType(input));
+      } else {
+        item_ = make_item_(InType(input));
+      }
+      item_->GetStateOfTesting() = this->GetStateOfTesting();
+      if (item_->Validation() && item_->PreProcessing() && item_->Run() && item_->PostProcessing()) {
+        return true;
+      }
+    } catch (const std::exception &) {
+      // Counted as a failed item like a stage returning false
+    }
+    if (item_) {
+      item_->Abort();
+      item_.reset();
+    }
+    return false;
+  }
+
+  // Exchanges the outputs as raw bytes, which also works for std::vector<bool>
+  void GatherOutputs() {
+    constexpr auto kItemBytes = static_cast<int>(sizeof(OutType));
+    auto &outputs = this->GetOutput();
+    std::vector<std::byte> local(static_cast<std::size_t>(last_ - first_) * kItemBytes);
+    for (std::size_t i = first_; i < last_; ++i) {
+      const OutType value = outputs[i];
+      std::memcpy(local.data() + ((i - first_) * kItemBytes), &value, kItemBytes);
+    }
+    std::vector<int> byte_counts(counts_.size());
+    std::vector<int> byte_displs(displs_.size());
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      byte_counts[i] = counts_[i] * kItemBytes;
+      byte_displs[i] = displs_[i] * kItemBytes;
+    }
+    std::vector<std::byte> all(outputs.size() * kItemBytes);
+    MPI_Allgatherv(local.data(), static_cast<int>(local.size()), MPI_BYTE, all.data(), byte_counts.data(),
+                   byte_displs.data(), MPI_BYTE, this->GetComm());
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+      OutType value{};
+      std::memcpy(&value, all.data() + (i * kItemBytes), kItemBytes);
+      outputs[i] = value;
+    }
+  }
+
+  ItemTaskFactory<InType, OutType> make_item_;
+  BatchMode mode_;
+  TaskPtr<InType, OutType> item_;
+  std::vector<int> counts_;
+  std::vector<int> displs_;
+  std::size_t first_ = 0;
+  std::size_t last_ = 0;
+  int failed_items_ = 0;
+};
+
+}  // namespace ppc::task
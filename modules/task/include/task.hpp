@@ -1,9 +1,11 @@
 #pragma once
 
+#include <mpi.h>
 #include <omp.h>
 
 #include <array>
 #include <chrono>
+#include <concepts>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
@@ -13,6 +15,10 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <util/include/affinity.hpp>
+#include <util/include/comm.hpp>
+#include <util/include/thread_pool.hpp>
+#include <util/include/trace.hpp>
 #include <util/include/util.hpp>
 #include <utility>
 
@@ -96,8 +102,31 @@ inline std::string GetStringTaskType(TypeOfTask type_of_task, const std::string
   return type_str + "_" + std::string((*list_settings)["tasks"][type_str]);
 }
 
+/// @brief Task that communicates only on Task::GetComm(), so the runners may run its tests on a group of processes.
+/// @details Declared with `static constexpr bool kUsesTaskComm = true;` in the task class. Tests of other MPI and
+/// hybrid implementations run on MPI_COMM_WORLD in PPC_MPI_SHARDS runs and are skipped in PPC_MPI_GROUPS runs.
+template <typename TaskType>
+concept UsesTaskComm = TaskType::kUsesTaskComm;
+
+/// @brief Returns the prefix of the test names of TaskType, `<namespace>_<type>_<status>`.
+/// @details Registers the prefix with ppc::util::RegisterTaskCommTest() if TaskType satisfies UsesTaskComm.
+template <typename TaskType>
+std::string GetTaskTestName(const std::string &settings_file_path) {
+  std::string name = ppc::util::GetNamespace<TaskType>() + "_" +
+                     GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_file_path);
+  if constexpr (UsesTaskComm<TaskType>) {
+    ppc::util::RegisterTaskCommTest(name);
+  }
+  return name;
+}
+
 enum class StateOfTesting : uint8_t { kFunc, kPerf };
 
+/// @brief Read-only input shared between its owner and tasks without copying.
+/// @tparam InType Input data type.
+template <typename InType>
+using SharedInput = std::shared_ptr<const InType>;
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
 /// @tparam InType Input data type.
@@ -113,6 +142,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
+    const ppc::util::trace::ScopedSpan span("Validation", "task");
     return ValidationImpl();
   }
 
@@ -128,6 +158,8 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
+    PinThreads();
+    const ppc::util::trace::ScopedSpan span("PreProcessing", "task");
     return PreProcessingImpl();
   }
 
@@ -140,6 +172,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
+    const ppc::util::trace::ScopedSpan span("Run", "task");
     return RunImpl();
   }
 
@@ -155,9 +188,21 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
+    const ppc::util::trace::ScopedSpan span("PostProcessing", "task");
     return PostProcessingImpl();
   }
 
+  /// @brief Pins the OpenMP team of OMP and ALL implementations to the planned CPUs, once per task.
+  /// @details The destructor of the previous task may have released the pinned team. Perf calls this before the
+  /// timed runs; otherwise the first PreProcessing() does.
+  void PinThreads() {
+    if (threads_pinned_ || (type_of_task_ != TypeOfTask::kOMP && type_of_task_ != TypeOfTask::kALL)) {
+      return;
+    }
+    threads_pinned_ = true;
+    ppc::util::affinity::PinOpenMpThreads();
+  }
+
   /// @brief Returns the current testing mode.
   /// @return Reference to the current StateOfTesting.
   StateOfTesting &GetStateOfTesting() {
@@ -188,12 +233,66 @@ class Task {
     return TypeOfTask::kUnknown;
   }
 
+  /// @brief Returns the communicator the task runs on.
+  /// @details MPI implementations use it instead of MPI_COMM_WORLD, so the runner can run independent task
+  /// instances on groups of processes (see PPC_MPI_GROUPS). Defaults to ppc::util::GetTaskComm() at construction.
+  [[nodiscard]] MPI_Comm GetComm() const {
+    return comm_;
+  }
+
+  /// @brief Makes the task run on comm; call it before Validation().
+  /// @param comm Communicator, owned by the caller and valid while the task runs.
+  void SetComm(MPI_Comm comm) {
+    comm_ = comm;
+  }
+
   /// @brief Returns a reference to the input data.
   /// @return Reference to the task's input data.
   InType &GetInput() {
     return input_;
   }
 
+  /// @brief Returns the input for reading, whether it is owned or borrowed.
+  /// @return The borrowed input if BorrowInput() was called, the owned input otherwise.
+  [[nodiscard]] const InType &GetInputView() const {
+    return borrowed_input_ ? *borrowed_input_ : input_;
+  }
+
+  /// @brief Makes the task read a shared input through GetInputView() instead of owning a copy.
+  /// @param input Input kept alive by the task for its whole lifetime.
+  void BorrowInput(SharedInput<InType> input) {
+    borrowed_input_ = std::move(input);
+  }
+
+  /// @brief Replaces the input to run the pipeline again without reconstructing the task.
+  /// @details Allowed before the first Validation() and after PostProcessing(). Members of the task, such as
+  /// scratch buffers and communicator setup, are kept; ReuseImpl() prepares the output for the next run.
+  /// @param input New input, owned by the task.
+  /// @throws std::runtime_error If the pipeline is in progress or failed.
+  void ResetInput(InType input) {
+    CheckReusable();
+    input_ = std::move(input);
+    borrowed_input_.reset();
+    ReuseImpl();
+  }
+
+  /// @brief Replaces the input with a borrowed one, like BorrowInput(), to run the pipeline again.
+  /// @param input New input, kept alive by the task until the next reset.
+  /// @throws std::runtime_error If the pipeline is in progress or failed.
+  void ResetInput(SharedInput<InType> input) {
+    CheckReusable();
+    borrowed_input_ = std::move(input);
+    ReuseImpl();
+  }
+
+  /// @brief Abandons an unfinished pipeline, e.g. after a stage returned false, so the task can be destroyed.
+  /// @note The task cannot be reset afterwards.
+  void Abort() {
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
+      stage_ = PipelineStage::kException;
+    }
+  }
+
   /// @brief Returns a reference to the output data.
   /// @return Reference to the task's output data.
   OutType &GetOutput() {
@@ -209,6 +308,7 @@ class Task {
 #if _OPENMP >= 201811
     omp_pause_resource_all(omp_pause_soft);
 #endif
+    ppc::util::ThreadPool::PauseGlobal();
   }
 
  protected:
@@ -238,6 +338,13 @@ class Task {
     }
   }
 
+  /// @brief User-defined preparation for a new input, called by ResetInput().
+  /// @details Resets the output to a value-initialized OutType by default. Override it to restore the initial
+  /// output set by the constructor or to clear per-input state while keeping allocated buffers.
+  virtual void ReuseImpl() {
+    output_ = OutType{};
+  }
+
   /// @brief User-defined validation logic.
   /// @return True if validation is successful.
   virtual bool ValidationImpl() = 0;
@@ -255,11 +362,20 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
+  void CheckReusable() const {
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
+      throw std::runtime_error("ResetInput should be called before validation or after postprocessing");
+    }
+  }
+
   InType input_{};
+  SharedInput<InType> borrowed_input_;
   OutType output_{};
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
+  bool threads_pinned_ = false;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
+  MPI_Comm comm_ = ppc::util::GetTaskComm();
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
   enum class PipelineStage : uint8_t {
     kNone,
@@ -277,14 +393,24 @@ class Task {
 template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
+/// @brief Tasks constructible from a SharedInput read their input without owning a copy.
+template <typename TaskType, typename InType>
+concept BorrowsInput = std::constructible_from<TaskType, SharedInput<InType>>;
+
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is never copied here: it is moved into a SharedInput for tasks satisfying BorrowsInput
+/// and moved into the constructor otherwise, so tasks with an `InType &&` constructor take it over as is.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  if constexpr (BorrowsInput<TaskType, InType>) {
+    return std::make_shared<TaskType>(std::make_shared<const InType>(std::move(in)));
+  } else {
+    return std::make_shared<TaskType>(std::move(in));
+  }
 }
 
 }  // namespace ppc::task
@@ -0,0 +1,205 @@
+#include "task/include/batch_task.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+using ppc::task::BatchMode;
+using ppc::task::BatchTask;
+using ppc::task::Task;
+
+namespace {
+
+// Doubles its input; negative inputs fail validation
+class DoubleTask : public Task<int, int> {
+ public:
+  explicit DoubleTask(int in) {
+    GetInput() = in;
+    instances++;
+  }
+  bool ValidationImpl() override {
+    return GetInput() >= 0;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = 2 * GetInput();
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+  static inline int instances = 0;
+};
+
+template <typename OutType>
+bool RunBatch(Task<std::vector<int>, std::vector<OutType>> &task) {
+  return task.Validation() && task.PreProcessing() && task.Run() && task.PostProcessing();
+}
+
+}  // namespace
+
+TEST(BatchTaskTest, RunsEveryInputWithOneItemTask) {
+  DoubleTask::instances = 0;
+  BatchTask<int, int> task({1, 2, 3, 4, 5}, ppc::task::TaskGetter<DoubleTask, int>, BatchMode::kSequential);
+
+  ASSERT_TRUE(RunBatch(task));
+  EXPECT_EQ(task.GetOutput(), (std::vector<int>{2, 4, 6, 8, 10}));
+  EXPECT_EQ(DoubleTask::instances, 1);
+  EXPECT_EQ(task.GetDynamicTypeOfTask(), ppc::task::TypeOfTask::kSEQ);
+}
+
+TEST(BatchTaskTest, DistributedModeGathersAllOutputs) {
+  BatchTask<int, int> task({7, 0, 3}, ppc::task::TaskGetter<DoubleTask, int>);
+
+  ASSERT_TRUE(RunBatch(task));
+  EXPECT_EQ(task.GetOutput(), (std::vector<int>{14, 0, 6}));
+  EXPECT_EQ(task.GetDynamicTypeOfTask(), ppc::task::TypeOfTask::kMPI);
+}
+
+TEST(BatchTaskTest, RunCanBeRepeated) {
+  BatchTask<int, int> task({1, 2}, ppc::task::TaskGetter<DoubleTask, int>);
+
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), (std::vector<int>{2, 4}));
+}
+
+TEST(BatchTaskTest, FailedItemsFailTheRunButNotTheRest) {
+  DoubleTask::instances = 0;
+  BatchTask<int, int> task({1, -1, 3}, ppc::task::TaskGetter<DoubleTask, int>, BatchMode::kSequential);
+
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  EXPECT_FALSE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetFailedItems(), 1);
+  EXPECT_EQ(task.GetOutput()[0], 2);
+  EXPECT_EQ(task.GetOutput()[2], 6);
+  // The failed item task is abandoned and replaced
+  EXPECT_EQ(DoubleTask::instances, 2);
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+}
+
+TEST(BatchTaskTest, ValidationFailsForEmptyBatch) {
+  BatchTask<int, int> task({}, ppc::task::TaskGetter<DoubleTask, int>);
+  EXPECT_FALSE(task.Validation());
+  task.Abort();
+}
+
+TEST(BatchTaskTest, BoolOutputsAreGathered) {
+  auto make_item = [](int in) -> ppc::task::TaskPtr<int, bool> {
+    class IsEvenTask : public Task<int, bool> {
+     public:
+      explicit IsEvenTask(int in) {
+        GetInput() = in;
+      }
+      bool ValidationImpl() override {
+        return true;
+      }
+      bool PreProcessingImpl() override {
+        return true;
+      }
+      bool RunImpl() override {
+        GetOutput() = GetInput() % 2 == 0;
+        return true;
+      }
+      bool PostProcessingImpl() override {
+        return true;
+      }
+    };
+    return std::make_shared<IsEvenTask>(in);
+  };
+  BatchTask<int, bool> task({1, 2, 4}, make_item);
+
+  ASSERT_TRUE(RunBatch(task));
+  EXPECT_EQ(task.GetOutput(), (std::vector<bool>{false, true, true}));
+}
+
+TEST(BatchTaskTest, ValidationFailsWithoutFactory) {
+  BatchTask<int, int> task({1}, nullptr);
+  EXPECT_FALSE(task.Validation());
+  task.Abort();
+}
+
+TEST(BatchTaskTest, ValidationFailsForDistributedNonTrivialOutput) {
+  // Never called: the batch is rejected before any item runs
+  auto make_item = [](int /*in*/) -> ppc::task::TaskPtr<int, std::vector<int>> { return nullptr; };
+  BatchTask<int, std::vector<int>> task({1}, make_item);
+  EXPECT_FALSE(task.Validation());
+  task.Abort();
+}
+
+namespace {
+
+// Batch of inputs_per_process inputs per process plus extra_inputs, so the blocks differ in size
+struct DistributedBatchParam {
+  std::string name;
+  int inputs_per_process = 0;
+  int extra_inputs = 0;
+};
+
+class BatchTaskDistributedTest : public ::testing::TestWithParam<DistributedBatchParam> {
+ protected:
+  static std::vector<int> MakeInputs() {
+    int initialized = 0;
+    int size = 1;
+    MPI_Initialized(&initialized);
+    if (initialized != 0) {
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+    }
+    std::vector<int> inputs(static_cast<std::size_t>((GetParam().inputs_per_process * size) + GetParam().extra_inputs));
+    std::iota(inputs.begin(), inputs.end(), 0);
+    return inputs;
+  }
+};
+
+// Under mpirun every process computes one block and GatherOutputs exchanges them; otherwise one process runs all
+TEST_P(BatchTaskDistributedTest, EveryProcessGetsAllOutputs) {
+  const auto inputs = MakeInputs();
+  BatchTask<int, int> task(inputs, ppc::task::TaskGetter<DoubleTask, int>);
+
+  ASSERT_TRUE(RunBatch(task));
+  std::vector<int> expected(inputs.size());
+  std::ranges::transform(inputs, expected.begin(), [](int in) { return 2 * in; });
+  EXPECT_EQ(task.GetOutput(), expected);
+  EXPECT_EQ(task.GetFailedItems(), 0);
+}
+
+TEST_P(BatchTaskDistributedTest, FailedItemsAreCountedOnEveryProcess) {
+  auto inputs = MakeInputs();
+  inputs.back() = -1;
+  BatchTask<int, int> task(inputs, ppc::task::TaskGetter<DoubleTask, int>);
+
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  EXPECT_FALSE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetFailedItems(), 1);
+  for (std::size_t i = 0; i + 1 < inputs.size(); ++i) {
+    EXPECT_EQ(task.GetOutput()[i], 2 * inputs[i]);
+  }
+}
+
+// Named like MPI task tests, so that the `_mpi_` runs select them
+INSTANTIATE_TEST_SUITE_P(
+    BatchTask, BatchTaskDistributedTest,
+    ::testing::Values(DistributedBatchParam{.name = "batch_task_mpi_fewer_inputs_than_processes", .extra_inputs = 1},
+                      DistributedBatchParam{.name = "batch_task_mpi_uneven_blocks", .inputs_per_process = 2,
+                                            .extra_inputs = 1}),
+    [](const ::testing::TestParamInfo<DistributedBatchParam> &info) { return info.param.name; });
+
+}  // namespace
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <chrono>
 #include <cstddef>
@@ -17,6 +18,8 @@
 
 #include "runners/include/runners.hpp"
 #include "task/include/task.hpp"
+#include "util/include/comm.hpp"
+#include "util/include/perf_test_util.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StatusOfTask;
@@ -307,6 +310,222 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+namespace {
+
+// Input that counts how often it is copied
+struct CountedInput {
+  inline static int copies = 0;
+  std::vector<int> data;
+  explicit CountedInput(std::vector<int> values) : data(std::move(values)) {}
+  CountedInput() = default;
+  CountedInput(const CountedInput &other) : data(other.data) {
+    copies++;
+  }
+  CountedInput(CountedInput &&) noexcept = default;
+  CountedInput &operator=(const CountedInput &other) {
+    data = other.data;
+    copies++;
+    return *this;
+  }
+  CountedInput &operator=(CountedInput &&) noexcept = default;
+  ~CountedInput() = default;
+};
+
+class SumTask : public Task<CountedInput, int> {
+ public:
+  bool ValidationImpl() override {
+    return !GetInputView().data.empty();
+  }
+  bool PreProcessingImpl() override {
+    GetOutput() = 0;
+    return true;
+  }
+  bool RunImpl() override {
+    for (int value : GetInputView().data) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class OwningTask : public SumTask {
+ public:
+  explicit OwningTask(CountedInput in) {
+    GetInput() = std::move(in);
+  }
+};
+
+class BorrowingTask : public SumTask {
+ public:
+  explicit BorrowingTask(ppc::task::SharedInput<CountedInput> in) {
+    BorrowInput(std::move(in));
+  }
+};
+
+template <typename TaskType>
+int RunSumTask(const std::shared_ptr<TaskType> &task) {
+  EXPECT_TRUE(task->Validation());
+  EXPECT_TRUE(task->PreProcessing());
+  EXPECT_TRUE(task->Run());
+  EXPECT_TRUE(task->PostProcessing());
+  return task->GetOutput();
+}
+
+}  // namespace
+
+static_assert(ppc::task::BorrowsInput<BorrowingTask, CountedInput>);
+static_assert(!ppc::task::BorrowsInput<OwningTask, CountedInput>);
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  CountedInput::copies = 0;
+  auto task = ppc::task::TaskGetter<OwningTask, CountedInput>(CountedInput({1, 2, 3}));
+  EXPECT_EQ(RunSumTask(task), 6);
+  EXPECT_EQ(CountedInput::copies, 0);
+}
+
+TEST(TaskTest, TaskGetterLendsInputToBorrowingTask) {
+  CountedInput::copies = 0;
+  auto task = ppc::task::TaskGetter<BorrowingTask, CountedInput>(CountedInput({4, 5}));
+  EXPECT_EQ(RunSumTask(task), 9);
+  EXPECT_EQ(CountedInput::copies, 0);
+  EXPECT_TRUE(task->GetInput().data.empty());
+}
+
+TEST(TaskTest, BorrowedInputIsSharedBetweenTasks) {
+  CountedInput::copies = 0;
+  const auto shared = std::make_shared<const CountedInput>(std::vector<int>{1, 1, 1});
+  auto first = std::make_shared<BorrowingTask>(shared);
+  auto second = std::make_shared<BorrowingTask>(shared);
+  EXPECT_EQ(RunSumTask(first), 3);
+  EXPECT_EQ(RunSumTask(second), 3);
+  EXPECT_EQ(&first->GetInputView(), &second->GetInputView());
+  EXPECT_EQ(CountedInput::copies, 0);
+}
+
+TEST(TaskTest, PerfTaskGetterBorrowsSharedInput) {
+  CountedInput::copies = 0;
+  const auto shared = std::make_shared<const CountedInput>(std::vector<int>{2, 3});
+  auto borrowing = ppc::util::PerfTaskGetter<BorrowingTask, CountedInput>(shared);
+  EXPECT_EQ(RunSumTask(borrowing), 5);
+  EXPECT_EQ(&borrowing->GetInputView(), shared.get());
+  EXPECT_EQ(CountedInput::copies, 0);
+
+  // Owning tasks need their own copy of a shared input, but take inputs of their case alone by move
+  auto owning = ppc::util::PerfTaskGetter<OwningTask, CountedInput>(shared);
+  EXPECT_EQ(RunSumTask(owning), 5);
+  EXPECT_EQ(CountedInput::copies, 1);
+  auto moved = ppc::util::PerfTaskGetter<OwningTask, CountedInput>(CountedInput({7}));
+  EXPECT_EQ(RunSumTask(moved), 7);
+  EXPECT_EQ(CountedInput::copies, 1);
+}
+
+namespace {
+
+// Keeps a scratch copy of the input whose buffer survives ResetInput()
+class ScratchTask : public SumTask {
+ public:
+  explicit ScratchTask(CountedInput in) {
+    GetInput() = std::move(in);
+  }
+  bool PreProcessingImpl() override {
+    scratch_.assign(GetInputView().data.begin(), GetInputView().data.end());
+    return SumTask::PreProcessingImpl();
+  }
+  [[nodiscard]] const std::vector<int> &GetScratch() const {
+    return scratch_;
+  }
+  int reuse_calls = 0;
+
+ protected:
+  void ReuseImpl() override {
+    reuse_calls++;
+    scratch_.clear();
+    GetOutput() = -1;
+  }
+
+ private:
+  std::vector<int> scratch_;
+};
+
+}  // namespace
+
+TEST(TaskTest, ResetInputRunsPipelineAgainWithoutCopy) {
+  CountedInput::copies = 0;
+  auto task = std::make_shared<OwningTask>(CountedInput({1, 2, 3}));
+  EXPECT_EQ(RunSumTask(task), 6);
+
+  task->ResetInput(CountedInput({10, 20}));
+  EXPECT_EQ(task->GetOutput(), 0);
+  EXPECT_EQ(RunSumTask(task), 30);
+  EXPECT_EQ(CountedInput::copies, 0);
+}
+
+TEST(TaskTest, ResetInputReplacesBorrowedInput) {
+  auto task = std::make_shared<BorrowingTask>(std::make_shared<const CountedInput>(std::vector<int>{1, 1}));
+  EXPECT_EQ(RunSumTask(task), 2);
+
+  const auto next = std::make_shared<const CountedInput>(std::vector<int>{5, 5, 5});
+  task->ResetInput(next);
+  EXPECT_EQ(RunSumTask(task), 15);
+  EXPECT_EQ(&task->GetInputView(), next.get());
+
+  task->ResetInput(CountedInput({7}));
+  EXPECT_EQ(RunSumTask(task), 7);
+}
+
+TEST(TaskTest, ResetInputCallsReuseImplAndKeepsTaskState) {
+  auto task = std::make_shared<ScratchTask>(CountedInput(std::vector<int>(64, 1)));
+  EXPECT_EQ(RunSumTask(task), 64);
+  const auto *buffer = task->GetScratch().data();
+
+  task->ResetInput(CountedInput(std::vector<int>(32, 2)));
+  EXPECT_EQ(task->reuse_calls, 1);
+  EXPECT_EQ(task->GetOutput(), -1);
+  EXPECT_EQ(RunSumTask(task), 64);
+  EXPECT_EQ(task->GetScratch().data(), buffer);
+}
+
+TEST(TaskTest, ResetInputThrowsWhilePipelineRuns) {
+  auto task = std::make_shared<OwningTask>(CountedInput({1}));
+  ASSERT_TRUE(task->Validation());
+  EXPECT_THROW(task->ResetInput(CountedInput({2})), std::runtime_error);
+  ASSERT_TRUE(task->PreProcessing());
+  ASSERT_TRUE(task->Run());
+  ASSERT_TRUE(task->PostProcessing());
+  EXPECT_EQ(task->GetOutput(), 1);
+}
+
+TEST(TaskTest, AbortAllowsDestroyingUnfinishedTask) {
+  {
+    auto task = std::make_shared<DummyTask>();
+    ASSERT_TRUE(task->Validation());
+    task->Abort();
+    EXPECT_THROW(task->ResetInput(1), std::runtime_error);
+  }
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+}
+
+TEST(TaskTest, TaskRunsOnTaskCommByDefault) {
+  ppc::util::SetTaskComm(MPI_COMM_SELF, 0);
+  auto task = std::make_shared<DummyTask>();
+  ppc::util::SetTaskComm(MPI_COMM_WORLD);
+  EXPECT_EQ(task->GetComm(), MPI_COMM_SELF);
+
+  task->SetComm(MPI_COMM_WORLD);
+  EXPECT_EQ(task->GetComm(), MPI_COMM_WORLD);
+  ASSERT_TRUE(task->Validation());
+  ASSERT_TRUE(task->PreProcessing());
+  ASSERT_TRUE(task->Run());
+  ASSERT_TRUE(task->PostProcessing());
+}
+
 int main(int argc, char **argv) {
+  // The MPI runs of the CI start the `_mpi_` tests under mpirun
+  if (ppc::util::IsUnderMpirun()) {
+    return ppc::runners::Init(argc, argv);
+  }
   return ppc::runners::SimpleInit(argc, argv);
 }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ppc::util::affinity {
+
+/// @brief Policy used to pin the threads of OMP/TBB/STL implementations to CPUs.
+enum class Placement : uint8_t {
+  /// Threads are not pinned and may migrate freely.
+  kNone,
+  /// Consecutive threads on neighbouring CPUs: hyperthread siblings first, then the next core of the socket.
+  kCompact,
+  /// Consecutive threads spread round-robin over sockets, one per physical core before using siblings.
+  kScatter,
+  /// All threads of a process on one NUMA node (processes of a node are spread over NUMA nodes).
+  kNumaLocal,
+};
+
+/// @brief Parses a placement name: `none`, `compact`, `scatter` or `numa-local`.
+/// @throws std::invalid_argument for unknown names.
+Placement ParsePlacement(std::string_view name);
+
+/// @brief Returns the name accepted by ParsePlacement().
+std::string_view GetPlacementName(Placement placement);
+
+/// @brief Returns the placement selected with the PPC_THREAD_PLACEMENT environment variable (default `none`).
+Placement GetPlacement();
+
+/// @brief Logical CPU available to the process.
+struct Cpu {
+  int id = 0;
+  /// Physical core id within the package.
+  int core = 0;
+  /// Socket id.
+  int package = 0;
+  /// NUMA node id.
+  int node = 0;
+};
+
+/// @brief CPUs the process may run on, as seen when the topology was first queried.
+struct Topology {
+  std::vector<Cpu> cpus;
+  int num_packages = 1;
+  int num_nodes = 1;
+};
+
+/// @brief Returns the topology of the CPUs in the affinity mask of the process (read from sysfs on Linux).
+/// @details Queried once, before any thread is pinned; other platforms report hardware_concurrency() CPUs
+/// on a single socket.
+const Topology &GetTopology();
+
+/// @brief Computes the CPU of every thread of one process.
+/// @param topology CPUs to place threads on.
+/// @param placement Placement policy.
+/// @param num_threads Threads per process.
+/// @param slot Index of the process among the processes sharing the node (local MPI rank).
+/// @return CPU id per thread index; empty for Placement::kNone. CPUs are reused when threads outnumber them.
+std::vector<int> PlanCpus(const Topology &topology, Placement placement, int num_threads, int slot);
+
+/// @brief Selects the placement and plans the CPUs of this process, then pins the OpenMP threads and starts
+/// pinning TBB worker threads as they join the default arena.
+/// @details Called once by the runners; does nothing for Placement::kNone. The calling thread is pinned as
+/// thread 0, OpenMP threads as by PinOpenMpThreads().
+/// @param slot Local MPI rank of the process.
+void Apply(int slot);
+
+/// @brief Pins the calling thread and an OpenMP team of GetNumThreads() threads to their planned CPUs.
+/// @details The runtime reuses the pinned team until omp_pause_resource_all() releases it, so every OMP and ALL
+/// task calls this once, see Task::PinThreads(). Does nothing when threads are not pinned.
+void PinOpenMpThreads();
+
+/// @brief Returns the planned CPU of the thread with the given index, or -1 when threads are not pinned.
+int GetThreadCpu(int index);
+
+/// @brief Pins the calling thread to cpu.
+/// @return True on success; false for negative cpu, on failure or on platforms without affinity support.
+bool PinCurrentThread(int cpu);
+
+/// @brief Starts a std::thread that pins itself to the planned CPU of index before calling function.
+/// @details Use it in STL implementations instead of the std::thread constructor, e.g.
+/// `threads[i] = ppc::util::affinity::StartPinnedThread(i, [&] { Work(i); });`. Without a placement policy
+/// it behaves like std::thread.
+template <typename Function>
+std::thread StartPinnedThread(int index, Function &&function) {
+  return std::thread([cpu = GetThreadCpu(index), function = std::forward<Function>(function)]() mutable {
+    PinCurrentThread(cpu);
+    function();
+  });
+}
+
+/// @brief Describes the effective placement for perf output, e.g.
+/// `policy=scatter,threads=4,cpus=0/28/1/29,packages=2,nodes=2,available=56`.
+std::string Describe(int num_threads);
+
+}  // namespace ppc::util::affinity
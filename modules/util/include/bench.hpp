@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::util {
+
+/// @brief Selects the timer of perf_attrs for a task type: omp_get_wtime() for OpenMP tasks, a steady clock for
+/// SEQ/STL/TBB tasks and MPI_Wtime() for MPI tasks. MPI runs start behind a barrier, share the adaptive stop decision
+/// and report the time of the slowest process together with the spread over processes.
+/// @throws std::runtime_error For task types that cannot be timed.
+void SetPerfTimer(ppc::task::TypeOfTask type, ppc::performance::PerfAttr &perf_attrs);
+
+/// @brief Parameters of one ppc_bench run.
+struct BenchOptions {
+  /// @brief Problem size passed to the task's input generator; 0 selects the task's default size.
+  std::size_t size = 0;
+  /// @brief Number of measured runs.
+  uint64_t repeat = 5;
+  /// @brief Number of unmeasured runs before the measured ones.
+  uint64_t warmup = 0;
+  ppc::performance::PerfResults::TypeOfRunning mode = ppc::performance::PerfResults::TypeOfRunning::kTaskRun;
+};
+
+/// @brief Outcome of one ppc_bench run.
+struct BenchResult {
+  /// @brief Problem size the input was generated for.
+  std::size_t size = 0;
+  ppc::performance::PerfResults results;
+  /// @brief False if the task's output check rejected the output of the last run.
+  bool correct = true;
+};
+
+/// @brief Describes how to build inputs of a task for ppc_bench.
+template <typename InType, typename OutType>
+struct BenchInput {
+  /// @brief Size used when ppc_bench is run without `--size`.
+  std::size_t default_size = 0;
+  /// @brief Builds the input for a problem size, e.g. an n x n matrix for size n.
+  std::function<InType(std::size_t)> make;
+  /// @brief Optional check of the output for a problem size.
+  std::function<bool(std::size_t, const OutType &)> check;
+  /// @brief Power of the size the work grows with, e.g. 2 for an n x n matrix and 3 for the product of two.
+  /// @details Weak scaling runs `count` workers at size * count^(1 / work_exponent), so that each of them gets the
+  /// work of one worker at the base size.
+  double work_exponent = 1.0;
+};
+
+/// @brief One implementation of a task that ppc_bench can run.
+struct BenchEntry {
+  /// @brief Task id, i.e. the directory name under `tasks/`.
+  std::string task;
+  ppc::task::TypeOfTask type = ppc::task::TypeOfTask::kUnknown;
+  std::size_t default_size = 0;
+  /// @brief See BenchInput::work_exponent.
+  double work_exponent = 1.0;
+  std::function<BenchResult(const BenchOptions &)> run;
+};
+
+/// @brief Process-wide list of the task implementations known to ppc_bench.
+/// @details Performance tests fill it during static initialization through RegisterBenchTasks(), so every task
+/// linked into the binary is available by name without a central list.
+class BenchRegistry {
+ public:
+  static void Add(BenchEntry entry);
+  /// @brief Returns the entry of task and type, or nullptr if it is not registered.
+  static const BenchEntry *Find(std::string_view task, ppc::task::TypeOfTask type);
+  /// @brief Returns all entries sorted by task and type.
+  static std::vector<const BenchEntry *> Entries();
+
+ private:
+  static std::vector<BenchEntry> &Storage();
+};
+
+/// @brief Measures task with ppc::performance::Perf as options ask, using the timer of its type; ignores options.size.
+template <typename InType, typename OutType>
+ppc::performance::PerfResults MeasureTask(const ppc::task::TaskPtr<InType, OutType> &task,
+                                          const BenchOptions &options) {
+  ppc::performance::Perf<InType, OutType> perf(task);
+  ppc::performance::PerfAttr perf_attrs;
+  perf_attrs.num_running = options.repeat;
+  perf_attrs.num_warmup = options.warmup;
+  SetPerfTimer(task->GetDynamicTypeOfTask(), perf_attrs);
+  if (options.mode == ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
+    perf.PipelineRun(perf_attrs);
+  } else {
+    perf.TaskRun(perf_attrs);
+  }
+  return perf.GetPerfResults();
+}
+
+/// @brief Builds a task from input.make(size) and measures it with ppc::performance::Perf.
+template <typename TaskType, typename InType, typename OutType>
+BenchResult RunBench(const BenchInput<InType, OutType> &input, const BenchOptions &options) {
+  BenchResult result;
+  result.size = options.size != 0 ? options.size : input.default_size;
+  const ppc::task::TaskPtr<InType, OutType> task = ppc::task::TaskGetter<TaskType, InType>(input.make(result.size));
+  result.results = MeasureTask(task, options);
+  if (input.check) {
+    result.correct = input.check(result.size, task->GetOutput());
+  }
+  return result;
+}
+
+/// @brief Registers every implementation in TaskTypes of task_id with ppc_bench.
+/// @details Call it from the task's performance test to initialize a namespace-scope constant, e.g.
+/// `const bool kBenchRegistered = ppc::util::RegisterBenchTasks<InType, OutType, TaskSEQ, TaskMPI>(
+/// PPC_ID_<task>, {.default_size = 1000, .make = MakeInput});`
+/// @return Always true.
+template <typename InType, typename OutType, typename... TaskTypes>
+bool RegisterBenchTasks(const std::string &task_id, const BenchInput<InType, OutType> &input) {
+  (BenchRegistry::Add({.task = task_id,
+                       .type = TaskTypes::GetStaticTypeOfTask(),
+                       .default_size = input.default_size,
+                       .work_exponent = input.work_exponent,
+                       .run = [input](const BenchOptions &options) {
+                         return RunBench<TaskTypes, InType, OutType>(input, options);
+                       }}),
+   ...);
+  return true;
+}
+
+/// @brief Command line of ppc_bench.
+struct BenchArgs {
+  std::string task;
+  ppc::task::TypeOfTask type = ppc::task::TypeOfTask::kSEQ;
+  BenchOptions options;
+  /// @brief Print the result as one JSON object instead of a text line.
+  bool json = false;
+  /// @brief Print the registered tasks instead of running one.
+  bool list = false;
+};
+
+/// @brief Parses `--task <id> --impl seq|mpi|omp|tbb|stl|all [--size N] [--repeat N] [--warmup N]
+/// [--mode task_run|pipeline] [--json]`, or `--list`.
+/// @throws std::invalid_argument On unknown options, missing values or a missing `--task`.
+BenchArgs ParseBenchArgs(const std::vector<std::string_view> &args);
+
+/// @brief Formats result as a text line or as a JSON object; processes is the size of the task communicator.
+std::string FormatBenchResult(const BenchEntry &entry, const BenchOptions &options, const BenchResult &result,
+                              int processes, bool json);
+
+}  // namespace ppc::util
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Returns the communicator new tasks run on: MPI_COMM_WORLD unless the runner split the world into groups.
+MPI_Comm GetTaskComm();
+
+/// @brief Returns the index of the group of this process, or -1 when tasks run on MPI_COMM_WORLD.
+int GetTaskCommGroup();
+
+/// @brief Sets the communicator that new tasks run on.
+/// @param comm Communicator, owned by the caller and valid while tasks use it.
+/// @param group Index of the group comm belongs to; -1 for MPI_COMM_WORLD.
+void SetTaskComm(MPI_Comm comm, int group = -1);
+
+/// @brief Parses comma-separated group sizes such as `2,4,8`.
+/// @param variable Environment variable named in error messages.
+/// @throws std::invalid_argument If a size is not a positive integer or the list is empty.
+std::vector<int> ParseCommGroups(std::string_view spec, std::string_view variable = "PPC_MPI_GROUPS");
+
+/// @brief Returns the group sizes selected with the PPC_MPI_GROUPS environment variable; empty when unset.
+std::vector<int> GetCommGroups();
+
+/// @brief Returns the group sizes selected with the PPC_MPI_SHARDS environment variable; empty when unset.
+/// @details Unlike PPC_MPI_GROUPS, the groups share out the functional tests instead of each running all of them.
+std::vector<int> GetCommShards();
+
+/// @brief Returns the group of a rank when consecutive ranks are assigned to groups of the given sizes.
+/// @param variable Environment variable named in error messages.
+/// @throws std::invalid_argument If the sizes do not add up to world_size.
+int AssignCommGroup(const std::vector<int> &sizes, int rank, int world_size,
+                    std::string_view variable = "PPC_MPI_GROUPS");
+
+/// @brief Marks the tests of a task that communicates only on Task::GetComm() as able to run on a group.
+/// @details Tests of other MPI and hybrid implementations use MPI_COMM_WORLD directly and must run on all
+/// processes. ppc::task::GetTaskTestName() registers the tasks satisfying ppc::task::UsesTaskComm.
+/// @param prefix Test name prefix, `<namespace>_<type>_<status>`.
+/// @return true, so that the call can initialize a namespace-scope constant next to the tests.
+bool RegisterTaskCommTest(std::string prefix);
+
+/// @brief Returns true if a registered prefix, followed by '_' or nothing, starts the parameter name of a test
+/// (the part after the last '/' of `Suite.Test/Param`).
+bool IsTaskCommTest(std::string_view test_name);
+
+/// @brief Returns true for tests of MPI and hybrid implementations (`_mpi_` or `_all_` in the name) that are not
+/// registered with RegisterTaskCommTest(), which need all processes on MPI_COMM_WORLD.
+bool IsWorldCommTest(std::string_view test_name);
+
+}  // namespace ppc::util
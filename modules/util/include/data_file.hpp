@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Read-only view of a whole file.
+/// @details The file is mapped with `mmap` and advised for sequential access, so opening a multi-GB corpus costs
+/// no copy and pages are read on first touch. Platforms without `mmap` read the file into memory instead.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  /// @throws std::runtime_error If the file cannot be opened or mapped.
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  [[nodiscard]] std::string_view Text() const {
+    return {reinterpret_cast<const char *>(data_), size_};
+  }
+  [[nodiscard]] std::span<const std::byte> Bytes() const {
+    return {data_, size_};
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+  [[nodiscard]] bool Empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  void Release();
+
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<std::byte> buffer_;
+};
+
+/// @brief Element type stored in a binary data file.
+enum class DataType : std::uint32_t {
+  kInt8 = 1,
+  kUInt8 = 2,
+  kInt32 = 3,
+  kInt64 = 4,
+  kFloat32 = 5,
+  kFloat64 = 6,
+};
+
+/// @brief Returns the DataType stored for T.
+template <typename T>
+constexpr DataType GetDataType() {
+  using V = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<V, char> || std::is_same_v<V, std::int8_t>) {
+    return DataType::kInt8;
+  } else if constexpr (std::is_same_v<V, std::uint8_t> || std::is_same_v<V, std::byte>) {
+    return DataType::kUInt8;
+  } else if constexpr (std::is_same_v<V, std::int32_t>) {
+    return DataType::kInt32;
+  } else if constexpr (std::is_same_v<V, std::int64_t>) {
+    return DataType::kInt64;
+  } else if constexpr (std::is_same_v<V, float>) {
+    return DataType::kFloat32;
+  } else if constexpr (std::is_same_v<V, double>) {
+    return DataType::kFloat64;
+  } else {
+    static_assert(std::is_same_v<V, void>, "Type cannot be stored in a binary data file");
+  }
+}
+
+/// @brief Returns the size of one element of type in bytes.
+std::size_t GetDataTypeSize(DataType type);
+
+/// @brief Largest number of dimensions a binary data file can describe.
+inline constexpr std::size_t kMaxDataRank = 4;
+
+/// @brief Memory-mapped binary data file: a 64-byte header followed by the elements in row-major order.
+/// @details The header holds the magic `PPCB`, a format version, the element type, the shape and an FNV-1a checksum
+/// of the payload. Header fields and elements use the native byte order of the writing host: Values() views the
+/// payload in place without converting it, so a file can only be read on a host with the same byte order. The
+/// payload starts 64 bytes into the file, so it is aligned for every DataType. Opening checks the header only; call
+/// VerifyChecksum() to read the whole payload once and compare it with the stored checksum.
+class BinaryFile {
+ public:
+  /// @throws std::runtime_error If the file cannot be mapped or its header is malformed.
+  explicit BinaryFile(const std::string &path);
+  /// @throws std::runtime_error If the header of file is malformed.
+  explicit BinaryFile(MappedFile file);
+
+  /// @brief Returns true if data starts with the binary file magic.
+  static bool HasMagic(std::span<const std::byte> data);
+
+  [[nodiscard]] DataType Type() const {
+    return type_;
+  }
+  [[nodiscard]] const std::vector<std::size_t> &Shape() const {
+    return shape_;
+  }
+  /// @brief Returns the number of elements, i.e. the product of Shape().
+  [[nodiscard]] std::size_t Count() const;
+
+  /// @brief Returns the elements in place.
+  /// @throws std::invalid_argument If the file stores another element type.
+  template <typename T>
+  [[nodiscard]] std::span<const T> Values() const {
+    if (GetDataType<T>() != type_) {
+      throw std::invalid_argument("Binary data file stores another element type");
+    }
+    return {reinterpret_cast<const T *>(Payload().data()), Count()};
+  }
+
+  [[nodiscard]] bool VerifyChecksum() const;
+
+ private:
+  [[nodiscard]] std::span<const std::byte> Payload() const;
+
+  MappedFile file_;
+  DataType type_ = DataType::kUInt8;
+  std::vector<std::size_t> shape_;
+  std::uint64_t checksum_ = 0;
+};
+
+/// @brief Writes payload as a binary data file of the given element type and shape.
+/// @throws std::invalid_argument If the shape has more than kMaxDataRank dimensions or does not match the payload.
+/// @throws std::runtime_error If the file cannot be written.
+void WriteBinaryFile(const std::string &path, DataType type, std::span<const std::size_t> shape,
+                     std::span<const std::byte> payload);
+
+/// @brief Writes values as a binary data file, one-dimensional unless a shape is given.
+template <typename T>
+void WriteBinaryFile(const std::string &path, std::span<const T> values, std::vector<std::size_t> shape = {}) {
+  if (shape.empty()) {
+    shape.push_back(values.size());
+  }
+  WriteBinaryFile(path, GetDataType<T>(), shape, std::as_bytes(values));
+}
+
+/// @brief Parses whitespace-separated numbers, e.g. the contents of a task's `data/*.txt` file.
+/// @throws std::invalid_argument On a token that is not a number of type T.
+template <typename T>
+std::vector<T> ParseValues(std::string_view text) {
+  constexpr std::string_view kSpaces = " \t\r\n\v\f";
+  std::vector<T> values;
+  std::size_t pos = text.find_first_not_of(kSpaces);
+  while (pos != std::string_view::npos) {
+    const std::size_t end = std::min(text.find_first_of(kSpaces, pos), text.size());
+    const char *first = text.data() + pos;
+    const char *last = text.data() + end;
+    // from_chars rejects the leading '+' that stream extraction accepts
+    if (*first == '+' && last - first > 1) {
+      ++first;
+    }
+    T value{};
+    const auto [ptr, error] = std::from_chars(first, last, value);
+    if (error != std::errc() || ptr != last) {
+      throw std::invalid_argument("Invalid number '" + std::string(text.substr(pos, end - pos)) + "'");
+    }
+    values.push_back(value);
+    pos = text.find_first_not_of(kSpaces, end);
+  }
+  return values;
+}
+
+/// @brief Loads the numbers of a data file, stored either as a binary data file or as whitespace-separated text.
+template <typename T>
+std::vector<T> LoadValues(const std::string &path) {
+  MappedFile file(path);
+  if (!BinaryFile::HasMagic(file.Bytes())) {
+    return ParseValues<T>(file.Text());
+  }
+  const BinaryFile binary(std::move(file));
+  const auto values = binary.Values<T>();
+  return {values.begin(), values.end()};
+}
+
+/// @brief Converts a whitespace-separated text file into a one-dimensional binary data file.
+template <typename T>
+void ConvertTextToBinary(const std::string &text_path, const std::string &binary_path) {
+  const auto values = ParseValues<T>(MappedFile(text_path).Text());
+  WriteBinaryFile<T>(binary_path, values);
+}
+
+}  // namespace ppc::util
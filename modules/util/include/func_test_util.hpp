@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "task/include/task.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
@@ -72,7 +73,9 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
       GTEST_SKIP();
     }
 
+    ppc::util::trace::Clear();
     InitializeAndRunTask(test_param);
+    ppc::util::trace::DumpTestTrace();
   }
 
   void ValidateTestName(const std::string &test_name) {
@@ -123,17 +126,13 @@ auto ExpandToValues(const Tuple &t) {
 }
 
 template <typename Task, typename InType, typename SizesContainer, std::size_t... Is>
-auto GenTaskTuplesImpl(const SizesContainer &sizes, const std::string &settings_path,
-                       std::index_sequence<Is...> /*unused*/) {
-  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<Task, InType>,
-                                         std::string(GetNamespace<Task>()) + "_" +
-                                             ppc::task::GetStringTaskType(Task::GetStaticTypeOfTask(), settings_path),
-                                         sizes[Is])...);
+auto GenTaskTuplesImpl(const SizesContainer &sizes, const std::string &name, std::index_sequence<Is...> /*unused*/) {
+  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<Task, InType>, name, sizes[Is])...);
 }
 
 template <typename Task, typename InType, typename SizesContainer>
 auto TaskListGenerator(const SizesContainer &sizes, const std::string &settings_path) {
-  return GenTaskTuplesImpl<Task, InType>(sizes, settings_path,
+  return GenTaskTuplesImpl<Task, InType>(sizes, ppc::task::GetTaskTestName<Task>(settings_path),
                                          std::make_index_sequence<std::tuple_size_v<std::decay_t<SizesContainer>>>{});
 }
 
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace ppc::util {
+
+/// @brief Process-wide store of immutable test inputs shared by every test case that asks for the same key.
+/// @details Lets the SEQ/MPI/OMP/TBB/STL cases of a performance suite reuse one generated input instead of
+/// regenerating it in every SetUp(). The runners clear the cache at the end of each test suite, so an input
+/// lives at most as long as the suite that built it.
+class InputCache {
+ public:
+  /// @brief Returns the value stored under key, building it with make() on first use.
+  /// @tparam T Stored type; every caller of the same key must use the same type.
+  /// @param key Cache key, e.g. the test suite name plus the input parameters.
+  /// @param make Callable returning T; runs at most once per key while the entry is cached.
+  /// @throws std::logic_error if the key already holds a value of a different type.
+  /// @note make() runs under the cache lock and must not use the cache itself.
+  template <typename T, typename Factory>
+  static std::shared_ptr<const T> GetOrCreate(const std::string &key, Factory &&make) {
+    const std::scoped_lock lock(Mutex());
+    auto &entry = Lookup(key);
+    if (entry.value) {
+      if (entry.type != std::type_index(typeid(T))) {
+        throw std::logic_error("InputCache: key '" + key + "' holds a value of a different type");
+      }
+      return std::static_pointer_cast<const T>(entry.value);
+    }
+    auto value = std::make_shared<const T>(std::forward<Factory>(make)());
+    entry.type = std::type_index(typeid(T));
+    entry.value = value;
+    return value;
+  }
+
+  /// @brief Releases all cached inputs; values still referenced by callers stay alive until released.
+  static void Clear();
+
+  /// @brief Returns the number of cached inputs.
+  static std::size_t Size();
+
+ private:
+  struct Entry {
+    std::type_index type = std::type_index(typeid(void));
+    std::shared_ptr<const void> value;
+  };
+
+  static std::mutex &Mutex();
+  /// @brief Returns the entry for key, inserting an empty one if missing. Requires Mutex() to be held.
+  static Entry &Lookup(const std::string &key);
+  static std::unordered_map<std::string, Entry> &Entries();
+};
+
+}  // namespace ppc::util
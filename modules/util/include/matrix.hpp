@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Alignment of Matrix storage in bytes: one cache line, and enough for AVX-512 loads.
+inline constexpr std::size_t kMatrixAlignment = 64;
+
+/// @brief Allocator returning kMatrixAlignment-aligned storage.
+template <typename T>
+struct AlignedAllocator {
+  using value_type = T;
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U> & /*other*/) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  T *allocate(std::size_t count) {
+    return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{kMatrixAlignment}));
+  }
+  void deallocate(T *ptr, std::size_t /*count*/) noexcept {
+    ::operator delete(ptr, std::align_val_t{kMatrixAlignment});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U> & /*other*/) const noexcept {
+    return true;
+  }
+};
+
+/// @brief Non-owning view of a `rows x cols` block whose rows start `stride` elements apart.
+/// @details Describes a tile or a column of a Matrix without copying it; ppc::mpi::ViewDatatype() turns it into a
+/// datatype that sends the block in one message.
+template <typename T>
+class MatrixView {
+ public:
+  MatrixView(T *data, std::size_t rows, std::size_t cols, std::size_t stride)
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+  [[nodiscard]] std::size_t Stride() const {
+    return stride_;
+  }
+  [[nodiscard]] T *Data() const {
+    return data_;
+  }
+
+  T &operator()(std::size_t row, std::size_t col) const {
+    return data_[(row * stride_) + col];
+  }
+  [[nodiscard]] std::span<T> Row(std::size_t row) const {
+    return {data_ + (row * stride_), cols_};
+  }
+
+ private:
+  T *data_;
+  std::size_t rows_;
+  std::size_t cols_;
+  std::size_t stride_;
+};
+
+/// @brief Dense row-major matrix in one contiguous, 64-byte aligned buffer.
+/// @details Replaces `std::vector<std::vector<T>>` inputs: rows are adjacent in memory, so a block of rows is a
+/// single span that MPI can scatter directly (`Flat()` with `unit = Cols()`), and nothing has to be flattened
+/// before sending or rebuilt afterwards.
+template <typename T>
+class Matrix {
+  static_assert(!std::is_same_v<T, bool>, "Matrix<bool> would not be contiguous, use Matrix<char>");
+
+ public:
+  using value_type = T;
+
+  Matrix() = default;
+  Matrix(std::size_t rows, std::size_t cols, const T &value = T{})
+      : rows_(rows), cols_(cols), data_(rows * cols, value) {}
+
+  /// @brief Builds a matrix from nested braces, e.g. `Matrix<int>{{1, 2}, {3, 4}}`.
+  /// @throws std::invalid_argument If the rows differ in length.
+  Matrix(std::initializer_list<std::initializer_list<T>> rows) : rows_(rows.size()), cols_(0) {
+    if (rows.size() > 0) {
+      cols_ = rows.begin()->size();
+    }
+    data_.reserve(rows_ * cols_);
+    for (const auto &row : rows) {
+      CheckRowLength(row.size());
+      data_.insert(data_.end(), row.begin(), row.end());
+    }
+  }
+
+  /// @brief Copies a nested-vector matrix.
+  /// @throws std::invalid_argument If the rows differ in length.
+  static Matrix FromRows(const std::vector<std::vector<T>> &rows) {
+    Matrix matrix(rows.size(), rows.empty() ? 0 : rows.front().size());
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+      matrix.CheckRowLength(rows[row].size());
+      std::ranges::copy(rows[row], matrix.Row(row).begin());
+    }
+    return matrix;
+  }
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return data_.size();
+  }
+  [[nodiscard]] bool Empty() const {
+    return data_.empty();
+  }
+
+  T &operator()(std::size_t row, std::size_t col) {
+    return data_[(row * cols_) + col];
+  }
+  const T &operator()(std::size_t row, std::size_t col) const {
+    return data_[(row * cols_) + col];
+  }
+
+  [[nodiscard]] std::span<T> Row(std::size_t row) {
+    return {data_.data() + (row * cols_), cols_};
+  }
+  [[nodiscard]] std::span<const T> Row(std::size_t row) const {
+    return {data_.data() + (row * cols_), cols_};
+  }
+
+  /// @brief Returns the `rows x cols` block whose top-left element is (row, col).
+  [[nodiscard]] MatrixView<T> Tile(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) {
+    return {data_.data() + (row * cols_) + col, rows, cols, cols_};
+  }
+  [[nodiscard]] MatrixView<const T> Tile(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+    return {data_.data() + (row * cols_) + col, rows, cols, cols_};
+  }
+  [[nodiscard]] MatrixView<T> Column(std::size_t col) {
+    return Tile(0, col, rows_, 1);
+  }
+  [[nodiscard]] MatrixView<const T> Column(std::size_t col) const {
+    return Tile(0, col, rows_, 1);
+  }
+
+  /// @brief Returns all elements in row-major order.
+  [[nodiscard]] std::span<T> Flat() {
+    return data_;
+  }
+  [[nodiscard]] std::span<const T> Flat() const {
+    return data_;
+  }
+  [[nodiscard]] T *Data() {
+    return data_.data();
+  }
+  [[nodiscard]] const T *Data() const {
+    return data_.data();
+  }
+
+  /// @brief Copies the matrix into nested vectors, e.g. to compare against reference data.
+  [[nodiscard]] std::vector<std::vector<T>> ToRows() const {
+    std::vector<std::vector<T>> rows;
+    rows.reserve(rows_);
+    for (std::size_t row = 0; row < rows_; ++row) {
+      rows.emplace_back(Row(row).begin(), Row(row).end());
+    }
+    return rows;
+  }
+
+  bool operator==(const Matrix &other) const = default;
+
+ private:
+  void CheckRowLength(std::size_t length) const {
+    if (length != cols_) {
+      throw std::invalid_argument("Matrix rows must have equal length: expected " + std::to_string(cols_) + ", got " +
+                                  std::to_string(length));
+    }
+  }
+
+  std::size_t rows_ = 0;
+  std::size_t cols_ = 0;
+  std::vector<T, AlignedAllocator<T>> data_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Describes the machine a performance result was measured on.
+struct HostInfo {
+  std::string host;
+  std::string cpu_model;
+  unsigned cpus = 0;
+  /// @brief Hash of host, cpu_model and cpus; results are only comparable between equal fingerprints.
+  std::string fingerprint;
+};
+
+/// @brief One performance test result as stored in the results history.
+struct PerfHistoryRecord {
+  /// @brief Task namespace, e.g. `example_processes`.
+  std::string task;
+  /// @brief Implementation, e.g. `mpi` or `omp`.
+  std::string implementation;
+  /// @brief `pipeline` or `task_run`.
+  std::string mode;
+  /// @brief Full test name as printed in the perf output, including an MPI group suffix.
+  std::string test;
+  int processes = 1;
+  int threads = 1;
+  double time_sec = 0.0;
+  /// @brief Per-run times of the measured runs, slowest process of each run for MPI tasks.
+  std::vector<double> samples;
+};
+
+/// @brief Returns the host name, CPU model and CPU count of this machine with their fingerprint.
+HostInfo GetHostInfo();
+
+/// @brief Returns the source revision of the build: PPC_PERF_REVISION if set, else the git revision at build time,
+/// else `unknown`.
+std::string GetBuildRevision();
+
+/// @brief Formats a record as one JSON line (without the trailing newline).
+/// @param timestamp UTC time of the measurement in ISO 8601 format.
+std::string FormatHistoryRecord(const PerfHistoryRecord &record, const HostInfo &host, const std::string &revision,
+                                const std::string &timestamp);
+
+/// @brief Appends a record of the current host, revision and time to the JSON lines file at path.
+/// @throws std::runtime_error If the file cannot be opened for appending.
+/// @note Each record is written with a single write, so concurrent writers (e.g. several MPI groups) do not
+/// interleave lines on local file systems.
+void AppendHistoryRecord(const std::string &path, const PerfHistoryRecord &record);
+
+}  // namespace ppc::util
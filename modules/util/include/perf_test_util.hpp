@@ -1,30 +1,72 @@
 #pragma once
 
 #include <gtest/gtest.h>
-#include <omp.h>
 
-#include <chrono>
 #include <csignal>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
 
+#include "performance/include/alloc_profile.hpp"
+#include "performance/include/mpi_profile.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
+#include "util/include/affinity.hpp"
+#include "util/include/bench.hpp"
+#include "util/include/input_cache.hpp"
+#include "util/include/perf_history.hpp"
+#include "util/include/sweep.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
 
 double GetTimeMPI();
+/// @brief Returns the rank of the process in the task communicator (see ppc::util::GetTaskComm()).
 int GetMPIRank();
+/// @brief Returns the value of flag on rank 0 to every process of the task communicator.
+bool SyncFlagMPI(bool flag);
+/// @brief Barrier over the task communicator, so every process starts a measured run at the same time.
+void SyncStartMPI();
+/// @brief Reduces per-run elapsed times to their min/mean/max over the task communicator on every process.
+/// @details All processes must pass the same number of samples.
+ppc::performance::RankSamples ReduceSamplesMPI(const std::vector<double> &samples);
+/// @brief Returns the suffix that tells apart perf results of MPI groups, e.g. `_group1_np4`; empty without groups.
+std::string GetTaskCommSuffix();
+
+/// @brief Input of one perf case: built for the case alone, or shared by the cases of the suite.
+template <typename InType>
+using PerfInput = std::variant<InType, ppc::task::SharedInput<InType>>;
+
+/// @brief Constructs the task of a perf case; shared inputs are borrowed by tasks satisfying BorrowsInput and
+/// copied into the others, inputs of the case alone are moved as by ppc::task::TaskGetter().
+template <typename TaskType, typename InType>
+std::shared_ptr<TaskType> PerfTaskGetter(PerfInput<InType> input) {
+  if (auto *owned = std::get_if<InType>(&input)) {
+    return ppc::task::TaskGetter<TaskType, InType>(std::move(*owned));
+  }
+  auto shared = std::get<ppc::task::SharedInput<InType>>(std::move(input));
+  if constexpr (ppc::task::BorrowsInput<TaskType, InType>) {
+    return std::make_shared<TaskType>(std::move(shared));
+  } else {
+    return std::make_shared<TaskType>(InType(*shared));
+  }
+}
 
 template <typename InType, typename OutType>
-using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
+using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(PerfInput<InType>)>, std::string,
                                  ppc::performance::PerfResults::TypeOfRunning>;
 
 template <typename InType, typename OutType>
@@ -42,29 +84,60 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
  protected:
   virtual bool CheckTestOutputData(OutType &output_data) = 0;
-  /// @brief Supplies input data for performance testing.
-  virtual InType GetTestInputData() = 0;
+  /// @brief Supplies input data for performance testing; not called when GetSharedTestInputData() returns one.
+  virtual InType GetTestInputData() {
+    throw std::logic_error("Perf test overrides neither GetTestInputData() nor GetSharedTestInputData()");
+  }
+  /// @brief Supplies an input shared by the cases of the suite, usually GetSharedInput(); null to build one with
+  /// GetTestInputData() for every case.
+  virtual ppc::task::SharedInput<InType> GetSharedTestInputData() {
+    return nullptr;
+  }
+  /// @brief Number of elements processed per run, used to normalize hardware counters (0 if unknown).
+  virtual uint64_t GetNumElements() {
+    return 0;
+  }
+
+  /// @brief Returns the input built by make() once per test suite and shared read-only by all of its cases.
+  /// @details Return it from GetSharedTestInputData() instead of generating the input in SetUp(), so the pipeline
+  /// and task_run cases of every implementation reuse one input. Tasks satisfying ppc::task::BorrowsInput read it
+  /// in place; the others get a copy.
+  /// @param make Callable returning InType; runs once per test suite and key.
+  /// @param key Distinguishes several inputs of one suite, e.g. by size.
+  template <typename Factory>
+  ppc::task::SharedInput<InType> GetSharedInput(Factory &&make, const std::string &key = {}) {
+    const auto *suite = ::testing::UnitTest::GetInstance()->current_test_suite();
+    const std::string suite_name = suite != nullptr ? suite->name() : std::string{};
+    return InputCache::GetOrCreate<InType>(suite_name + "/" + key, std::forward<Factory>(make));
+  }
 
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
-    if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
-        task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
-      const double t0 = GetTimeMPI();
-      perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
-    } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
-      const double t0 = omp_get_wtime();
-      perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
-    } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSEQ ||
-               task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSTL ||
-               task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kTBB) {
-      const auto t0 = std::chrono::high_resolution_clock::now();
-      perf_attrs.current_timer = [&] {
-        auto now = std::chrono::high_resolution_clock::now();
-        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
-        return static_cast<double>(ns) * 1e-9;
-      };
-    } else {
-      throw std::runtime_error("The task type is not supported for performance testing.");
+    const double target_rse = GetPerfTargetRse();
+    if (target_rse > 0.0) {
+      perf_attrs.adaptive = true;
+      perf_attrs.target_rse = target_rse;
     }
+    perf_attrs.collect_counters = GetPerfCountersEnabled();
+    perf_attrs.num_elements = GetNumElements();
+    SetPerfTimer(task_->GetDynamicTypeOfTask(), perf_attrs);
+  }
+
+  // Splits names such as `example_threads_omp_enabled` into task and implementation
+  PerfHistoryRecord MakeHistoryRecord(const std::string &test_name, const std::string &result_name,
+                                      ppc::performance::PerfResults::TypeOfRunning mode,
+                                      const ppc::performance::PerfResults &results) const {
+    const auto type = task_->GetDynamicTypeOfTask();
+    const std::string implementation = ppc::task::TypeOfTaskToString(type);
+    const auto impl_pos = test_name.rfind("_" + implementation + "_");
+    const bool threaded = type != ppc::task::TypeOfTask::kMPI && type != ppc::task::TypeOfTask::kSEQ;
+    return {.task = impl_pos == std::string::npos ? test_name : test_name.substr(0, impl_pos),
+            .implementation = implementation,
+            .mode = ppc::performance::GetStringParamName(mode),
+            .test = result_name,
+            .processes = results.ranks.processes,
+            .threads = threaded ? GetNumThreads() : 1,
+            .time_sec = results.time_sec,
+            .samples = results.samples};
   }
 
   void ExecuteTest(const PerfTestParam<InType, OutType> &perf_test_param) {
@@ -79,11 +152,30 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
-    task_ = task_getter(GetTestInputData());
+    ppc::util::trace::Clear();
+    ppc::task::SharedInput<InType> shared_input = GetSharedTestInputData();
+    PerfInput<InType> input = shared_input ? PerfInput<InType>(std::move(shared_input))
+                                           : PerfInput<InType>(GetTestInputData());
+    const bool profile_alloc = ppc::performance::AllocProfile::IsInterposed();
+    const auto construct_alloc =
+        profile_alloc ? ppc::performance::AllocProfile::Begin() : ppc::performance::AllocSnapshot{};
+    const double construct_start = GetTimeMPI();
+    task_ = task_getter(std::move(input));
+    const double construct_time = GetTimeMPI() - construct_start;
     ppc::performance::Perf perf(task_);
+    perf.RecordSetupStage("Construct", construct_time);
+    if (profile_alloc) {
+      perf.RecordSetupAlloc(ppc::performance::AllocProfile::End("Construct", construct_alloc));
+    }
     ppc::performance::PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
 
+    const bool profile_mpi = ppc::performance::MpiProfile::IsInterposed() &&
+                             (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
+                              task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL);
+    ppc::performance::MpiProfile::Reset();
+    const double wall_start = GetTimeMPI();
+
     if (mode == ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
       perf.PipelineRun(perf_attr);
     } else if (mode == ppc::performance::PerfResults::TypeOfRunning::kTaskRun) {
@@ -94,8 +186,35 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
       throw std::runtime_error(err_msg.str().c_str());
     }
 
+    // Gather before printing: PrintPerfStatistic may throw on rank 0 only
+    // Each MPI group reports its own results
+    const std::string result_name = test_name + GetTaskCommSuffix();
+    const std::string mpi_report =
+        profile_mpi ? ppc::performance::MpiProfile::GatherReport(
+                          result_name + ":" + ppc::performance::GetStringParamName(mode), GetTimeMPI() - wall_start)
+                    : std::string{};
+    const std::string alloc_report =
+        profile_alloc ? ppc::performance::AllocProfile::GatherReport(
+                            result_name + ":" + ppc::performance::GetStringParamName(mode),
+                            perf.GetPerfResults().allocations,
+                            task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
+                                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL)
+                      : std::string{};
+    ppc::util::trace::DumpTestTrace();
+
     if (GetMPIRank() == 0) {
-      perf.PrintPerfStatistic(test_name);
+      perf.PrintPerfStatistic(result_name);
+      if (task_->GetDynamicTypeOfTask() != ppc::task::TypeOfTask::kMPI &&
+          task_->GetDynamicTypeOfTask() != ppc::task::TypeOfTask::kSEQ) {
+        std::cout << result_name << ":" << ppc::performance::GetStringParamName(mode)
+                  << ":placement:" << affinity::Describe(GetNumThreads()) << '\n';
+      }
+      std::cout << mpi_report;
+      std::cout << alloc_report;
+      const std::string history_path = GetPerfHistoryPath();
+      if (!history_path.empty()) {
+        AppendHistoryRecord(history_path, MakeHistoryRecord(test_name, result_name, mode, perf.GetPerfResults()));
+      }
     }
 
     OutType output_data = task_->GetOutput();
@@ -106,14 +225,96 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   ppc::task::TaskPtr<InType, OutType> task_;
 };
 
+/// @brief Parameters of a size-sweep case: implementation getter, test name and getter of the sequential baseline.
+template <typename InType, typename OutType>
+using SweepTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
+                                  std::function<ppc::task::TaskPtr<InType, OutType>(InType)>>;
+
+template <typename InType, typename OutType>
+/// @brief Base class for size-sweep performance tests that find where a parallel implementation overtakes SEQ.
+/// @details Each case times one implementation and the sequential baseline at every size of GetSizeSweep() and
+/// prints the sizes and the crossover (see FindCrossover()) on rank 0. Baseline times are measured once per suite
+/// and size. The cases are skipped unless PPC_PERF_SWEEP is set, since a sweep costs many perf runs.
+class BaseRunSweepPerfTests : public ::testing::TestWithParam<SweepTestParam<InType, OutType>> {
+ public:
+  static std::string CustomSweepTestName(const ::testing::TestParamInfo<SweepTestParam<InType, OutType>> &info) {
+    return "sweep_" + std::get<1>(info.param);
+  }
+
+  static void SetUpTestSuite() {
+    BaselineTimes().clear();
+  }
+
+ protected:
+  virtual SizeSweep GetSizeSweep() = 0;
+  /// @brief Builds the input for one problem size of the sweep.
+  virtual InType GetSweepInput(std::size_t size) = 0;
+  /// @brief Checks the output of the implementation at one size.
+  virtual bool CheckSweepOutput(std::size_t /*size*/, OutType & /*output_data*/) {
+    return true;
+  }
+  /// @brief Measured runs per size; the median of them is compared.
+  virtual uint64_t GetSweepRepeat() {
+    return 5;
+  }
+
+  void ExecuteSweep(const SweepTestParam<InType, OutType> &sweep_test_param) {
+    const auto &[task_getter, test_name, baseline_getter] = sweep_test_param;
+
+    ASSERT_FALSE(test_name.find("unknown") != std::string::npos);
+    if (test_name.find("disabled") != std::string::npos || !GetPerfSweepEnabled()) {
+      GTEST_SKIP();
+    }
+
+    const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
+    const std::string result_name = test_name + GetTaskCommSuffix();
+    const BenchOptions options = {.repeat = GetSweepRepeat()};
+
+    std::vector<SweepPoint> points;
+    // Keep sweeping after a wrong output, so every process runs the same MPI calls
+    std::optional<std::size_t> wrong_size;
+    for (const std::size_t size : SweepSizes(GetSizeSweep())) {
+      const InType input = GetSweepInput(size);
+      auto baseline = BaselineTimes().find(size);
+      if (baseline == BaselineTimes().end()) {
+        const auto baseline_results = MeasureTask(baseline_getter(input), options);
+        baseline = BaselineTimes().emplace(size, baseline_results.statistics.median_sec).first;
+      }
+
+      const ppc::task::TaskPtr<InType, OutType> task = task_getter(input);
+      const auto results = MeasureTask(task, options);
+      const SweepPoint point = {
+          .size = size, .baseline_sec = baseline->second, .time_sec = results.statistics.median_sec};
+      points.push_back(point);
+      if (GetMPIRank() == 0) {
+        std::cout << FormatSweepPoint(result_name, point) << '\n';
+      }
+      if (!wrong_size.has_value() && !CheckSweepOutput(size, task->GetOutput())) {
+        wrong_size = size;
+      }
+    }
+
+    if (GetMPIRank() == 0) {
+      std::cout << FormatCrossover(result_name, FindCrossover(points)) << '\n';
+    }
+    ASSERT_FALSE(wrong_size.has_value()) << "Wrong output at size " << *wrong_size;
+  }
+
+ private:
+  /// @brief Median baseline time per size of the current suite.
+  static std::map<std::size_t, double> &BaselineTimes() {
+    static std::map<std::size_t, double> times;
+    return times;
+  }
+};
+
 template <typename TaskType, typename InputType>
 auto MakePerfTaskTuples(const std::string &settings_path) {
-  const auto name = std::string(GetNamespace<TaskType>()) + "_" +
-                    ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
+  const auto name = ppc::task::GetTaskTestName<TaskType>(settings_path);
 
-  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
+  return std::make_tuple(std::make_tuple(PerfTaskGetter<TaskType, InputType>, name,
                                          ppc::performance::PerfResults::TypeOfRunning::kPipeline),
-                         std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
+                         std::make_tuple(PerfTaskGetter<TaskType, InputType>, name,
                                          ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
 }
 
@@ -133,4 +334,12 @@ auto MakeAllPerfTasks(const std::string &settings_path) {
   return std::tuple_cat(MakePerfTaskTuples<TaskTypes, InputType>(settings_path)...);
 }
 
+/// @brief Makes one size-sweep case per implementation in TaskTypes, each compared against BaselineTask.
+template <typename InputType, typename BaselineTask, typename... TaskTypes>
+auto MakeSweepPerfTasks(const std::string &settings_path) {
+  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskTypes, InputType>,
+                                         ppc::task::GetTaskTestName<TaskTypes>(settings_path),
+                                         ppc::task::TaskGetter<BaselineTask, InputType>)...);
+}
+
 }  // namespace ppc::util
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Processes a test of an MPI or hybrid implementation (`_mpi_` or `_all_` in its name) needs by default.
+constexpr int kMpiTestMinProcs = 2;
+
+/// @brief A functional test to be assigned to one group of a sharded run.
+struct ShardedTest {
+  /// @brief Full GoogleTest name, `Suite.Test`.
+  std::string name;
+  /// @brief Smallest group the test may run on.
+  int min_procs = 1;
+};
+
+/// @brief Makes tests matching pattern run only on groups of at least procs processes in sharded runs.
+/// @param pattern GoogleTest filter pattern (`*` and `?` wildcards) matched against `Suite.Test`.
+/// @return true, so that the call can initialize a namespace-scope constant next to the tests.
+bool RegisterTestMinProcs(std::string pattern, int procs);
+
+/// @brief Returns the processes a test needs: the largest registered requirement matching its name, at least
+/// kMpiTestMinProcs for MPI and hybrid implementations, otherwise 1.
+int GetTestMinProcs(std::string_view name);
+
+/// @brief Returns true if name is selected by a GoogleTest filter (`pos1:pos2-neg1:neg2`, `*` and `?` wildcards).
+bool MatchesTestFilter(std::string_view name, std::string_view filter);
+
+/// @brief Returns filter with names added to its negative patterns.
+std::string ExcludeFromTestFilter(std::string_view filter, const std::vector<std::string> &names);
+
+/// @brief Deterministically assigns every test to one group.
+/// @details Tests go, in order, to the least loaded group with at least min_procs processes, ties to the lower
+/// index; tests with a requirement are placed first. A test that no group can satisfy goes to the largest group.
+/// @param sizes Number of processes of every group.
+/// @return Group index per test.
+std::vector<int> AssignTestShards(const std::vector<ShardedTest> &tests, const std::vector<int> &sizes);
+
+}  // namespace ppc::util
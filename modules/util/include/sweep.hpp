@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Geometric range of problem sizes for a size-sweep performance test.
+struct SizeSweep {
+  std::size_t min_size = 0;
+  std::size_t max_size = 0;
+  /// @brief Ratio between neighbouring sizes; must be greater than 1.
+  double factor = 2.0;
+};
+
+/// @brief Returns min_size, min_size * factor, ... below max_size, followed by max_size itself.
+/// @details Sizes are rounded and strictly increasing, so small ranges with a small factor do not repeat sizes.
+/// @throws std::invalid_argument If min_size is 0, min_size > max_size or factor <= 1.
+std::vector<std::size_t> SweepSizes(const SizeSweep &sweep);
+
+/// @brief Time of an implementation and of the sequential baseline at one size.
+struct SweepPoint {
+  std::size_t size = 0;
+  double baseline_sec = 0.0;
+  double time_sec = 0.0;
+};
+
+/// @brief Returns the smallest swept size from which on the implementation beats the baseline at every larger size.
+/// @details A single faster size followed by a slower one is treated as noise and does not count as the crossover.
+/// @param points Sweep results in increasing size order.
+/// @return std::nullopt if the implementation is not faster at the largest size.
+std::optional<std::size_t> FindCrossover(const std::vector<SweepPoint> &points);
+
+/// @brief Formats one sweep point, e.g. `<name>:sweep:size=1000:0.0012000000:seq=0.0030000000:speedup=2.50`.
+std::string FormatSweepPoint(const std::string &name, const SweepPoint &point);
+
+/// @brief Formats the crossover line, e.g. `<name>:crossover:size=4000` or `<name>:crossover:none`.
+std::string FormatCrossover(const std::string &name, const std::optional<std::size_t> &crossover);
+
+}  // namespace ppc::util
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Persistent pool of worker threads for STL implementations.
+/// @details Workers are started on first use and reused by every later ParallelFor()/ParallelReduce() call,
+/// so repeated Task::Run() calls measure the work instead of thread creation. The calling thread takes part in
+/// every loop, so a pool of N threads starts N - 1 workers. Workers are pinned like other threads when
+/// PPC_THREAD_PLACEMENT is set. Task releases the global pool together with the OpenMP threads in its
+/// destructor; it restarts on the next call.
+class ThreadPool {
+ public:
+  /// @brief Creates a pool that runs loops on num_threads threads, including the caller.
+  /// @param num_threads Thread count; 0 uses GetNumThreads() each time the workers are started.
+  explicit ThreadPool(int num_threads = 0) : requested_threads_(num_threads) {}
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  /// @brief Returns the process-wide pool sized by PPC_NUM_THREADS.
+  static ThreadPool &Global();
+
+  /// @brief Stops the workers of the global pool if it was used; they restart on the next loop.
+  static void PauseGlobal();
+
+  /// @brief Returns the number of threads that run a loop, including the caller.
+  [[nodiscard]] int GetNumThreads() const;
+
+  /// @brief Calls body(begin, end) for consecutive chunks of [first, last) on all threads of the pool.
+  /// @param first Start of the range.
+  /// @param last End of the range (exclusive).
+  /// @param body Callable taking the bounds of one chunk.
+  /// @param grain Chunk size; 0 splits the range into about four chunks per thread. Threads take chunks
+  /// dynamically, so smaller chunks balance uneven work at the cost of more scheduling.
+  /// @throws Rethrows the first exception thrown by body after all threads have stopped.
+  /// @note Loops started from inside a loop body run sequentially on the calling thread.
+  template <typename Index, typename Body>
+  void ParallelFor(Index first, Index last, Body &&body, Index grain = 0) {
+    static_assert(std::is_integral_v<Index>, "ParallelFor requires an integral index type");
+    if (last <= first) {
+      return;
+    }
+    auto chunk = [&body](int64_t begin, int64_t end, std::size_t /*chunk_index*/) {
+      body(static_cast<Index>(begin), static_cast<Index>(end));
+    };
+    Execute(Job{.first = static_cast<int64_t>(first),
+                .last = static_cast<int64_t>(last),
+                .grain = static_cast<int64_t>(grain),
+                .context = &chunk,
+                .run_chunk = &RunChunk<decltype(chunk)>});
+  }
+
+  /// @brief Reduces [first, last) in parallel: every chunk is folded with body, partial results with reduce.
+  /// @param first Start of the range.
+  /// @param last End of the range (exclusive).
+  /// @param identity Initial value of every chunk and the result for an empty range.
+  /// @param body Callable `T(Index begin, Index end, T init)` folding one chunk into init.
+  /// @param reduce Callable `T(T lhs, T rhs)` combining two partial results.
+  /// @param grain Chunk size as in ParallelFor().
+  /// @return The partial results combined in chunk order, so the result does not depend on scheduling.
+  template <typename Index, typename T, typename Body, typename Reduce>
+  T ParallelReduce(Index first, Index last, T identity, Body &&body, Reduce &&reduce, Index grain = 0) {
+    static_assert(std::is_integral_v<Index>, "ParallelReduce requires an integral index type");
+    if (last <= first) {
+      return identity;
+    }
+    const int64_t chunk_size = GetChunkSize(static_cast<int64_t>(last) - static_cast<int64_t>(first), grain);
+    const auto num_chunks =
+        static_cast<std::size_t>((static_cast<int64_t>(last) - static_cast<int64_t>(first) + chunk_size - 1) /
+                                 chunk_size);
+    std::vector<T> partials(num_chunks, identity);
+    auto chunk = [&](int64_t begin, int64_t end, std::size_t chunk_index) {
+      partials[chunk_index] = body(static_cast<Index>(begin), static_cast<Index>(end), identity);
+    };
+    Execute(Job{.first = static_cast<int64_t>(first),
+                .last = static_cast<int64_t>(last),
+                .grain = chunk_size,
+                .context = &chunk,
+                .run_chunk = &RunChunk<decltype(chunk)>});
+    T result = std::move(partials.front());
+    for (std::size_t i = 1; i < partials.size(); ++i) {
+      result = reduce(std::move(result), std::move(partials[i]));
+    }
+    return result;
+  }
+
+  /// @brief Stops and joins the workers; the next loop starts them again.
+  /// @note Does nothing when called from inside a loop body.
+  void Pause();
+
+ private:
+  struct Job {
+    int64_t first = 0;
+    int64_t last = 0;
+    int64_t grain = 0;
+    void *context = nullptr;
+    void (*run_chunk)(void *context, int64_t begin, int64_t end, std::size_t chunk_index) = nullptr;
+  };
+
+  template <typename Chunk>
+  static void RunChunk(void *context, int64_t begin, int64_t end, std::size_t chunk_index) {
+    (*static_cast<Chunk *>(context))(begin, end, chunk_index);
+  }
+
+  template <typename Index>
+  [[nodiscard]] int64_t GetChunkSize(int64_t size, Index grain) const {
+    if (grain > 0) {
+      return static_cast<int64_t>(grain);
+    }
+    return std::max<int64_t>(1, size / (static_cast<int64_t>(GetNumThreads()) * 4));
+  }
+
+  void Execute(Job job);
+  void StartWorkers();
+  void WorkerLoop(int index, uint64_t seen_generation);
+  void RunChunks(const Job &job);
+
+  int requested_threads_;
+  // Serializes loops submitted from different threads and Pause()
+  std::mutex submit_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_cv_;
+  std::condition_variable done_cv_;
+  std::vector<std::thread> workers_;
+  bool started_ = false;
+  bool stop_ = false;
+  uint64_t generation_ = 0;
+  int busy_workers_ = 0;
+  Job job_;
+  std::atomic<int64_t> next_chunk_{0};
+  std::exception_ptr error_;
+};
+
+}  // namespace ppc::util
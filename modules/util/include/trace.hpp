@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ppc::util::trace {
+
+/// @brief Returns true when trace recording is enabled.
+/// @details Initialized from the PPC_TRACE environment variable, can be changed with SetEnabled().
+bool IsEnabled();
+
+/// @brief Enables or disables trace recording for all threads.
+void SetEnabled(bool enabled);
+
+/// @brief Returns true when spans are recorded, either for the trace or for span totals.
+bool IsRecording();
+
+/// @brief Starts summing the durations of spans by name on all threads (pipeline stage spans excluded).
+/// @details Used by ppc::performance::Perf to report user-defined phases such as scatter or broadcast
+/// time; works independently of PPC_TRACE.
+void BeginSpanTotals();
+
+/// @brief Stops summing span durations.
+/// @return Total seconds per span name, summed over all threads, in order of first occurrence.
+std::vector<std::pair<std::string, double>> EndSpanTotals();
+
+/// @brief Returns the current time of the trace clock in nanoseconds.
+int64_t NowNs();
+
+/// @brief Records a completed span on the calling thread.
+/// @param name Span name, truncated to a fixed length.
+/// @param category Chrome trace category; must point to a string with static storage duration.
+/// @param begin_ns Start time as returned by NowNs().
+/// @param end_ns End time as returned by NowNs().
+/// @note Lock-free when only tracing: every thread writes to its own ring buffer. Spans are dropped when the
+/// buffer is full.
+void RecordSpan(std::string_view name, const char *category, int64_t begin_ns, int64_t end_ns);
+
+/// @brief Discards all recorded spans of all threads.
+void Clear();
+
+/// @brief Drains the spans of all threads and formats them as Chrome trace event objects.
+/// @param pid Process id written to every event (the MPI rank).
+/// @return Comma-separated JSON objects without the enclosing array, empty if nothing was recorded.
+std::string CollectEvents(int pid);
+
+/// @brief Builds a Chrome trace JSON document (openable in chrome://tracing or Perfetto) from event chunks.
+/// @param chunks Results of CollectEvents() of one or several processes.
+std::string MakeChromeTrace(const std::vector<std::string> &chunks);
+
+/// @brief Collects the spans of the processes running the current test on their rank 0 and builds the merged
+/// Chrome trace.
+/// @return The trace on rank 0 of GetTaskComm(), an empty string on other ranks.
+/// @note Collective over GetTaskComm() when MPI is initialized; otherwise only local spans are used.
+std::string GatherChromeTrace();
+
+/// @brief Writes the merged trace of the current test to `$PPC_TEST_TMPDIR/trace.json` on rank 0 of GetTaskComm().
+/// @note Does nothing when tracing is disabled; collective like GatherChromeTrace() otherwise.
+void DumpTestTrace();
+
+/// @brief Records the lifetime of the object as a span when tracing is enabled.
+/// @details Task pipeline stages are recorded automatically; use it inside RunImpl() to mark user-defined
+/// phases, e.g. `const ppc::util::trace::ScopedSpan span("scatter");`. The name must outlive the span.
+class ScopedSpan {
+ public:
+  explicit ScopedSpan(std::string_view name, const char *category = "user")
+      : name_(name), category_(category), begin_ns_(IsRecording() ? NowNs() : -1) {}
+  ~ScopedSpan() {
+    if (begin_ns_ >= 0) {
+      RecordSpan(name_, category_, begin_ns_, NowNs());
+    }
+  }
+  ScopedSpan(const ScopedSpan &) = delete;
+  ScopedSpan &operator=(const ScopedSpan &) = delete;
+
+ private:
+  std::string_view name_;
+  const char *category_;
+  int64_t begin_ns_;
+};
+
+}  // namespace ppc::util::trace
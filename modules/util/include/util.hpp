@@ -71,6 +71,12 @@ int GetNumThreads();
 int GetNumProc();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
+double GetPerfTargetRse();
+bool GetPerfCountersEnabled();
+bool GetPerfSweepEnabled();
+/// @brief Returns the JSON lines file performance tests append their results to (PPC_PERF_HISTORY), empty if unset.
+std::string GetPerfHistoryPath();
+bool GetTraceEnabled();
 
 template <typename T>
 std::string GetNamespace() {
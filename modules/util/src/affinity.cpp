@@ -0,0 +1,309 @@
+#include "util/include/affinity.hpp"
+
+#include <omp.h>
+#include <tbb/task_scheduler_observer.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+
+#  include <filesystem>
+#  include <fstream>
+#endif
+
+#include "util/include/util.hpp"
+
+namespace ppc::util::affinity {
+
+namespace {
+
+constexpr std::array<std::pair<std::string_view, Placement>, 4> kPlacementNames = {{
+    {"none", Placement::kNone},
+    {"compact", Placement::kCompact},
+    {"scatter", Placement::kScatter},
+    {"numa-local", Placement::kNumaLocal},
+}};
+
+struct State {
+  Placement placement = Placement::kNone;
+  std::vector<int> cpus;
+};
+
+State &GetState() {
+  static State state;
+  return state;
+}
+
+#ifdef __linux__
+int ReadSysfsInt(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  int value = 0;
+  if (!(file >> value) || value < 0) {
+    return 0;
+  }
+  return value;
+}
+
+int ReadNode(const std::filesystem::path &cpu_dir) {
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(cpu_dir, ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.size() > 4 && name.starts_with("node") &&
+        std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      return std::stoi(name.substr(4));
+    }
+  }
+  return 0;
+}
+
+Topology ReadTopology() {
+  Topology topology;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+    return topology;
+  }
+  for (int id = 0; id < CPU_SETSIZE; ++id) {
+    if (CPU_ISSET(id, &mask) == 0) {
+      continue;
+    }
+    const std::filesystem::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(id);
+    topology.cpus.push_back(Cpu{.id = id,
+                                .core = ReadSysfsInt(dir / "topology" / "core_id"),
+                                .package = ReadSysfsInt(dir / "topology" / "physical_package_id"),
+                                .node = ReadNode(dir)});
+  }
+  return topology;
+}
+#else
+Topology ReadTopology() {
+  Topology topology;
+  const int count = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+  for (int id = 0; id < count; ++id) {
+    topology.cpus.push_back(Cpu{.id = id, .core = id});
+  }
+  return topology;
+}
+#endif
+
+int CountDistinct(const std::vector<Cpu> &cpus, int Cpu::*field) {
+  std::vector<int> values;
+  for (const auto &cpu : cpus) {
+    values.push_back(cpu.*field);
+  }
+  std::ranges::sort(values);
+  return static_cast<int>(std::ranges::unique(values).begin() - values.begin());
+}
+
+// Index of the CPU among the hyperthreads of its physical core (0 for the first sibling)
+std::map<int, int> SiblingIndices(const std::vector<Cpu> &cpus) {
+  std::map<std::pair<int, int>, std::vector<int>> cores;
+  for (const auto &cpu : cpus) {
+    cores[{cpu.package, cpu.core}].push_back(cpu.id);
+  }
+  std::map<int, int> sibling;
+  for (auto &[core, ids] : cores) {
+    std::ranges::sort(ids);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      sibling[ids[i]] = static_cast<int>(i);
+    }
+  }
+  return sibling;
+}
+
+std::vector<int> CompactOrder(std::vector<Cpu> cpus) {
+  std::ranges::sort(cpus, {}, [](const Cpu &cpu) { return std::tuple(cpu.node, cpu.package, cpu.core, cpu.id); });
+  std::vector<int> order;
+  for (const auto &cpu : cpus) {
+    order.push_back(cpu.id);
+  }
+  return order;
+}
+
+// Physical cores first, then their hyperthread siblings
+std::vector<Cpu> CoresFirst(std::vector<Cpu> cpus) {
+  const auto sibling = SiblingIndices(cpus);
+  std::ranges::sort(cpus, {}, [&sibling](const Cpu &cpu) { return std::tuple(sibling.at(cpu.id), cpu.core, cpu.id); });
+  return cpus;
+}
+
+std::vector<int> ScatterOrder(const std::vector<Cpu> &cpus) {
+  std::map<int, std::vector<Cpu>> packages;
+  for (const auto &cpu : CoresFirst(cpus)) {
+    packages[cpu.package].push_back(cpu);
+  }
+  std::vector<int> order;
+  for (std::size_t k = 0; order.size() < cpus.size(); ++k) {
+    for (const auto &[package, package_cpus] : packages) {
+      if (k < package_cpus.size()) {
+        order.push_back(package_cpus[k].id);
+      }
+    }
+  }
+  return order;
+}
+
+class PinningObserver final : public tbb::task_scheduler_observer {
+ public:
+  PinningObserver() {
+    observe(true);
+  }
+
+  void on_scheduler_entry(bool /*is_worker*/) override {
+    PinCurrentThread(GetThreadCpu(tbb::this_task_arena::current_thread_index()));
+  }
+};
+
+}  // namespace
+
+Placement ParsePlacement(std::string_view name) {
+  for (const auto &[placement_name, placement] : kPlacementNames) {
+    if (name == placement_name) {
+      return placement;
+    }
+  }
+  throw std::invalid_argument("Unknown thread placement '" + std::string(name) +
+                              "', expected one of: none, compact, scatter, numa-local");
+}
+
+std::string_view GetPlacementName(Placement placement) {
+  for (const auto &[placement_name, value] : kPlacementNames) {
+    if (value == placement) {
+      return placement_name;
+    }
+  }
+  return "none";
+}
+
+Placement GetPlacement() {
+  const auto value = env::get<std::string>("PPC_THREAD_PLACEMENT");
+  return value.has_value() ? ParsePlacement(value.value()) : Placement::kNone;
+}
+
+const Topology &GetTopology() {
+  static const Topology kTopology = [] {
+    Topology topology = ReadTopology();
+    if (topology.cpus.empty()) {
+      topology.cpus.push_back(Cpu{});
+    }
+    topology.num_packages = CountDistinct(topology.cpus, &Cpu::package);
+    topology.num_nodes = CountDistinct(topology.cpus, &Cpu::node);
+    return topology;
+  }();
+  return kTopology;
+}
+
+std::vector<int> PlanCpus(const Topology &topology, Placement placement, int num_threads, int slot) {
+  if (placement == Placement::kNone || topology.cpus.empty() || num_threads <= 0) {
+    return {};
+  }
+  slot = std::max(slot, 0);
+
+  std::vector<int> order;
+  std::size_t first = static_cast<std::size_t>(slot) * static_cast<std::size_t>(num_threads);
+  if (placement == Placement::kCompact) {
+    order = CompactOrder(topology.cpus);
+  } else if (placement == Placement::kScatter) {
+    order = ScatterOrder(topology.cpus);
+  } else {
+    // Processes take the NUMA nodes round-robin; those sharing a node split its CPUs
+    std::map<int, std::vector<Cpu>> nodes;
+    for (const auto &cpu : topology.cpus) {
+      nodes[cpu.node].push_back(cpu);
+    }
+    auto node = nodes.begin();
+    std::advance(node, slot % static_cast<int>(nodes.size()));
+    for (const auto &cpu : CoresFirst(node->second)) {
+      order.push_back(cpu.id);
+    }
+    first = static_cast<std::size_t>(slot / static_cast<int>(nodes.size())) * static_cast<std::size_t>(num_threads);
+  }
+
+  std::vector<int> cpus(static_cast<std::size_t>(num_threads));
+  for (std::size_t i = 0; i < cpus.size(); ++i) {
+    cpus[i] = order[(first + i) % order.size()];
+  }
+  return cpus;
+}
+
+void Apply(int slot) {
+  auto &state = GetState();
+  state.placement = GetPlacement();
+  if (state.placement == Placement::kNone) {
+    return;
+  }
+  state.cpus = PlanCpus(GetTopology(), state.placement, GetNumThreads(), slot);
+
+  PinOpenMpThreads();
+
+  // Never destroyed: worker threads may still enter the arena during static destruction
+  static auto *observer = new PinningObserver();
+  (void)observer;
+}
+
+void PinOpenMpThreads() {
+  if (GetState().cpus.empty()) {
+    return;
+  }
+  PinCurrentThread(GetThreadCpu(0));
+#pragma omp parallel num_threads(GetNumThreads()) default(none)
+  PinCurrentThread(GetThreadCpu(omp_get_thread_num()));
+}
+
+int GetThreadCpu(int index) {
+  const auto &cpus = GetState().cpus;
+  if (cpus.empty() || index < 0) {
+    return -1;
+  }
+  return cpus[static_cast<std::size_t>(index) % cpus.size()];
+}
+
+bool PinCurrentThread(int cpu) {
+  if (cpu < 0) {
+    return false;
+  }
+#ifdef __linux__
+  if (cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
+std::string Describe(int num_threads) {
+  const auto &state = GetState();
+  const auto &topology = GetTopology();
+  std::ostringstream out;
+  out << "policy=" << GetPlacementName(state.placement) << ",threads=" << num_threads << ",cpus=";
+  if (state.cpus.empty()) {
+    out << "any";
+  }
+  for (int i = 0; i < num_threads && !state.cpus.empty(); ++i) {
+    out << (i == 0 ? "" : "/") << GetThreadCpu(i);
+  }
+  out << ",packages=" << topology.num_packages << ",nodes=" << topology.num_nodes
+      << ",available=" << topology.cpus.size();
+  return out.str();
+}
+
+}  // namespace ppc::util::affinity
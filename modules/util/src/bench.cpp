@@ -0,0 +1,184 @@
+#include "util/include/bench.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::util {
+
+namespace {
+
+uint64_t ParseCount(std::string_view option, std::string_view value) {
+  uint64_t count = 0;
+  const auto [ptr, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+  if (error != std::errc() || ptr != value.data() + value.size()) {
+    throw std::invalid_argument("Invalid value '" + std::string(value) + "' for " + std::string(option));
+  }
+  return count;
+}
+
+ppc::task::TypeOfTask ParseImpl(std::string_view name) {
+  for (const auto &[type, type_name] : ppc::task::kTaskTypeMappings) {
+    if (type_name == name) {
+      return type;
+    }
+  }
+  throw std::invalid_argument("Unknown implementation '" + std::string(name) + "', expected seq|mpi|omp|tbb|stl|all");
+}
+
+ppc::performance::PerfResults::TypeOfRunning ParseMode(std::string_view name) {
+  if (name == "task_run") {
+    return ppc::performance::PerfResults::TypeOfRunning::kTaskRun;
+  }
+  if (name == "pipeline") {
+    return ppc::performance::PerfResults::TypeOfRunning::kPipeline;
+  }
+  throw std::invalid_argument("Unknown mode '" + std::string(name) + "', expected task_run|pipeline");
+}
+
+}  // namespace
+
+void SetPerfTimer(ppc::task::TypeOfTask type, ppc::performance::PerfAttr &perf_attrs) {
+  if (type == ppc::task::TypeOfTask::kMPI || type == ppc::task::TypeOfTask::kALL) {
+    const double t0 = GetTimeMPI();
+    perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
+    perf_attrs.sync_stop = SyncFlagMPI;
+    perf_attrs.sync_start = SyncStartMPI;
+    perf_attrs.reduce_samples = ReduceSamplesMPI;
+  } else if (type == ppc::task::TypeOfTask::kOMP) {
+    const double t0 = omp_get_wtime();
+    perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
+  } else if (type == ppc::task::TypeOfTask::kSEQ || type == ppc::task::TypeOfTask::kSTL ||
+             type == ppc::task::TypeOfTask::kTBB) {
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    perf_attrs.current_timer = [t0] {
+      auto now = std::chrono::high_resolution_clock::now();
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
+      return static_cast<double>(ns) * 1e-9;
+    };
+  } else {
+    throw std::runtime_error("The task type is not supported for performance testing.");
+  }
+}
+
+void BenchRegistry::Add(BenchEntry entry) {
+  Storage().push_back(std::move(entry));
+}
+
+const BenchEntry *BenchRegistry::Find(std::string_view task, ppc::task::TypeOfTask type) {
+  const auto &entries = Storage();
+  const auto it = std::ranges::find_if(entries, [&](const BenchEntry &entry) {
+    return entry.task == task && entry.type == type;
+  });
+  return it != entries.end() ? &*it : nullptr;
+}
+
+std::vector<const BenchEntry *> BenchRegistry::Entries() {
+  std::vector<const BenchEntry *> entries;
+  for (const auto &entry : Storage()) {
+    entries.push_back(&entry);
+  }
+  std::ranges::sort(entries, [](const BenchEntry *lhs, const BenchEntry *rhs) {
+    return std::tie(lhs->task, lhs->type) < std::tie(rhs->task, rhs->type);
+  });
+  return entries;
+}
+
+std::vector<BenchEntry> &BenchRegistry::Storage() {
+  static std::vector<BenchEntry> entries;
+  return entries;
+}
+
+BenchArgs ParseBenchArgs(const std::vector<std::string_view> &args) {
+  BenchArgs parsed;
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string_view option = args[i];
+    if (option == "--json") {
+      parsed.json = true;
+      continue;
+    }
+    if (option == "--list") {
+      parsed.list = true;
+      continue;
+    }
+    if (i + 1 >= args.size()) {
+      throw std::invalid_argument("Missing value for " + std::string(option));
+    }
+    const std::string_view value = args[++i];
+    if (option == "--task") {
+      parsed.task = value;
+    } else if (option == "--impl") {
+      parsed.type = ParseImpl(value);
+    } else if (option == "--size") {
+      parsed.options.size = static_cast<std::size_t>(ParseCount(option, value));
+    } else if (option == "--repeat") {
+      parsed.options.repeat = ParseCount(option, value);
+    } else if (option == "--warmup") {
+      parsed.options.warmup = ParseCount(option, value);
+    } else if (option == "--mode") {
+      parsed.options.mode = ParseMode(value);
+    } else {
+      throw std::invalid_argument("Unknown option " + std::string(option));
+    }
+  }
+  if (!parsed.list && parsed.task.empty()) {
+    throw std::invalid_argument("Missing --task");
+  }
+  if (parsed.options.repeat == 0) {
+    throw std::invalid_argument("--repeat must be positive");
+  }
+  return parsed;
+}
+
+std::string FormatBenchResult(const BenchEntry &entry, const BenchOptions &options, const BenchResult &result,
+                              int processes, bool json) {
+  const std::string impl = ppc::task::TypeOfTaskToString(entry.type);
+  const std::string mode = ppc::performance::GetStringParamName(options.mode);
+  const auto &stats = result.results.statistics;
+  if (json) {
+    const nlohmann::json record = {
+        {"task", entry.task},
+        {"impl", impl},
+        {"mode", mode},
+        {"size", result.size},
+        {"processes", processes},
+        {"threads", GetNumThreads()},
+        {"runs", result.results.samples.size()},
+        {"time_sec", result.results.time_sec},
+        {"min_sec", stats.min_sec},
+        {"median_sec", stats.median_sec},
+        {"p90_sec", stats.p90_sec},
+        {"stddev_sec", stats.stddev_sec},
+        {"rse", stats.rse},
+        {"imbalance", result.results.ranks.imbalance},
+        {"slowest_rank", result.results.ranks.slowest_rank},
+        {"correct", result.correct},
+    };
+    return record.dump();
+  }
+  std::ostringstream line;
+  line << entry.task << "_" << impl << ":" << mode << ":size=" << result.size << ":np=" << processes
+       << ":threads=" << GetNumThreads() << ":" << std::fixed << std::setprecision(10) << result.results.time_sec
+       << ":median=" << stats.median_sec << ":rse=" << stats.rse << (result.correct ? "" : ":WRONG_OUTPUT");
+  return line.str();
+}
+
+}  // namespace ppc::util
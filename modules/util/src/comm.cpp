@@ -0,0 +1,124 @@
+#include "util/include/comm.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+namespace {
+
+struct TaskCommState {
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int group = -1;
+};
+
+TaskCommState &State() {
+  static TaskCommState state;
+  return state;
+}
+
+struct TaskCommTestRegistry {
+  std::mutex mutex;
+  std::vector<std::string> prefixes;
+};
+
+TaskCommTestRegistry &Registry() {
+  static TaskCommTestRegistry registry;
+  return registry;
+}
+
+}  // namespace
+
+MPI_Comm GetTaskComm() {
+  return State().comm;
+}
+
+int GetTaskCommGroup() {
+  return State().group;
+}
+
+void SetTaskComm(MPI_Comm comm, int group) {
+  State() = TaskCommState{.comm = comm, .group = group};
+}
+
+std::vector<int> ParseCommGroups(std::string_view spec, std::string_view variable) {
+  std::vector<int> sizes;
+  while (!spec.empty()) {
+    const std::size_t comma = spec.find(',');
+    const std::string_view item = spec.substr(0, comma);
+    int size = 0;
+    const auto [end, error] = std::from_chars(item.data(), item.data() + item.size(), size);
+    if (error != std::errc{} || end != item.data() + item.size() || size <= 0) {
+      throw std::invalid_argument("Invalid MPI group size '" + std::string(item) + "' in " + std::string(variable));
+    }
+    sizes.push_back(size);
+    spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+  }
+  if (sizes.empty()) {
+    throw std::invalid_argument(std::string(variable) + " must list at least one group size");
+  }
+  return sizes;
+}
+
+std::vector<int> GetCommGroups() {
+  const auto value = env::get<std::string>("PPC_MPI_GROUPS");
+  return value.has_value() ? ParseCommGroups(value.value()) : std::vector<int>{};
+}
+
+std::vector<int> GetCommShards() {
+  const auto value = env::get<std::string>("PPC_MPI_SHARDS");
+  return value.has_value() ? ParseCommGroups(value.value(), "PPC_MPI_SHARDS") : std::vector<int>{};
+}
+
+int AssignCommGroup(const std::vector<int> &sizes, int rank, int world_size, std::string_view variable) {
+  const int total = std::accumulate(sizes.begin(), sizes.end(), 0);
+  if (total != world_size) {
+    throw std::invalid_argument(std::string(variable) + " sizes add up to " + std::to_string(total) +
+                                " processes, but " + std::to_string(world_size) + " were started");
+  }
+  int first = 0;
+  for (std::size_t group = 0; group < sizes.size(); ++group) {
+    first += sizes[group];
+    if (rank < first) {
+      return static_cast<int>(group);
+    }
+  }
+  return -1;
+}
+
+bool RegisterTaskCommTest(std::string prefix) {
+  auto &registry = Registry();
+  const std::lock_guard lock(registry.mutex);
+  registry.prefixes.push_back(std::move(prefix));
+  return true;
+}
+
+bool IsTaskCommTest(std::string_view test_name) {
+  const std::size_t slash = test_name.rfind('/');
+  const std::string_view param = slash == std::string_view::npos ? std::string_view{} : test_name.substr(slash + 1);
+  auto &registry = Registry();
+  const std::lock_guard lock(registry.mutex);
+  return std::ranges::any_of(registry.prefixes, [&](const std::string &prefix) {
+    return param.starts_with(prefix) && (param.size() == prefix.size() || param[prefix.size()] == '_');
+  });
+}
+
+bool IsWorldCommTest(std::string_view test_name) {
+  const bool mpi =
+      test_name.find("_mpi_") != std::string_view::npos || test_name.find("_all_") != std::string_view::npos;
+  return mpi && !IsTaskCommTest(test_name);
+}
+
+}  // namespace ppc::util
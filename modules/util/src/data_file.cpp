@@ -0,0 +1,237 @@
+#include "util/include/data_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace ppc::util {
+
+namespace {
+
+constexpr std::array<char, 4> kMagic = {'P', 'P', 'C', 'B'};
+constexpr std::uint32_t kFormatVersion = 1;
+
+struct BinaryHeader {
+  std::array<char, 4> magic{};
+  std::uint32_t version = 0;
+  std::uint32_t type = 0;
+  std::uint32_t rank = 0;
+  std::array<std::uint64_t, kMaxDataRank> shape{};
+  std::uint64_t checksum = 0;
+  std::uint64_t payload_bytes = 0;
+};
+
+static_assert(sizeof(BinaryHeader) == 64, "Binary data file header must stay 64 bytes");
+
+// FNV-1a, 64-bit
+std::uint64_t Checksum(std::span<const std::byte> data) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const std::byte value : data) {
+    hash ^= static_cast<std::uint64_t>(value);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::size_t CountOf(std::span<const std::size_t> shape) {
+  return std::accumulate(shape.begin(), shape.end(), std::size_t{1}, std::multiplies<>());
+}
+
+// Returns 0 for values that are not a DataType, e.g. read from a corrupt header
+std::size_t ElementSize(DataType type) {
+  switch (type) {
+    case DataType::kInt8:
+    case DataType::kUInt8:
+      return 1;
+    case DataType::kInt32:
+    case DataType::kFloat32:
+      return 4;
+    case DataType::kInt64:
+    case DataType::kFloat64:
+      return 8;
+  }
+  return 0;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+std::string ErrnoMessage(const std::string &what, const std::string &path) {
+  return what + " " + path + ": " + std::error_code(errno, std::generic_category()).message();
+}
+#endif
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string &path) {
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(ErrnoMessage("Failed to open file", path));
+  }
+  struct stat info{};
+  if (::fstat(fd, &info) != 0) {
+    const auto message = ErrnoMessage("Failed to stat file", path);
+    ::close(fd);
+    throw std::runtime_error(message);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  // mmap rejects empty mappings; an empty file is simply an empty view
+  if (size_ > 0) {
+    void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      const auto message = ErrnoMessage("Failed to map file", path);
+      ::close(fd);
+      throw std::runtime_error(message);
+    }
+    ::madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const std::byte *>(data);
+    mapped_ = true;
+  }
+  ::close(fd);
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  buffer_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+  Release();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, false)),
+      buffer_(std::move(other.buffer_)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped_ = std::exchange(other.mapped_, false);
+    buffer_ = std::move(other.buffer_);
+  }
+  return *this;
+}
+
+void MappedFile::Release() {
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapped_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast) munmap takes a mutable pointer to a read-only mapping
+    ::munmap(const_cast<std::byte *>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
+
+std::size_t GetDataTypeSize(DataType type) {
+  const std::size_t size = ElementSize(type);
+  if (size != 0) {
+    return size;
+  }
+  throw std::invalid_argument("Unknown data type " + std::to_string(static_cast<std::uint32_t>(type)));
+}
+
+BinaryFile::BinaryFile(const std::string &path) : BinaryFile(MappedFile(path)) {}
+
+BinaryFile::BinaryFile(MappedFile file) : file_(std::move(file)) {
+  if (!HasMagic(file_.Bytes()) || file_.Size() < sizeof(BinaryHeader)) {
+    throw std::runtime_error("Not a binary data file");
+  }
+  BinaryHeader header;
+  std::memcpy(&header, file_.Bytes().data(), sizeof(header));
+  if (header.version != kFormatVersion) {
+    throw std::runtime_error("Unsupported binary data file version " + std::to_string(header.version));
+  }
+  if (header.rank == 0 || header.rank > kMaxDataRank) {
+    throw std::runtime_error("Invalid binary data file rank " + std::to_string(header.rank));
+  }
+  type_ = static_cast<DataType>(header.type);
+  shape_.assign(header.shape.begin(), header.shape.begin() + header.rank);
+  checksum_ = header.checksum;
+
+  const std::size_t element_size = ElementSize(type_);
+  if (element_size == 0) {
+    throw std::runtime_error("Unknown binary data file element type " + std::to_string(header.type));
+  }
+  if (header.payload_bytes != Count() * element_size ||
+      header.payload_bytes != file_.Size() - sizeof(BinaryHeader)) {
+    throw std::runtime_error("Binary data file is truncated or its shape does not match the payload");
+  }
+}
+
+bool BinaryFile::HasMagic(std::span<const std::byte> data) {
+  return data.size() >= kMagic.size() && std::memcmp(data.data(), kMagic.data(), kMagic.size()) == 0;
+}
+
+std::size_t BinaryFile::Count() const {
+  return CountOf(shape_);
+}
+
+bool BinaryFile::VerifyChecksum() const {
+  return Checksum(Payload()) == checksum_;
+}
+
+std::span<const std::byte> BinaryFile::Payload() const {
+  return file_.Bytes().subspan(sizeof(BinaryHeader));
+}
+
+void WriteBinaryFile(const std::string &path, DataType type, std::span<const std::size_t> shape,
+                     std::span<const std::byte> payload) {
+  if (shape.empty() || shape.size() > kMaxDataRank) {
+    throw std::invalid_argument("Binary data files hold 1 to " + std::to_string(kMaxDataRank) + " dimensions");
+  }
+  if (CountOf(shape) * GetDataTypeSize(type) != payload.size()) {
+    throw std::invalid_argument("Shape does not match the payload size");
+  }
+
+  BinaryHeader header;
+  header.magic = kMagic;
+  header.version = kFormatVersion;
+  header.type = static_cast<std::uint32_t>(type);
+  header.rank = static_cast<std::uint32_t>(shape.size());
+  std::ranges::copy(shape, header.shape.begin());
+  header.checksum = Checksum(payload);
+  header.payload_bytes = payload.size();
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to create file: " + path);
+  }
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(payload.size()));
+  if (!file) {
+    throw std::runtime_error("Failed to write file: " + path);
+  }
+}
+
+}  // namespace ppc::util
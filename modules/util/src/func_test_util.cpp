@@ -1,13 +1,86 @@
 #include <mpi.h>
 
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "performance/include/mpi_profile.hpp"
+#include "performance/include/performance.hpp"
+#include "util/include/comm.hpp"
 #include "util/include/perf_test_util.hpp"
 
+namespace {
+
+// Layout of MPI_DOUBLE_INT for MPI_MAXLOC
+struct TotalOfRank {
+  double total;
+  int rank;
+};
+
+// Harness calls go through PMPI, so the MPI profile of a perf test only shows the task's own communication
+template <typename Call>
+void HarnessMPI(Call call) {
+  const double start = PMPI_Wtime();
+  call();
+  ppc::performance::MpiProfile::RecordHarness(PMPI_Wtime() - start);
+}
+
+}  // namespace
+
 double ppc::util::GetTimeMPI() {
   return MPI_Wtime();
 }
 
 int ppc::util::GetMPIRank() {
   int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(ppc::util::GetTaskComm(), &rank);
   return rank;
 }
+
+bool ppc::util::SyncFlagMPI(bool flag) {
+  int value = flag ? 1 : 0;
+  HarnessMPI([&] { PMPI_Bcast(&value, 1, MPI_INT, 0, ppc::util::GetTaskComm()); });
+  return value != 0;
+}
+
+void ppc::util::SyncStartMPI() {
+  HarnessMPI([] { PMPI_Barrier(ppc::util::GetTaskComm()); });
+}
+
+ppc::performance::RankSamples ppc::util::ReduceSamplesMPI(const std::vector<double> &samples) {
+  MPI_Comm comm = ppc::util::GetTaskComm();
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const auto count = static_cast<int>(samples.size());
+  ppc::performance::RankSamples reduced;
+  reduced.processes = size;
+  reduced.min_sec.resize(samples.size());
+  reduced.mean_sec.resize(samples.size());
+  reduced.max_sec.resize(samples.size());
+  const TotalOfRank local{.total = std::accumulate(samples.begin(), samples.end(), 0.0), .rank = rank};
+  TotalOfRank slowest{};
+  HarnessMPI([&] {
+    PMPI_Allreduce(samples.data(), reduced.min_sec.data(), count, MPI_DOUBLE, MPI_MIN, comm);
+    PMPI_Allreduce(samples.data(), reduced.max_sec.data(), count, MPI_DOUBLE, MPI_MAX, comm);
+    PMPI_Allreduce(samples.data(), reduced.mean_sec.data(), count, MPI_DOUBLE, MPI_SUM, comm);
+    PMPI_Allreduce(&local, &slowest, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm);
+  });
+  for (double &sum : reduced.mean_sec) {
+    sum /= static_cast<double>(size);
+  }
+  reduced.slowest_rank = slowest.rank;
+  return reduced;
+}
+
+std::string ppc::util::GetTaskCommSuffix() {
+  const int group = ppc::util::GetTaskCommGroup();
+  if (group < 0) {
+    return {};
+  }
+  int size = 0;
+  MPI_Comm_size(ppc::util::GetTaskComm(), &size);
+  return "_group" + std::to_string(group) + "_np" + std::to_string(size);
+}
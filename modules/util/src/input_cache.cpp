@@ -0,0 +1,39 @@
+#include "util/include/input_cache.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ppc::util {
+
+std::mutex &InputCache::Mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<std::string, InputCache::Entry> &InputCache::Entries() {
+  static std::unordered_map<std::string, Entry> entries;
+  return entries;
+}
+
+InputCache::Entry &InputCache::Lookup(const std::string &key) {
+  return Entries()[key];
+}
+
+void InputCache::Clear() {
+  std::unordered_map<std::string, Entry> released;
+  {
+    const std::scoped_lock lock(Mutex());
+    released.swap(Entries());
+  }
+}
+
+std::size_t InputCache::Size() {
+  const std::scoped_lock lock(Mutex());
+  return static_cast<std::size_t>(
+      std::ranges::count_if(Entries(), [](const auto &item) { return static_cast<bool>(item.second.value); }));
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,116 @@
+#include "util/include/perf_history.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#  include <cstdlib>
+#else
+#  include <unistd.h>
+#endif
+
+#include "ppc_git_revision.hpp"
+
+namespace ppc::util {
+
+namespace {
+
+std::string HostName() {
+#ifdef _WIN32
+  const char *name = std::getenv("COMPUTERNAME");  // NOLINT(concurrency-mt-unsafe)
+  return name != nullptr ? name : "unknown";
+#else
+  std::array<char, 256> name{};
+  if (gethostname(name.data(), name.size() - 1) != 0) {
+    return "unknown";
+  }
+  return name.data();
+#endif
+}
+
+std::string CpuModel() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (!line.starts_with("model name")) {
+      continue;
+    }
+    const auto colon = line.find(':');
+    const auto begin = line.find_first_not_of(' ', colon + 1);
+    return (colon == std::string::npos || begin == std::string::npos) ? std::string{} : line.substr(begin);
+  }
+  return "unknown";
+}
+
+// FNV-1a: stable across platforms and standard library implementations, unlike std::hash
+uint64_t Fnv1a(const std::string &data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::string UtcTimestamp() {
+  return std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+}
+
+}  // namespace
+
+HostInfo GetHostInfo() {
+  HostInfo info{.host = HostName(), .cpu_model = CpuModel(), .cpus = std::thread::hardware_concurrency()};
+  info.fingerprint =
+      std::format("{:016x}", Fnv1a(info.host + '\n' + info.cpu_model + '\n' + std::to_string(info.cpus)));
+  return info;
+}
+
+std::string GetBuildRevision() {
+  const auto revision = env::get<std::string>("PPC_PERF_REVISION");
+  if (revision.has_value() && !revision.value().empty()) {
+    return revision.value();
+  }
+  return PPC_GIT_REVISION;
+}
+
+std::string FormatHistoryRecord(const PerfHistoryRecord &record, const HostInfo &host, const std::string &revision,
+                                const std::string &timestamp) {
+  const nlohmann::json line = {
+      {"timestamp", timestamp},
+      {"revision", revision},
+      {"host", host.host},
+      {"cpu_model", host.cpu_model},
+      {"cpus", host.cpus},
+      {"fingerprint", host.fingerprint},
+      {"task", record.task},
+      {"implementation", record.implementation},
+      {"mode", record.mode},
+      {"test", record.test},
+      {"processes", record.processes},
+      {"threads", record.threads},
+      {"time_sec", record.time_sec},
+      {"samples", record.samples},
+  };
+  return line.dump();
+}
+
+void AppendHistoryRecord(const std::string &path, const PerfHistoryRecord &record) {
+  static const HostInfo kHost = GetHostInfo();
+  const std::string line = FormatHistoryRecord(record, kHost, GetBuildRevision(), UtcTimestamp()) + '\n';
+  std::ofstream out(path, std::ios::app | std::ios::binary);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open perf history file " + path);
+  }
+  out.write(line.data(), static_cast<std::streamsize>(line.size()));
+  out.flush();
+}
+
+}  // namespace ppc::util
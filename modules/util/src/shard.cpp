@@ -0,0 +1,139 @@
+#include "util/include/shard.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+namespace {
+
+struct MinProcsRegistry {
+  std::mutex mutex;
+  std::vector<std::pair<std::string, int>> patterns;
+};
+
+MinProcsRegistry &Registry() {
+  static MinProcsRegistry registry;
+  return registry;
+}
+
+bool MatchesPattern(std::string_view name, std::string_view pattern) {
+  std::size_t n = 0;
+  std::size_t p = 0;
+  std::size_t star = std::string_view::npos;
+  std::size_t star_n = 0;
+  while (n < name.size()) {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+      ++n;
+      ++p;
+    } else if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      star_n = n;
+    } else if (star != std::string_view::npos) {
+      p = star + 1;
+      n = ++star_n;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+bool MatchesAnyPattern(std::string_view name, std::string_view patterns) {
+  while (true) {
+    const std::size_t colon = patterns.find(':');
+    if (MatchesPattern(name, patterns.substr(0, colon))) {
+      return true;
+    }
+    if (colon == std::string_view::npos) {
+      return false;
+    }
+    patterns.remove_prefix(colon + 1);
+  }
+}
+
+}  // namespace
+
+bool RegisterTestMinProcs(std::string pattern, int procs) {
+  auto &registry = Registry();
+  const std::lock_guard lock(registry.mutex);
+  registry.patterns.emplace_back(std::move(pattern), procs);
+  return true;
+}
+
+int GetTestMinProcs(std::string_view name) {
+  int procs = 1;
+  if (name.find("_mpi_") != std::string_view::npos || name.find("_all_") != std::string_view::npos) {
+    procs = kMpiTestMinProcs;
+  }
+  auto &registry = Registry();
+  const std::lock_guard lock(registry.mutex);
+  for (const auto &[pattern, required] : registry.patterns) {
+    if (MatchesPattern(name, pattern)) {
+      procs = std::max(procs, required);
+    }
+  }
+  return procs;
+}
+
+bool MatchesTestFilter(std::string_view name, std::string_view filter) {
+  const std::size_t dash = filter.find('-');
+  const std::string_view positive = filter.substr(0, dash);
+  if (!MatchesAnyPattern(name, positive.empty() ? std::string_view("*") : positive)) {
+    return false;
+  }
+  return dash == std::string_view::npos || !MatchesAnyPattern(name, filter.substr(dash + 1));
+}
+
+std::string ExcludeFromTestFilter(std::string_view filter, const std::vector<std::string> &names) {
+  if (names.empty()) {
+    return std::string(filter);
+  }
+  std::string result(filter.empty() ? std::string_view("*") : filter);
+  result += result.find('-') == std::string::npos ? '-' : ':';
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    result += (i == 0 ? "" : ":") + names[i];
+  }
+  return result;
+}
+
+std::vector<int> AssignTestShards(const std::vector<ShardedTest> &tests, const std::vector<int> &sizes) {
+  std::vector<int> groups(tests.size(), 0);
+  if (sizes.empty()) {
+    return groups;
+  }
+  const auto largest = static_cast<int>(std::distance(sizes.begin(), std::ranges::max_element(sizes)));
+  std::vector<std::size_t> load(sizes.size(), 0);
+  auto assign = [&](std::size_t i) {
+    int best = -1;
+    for (std::size_t group = 0; group < sizes.size(); ++group) {
+      if (sizes[group] >= tests[i].min_procs && (best < 0 || load[group] < load[static_cast<std::size_t>(best)])) {
+        best = static_cast<int>(group);
+      }
+    }
+    groups[i] = best < 0 ? largest : best;
+    ++load[static_cast<std::size_t>(groups[i])];
+  };
+  // Constrained tests first, so that small groups take the rest of the load
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (tests[i].min_procs > 1) {
+      assign(i);
+    }
+  }
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (tests[i].min_procs <= 1) {
+      assign(i);
+    }
+  }
+  return groups;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,63 @@
+#include "util/include/sweep.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+std::vector<std::size_t> SweepSizes(const SizeSweep &sweep) {
+  if (sweep.min_size == 0 || sweep.min_size > sweep.max_size) {
+    throw std::invalid_argument("SizeSweep: expected 0 < min_size <= max_size");
+  }
+  if (!(sweep.factor > 1.0)) {
+    throw std::invalid_argument("SizeSweep: factor must be greater than 1");
+  }
+
+  std::vector<std::size_t> sizes;
+  double next = static_cast<double>(sweep.min_size);
+  while (next < static_cast<double>(sweep.max_size)) {
+    const auto size = static_cast<std::size_t>(std::llround(next));
+    if (sizes.empty() || size > sizes.back()) {
+      sizes.push_back(size);
+    }
+    next *= sweep.factor;
+  }
+  if (sizes.empty() || sizes.back() < sweep.max_size) {
+    sizes.push_back(sweep.max_size);
+  }
+  return sizes;
+}
+
+std::optional<std::size_t> FindCrossover(const std::vector<SweepPoint> &points) {
+  std::optional<std::size_t> crossover;
+  for (const auto &point : points) {
+    if (point.time_sec < point.baseline_sec) {
+      if (!crossover.has_value()) {
+        crossover = point.size;
+      }
+    } else {
+      crossover.reset();
+    }
+  }
+  return crossover;
+}
+
+std::string FormatSweepPoint(const std::string &name, const SweepPoint &point) {
+  std::ostringstream line;
+  line << name << ":sweep:size=" << point.size << ":" << std::fixed << std::setprecision(10) << point.time_sec
+       << ":seq=" << point.baseline_sec << std::setprecision(2)
+       << ":speedup=" << (point.time_sec > 0.0 ? point.baseline_sec / point.time_sec : 0.0);
+  return line.str();
+}
+
+std::string FormatCrossover(const std::string &name, const std::optional<std::size_t> &crossover) {
+  return name + ":crossover:" + (crossover.has_value() ? "size=" + std::to_string(*crossover) : std::string("none"));
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,162 @@
+#include "util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "util/include/affinity.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+namespace {
+
+// Set on pool workers and on callers while they run a loop, so nested loops run inline
+thread_local bool in_parallel_region = false;
+
+std::atomic<ThreadPool *> global_pool{nullptr};
+
+}  // namespace
+
+ThreadPool::~ThreadPool() {
+  Pause();
+}
+
+ThreadPool &ThreadPool::Global() {
+  // Never destroyed: tasks may still be released during static destruction
+  static auto *pool = [] {
+    auto *created = new ThreadPool();
+    global_pool.store(created);
+    return created;
+  }();
+  return *pool;
+}
+
+void ThreadPool::PauseGlobal() {
+  if (auto *pool = global_pool.load(); pool != nullptr) {
+    pool->Pause();
+  }
+}
+
+int ThreadPool::GetNumThreads() const {
+  return std::max(1, requested_threads_ > 0 ? requested_threads_ : ppc::util::GetNumThreads());
+}
+
+void ThreadPool::Pause() {
+  if (in_parallel_region) {
+    // Called from a loop body; the workers are still needed
+    return;
+  }
+  const std::scoped_lock submit_lock(submit_mutex_);
+  {
+    const std::scoped_lock lock(mutex_);
+    if (!started_) {
+      return;
+    }
+    stop_ = true;
+  }
+  wake_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  const std::scoped_lock lock(mutex_);
+  stop_ = false;
+  started_ = false;
+}
+
+void ThreadPool::StartWorkers() {
+  const int num_workers = GetNumThreads() - 1;
+  // Workers wait for jobs newer than this one, even if they start after the next job is posted
+  const uint64_t generation = generation_;
+  workers_.reserve(static_cast<std::size_t>(num_workers));
+  for (int i = 1; i <= num_workers; ++i) {
+    workers_.emplace_back([this, i, generation] { WorkerLoop(i, generation); });
+  }
+  started_ = true;
+}
+
+void ThreadPool::Execute(Job job) {
+  if (job.grain <= 0) {
+    job.grain = GetChunkSize(job.last - job.first, job.grain);
+  }
+  if (in_parallel_region) {
+    for (int64_t begin = job.first; begin < job.last; begin += job.grain) {
+      job.run_chunk(job.context, begin, std::min(job.last, begin + job.grain),
+                    static_cast<std::size_t>((begin - job.first) / job.grain));
+    }
+    return;
+  }
+
+  const std::scoped_lock submit_lock(submit_mutex_);
+  if (!started_) {
+    StartWorkers();
+  }
+  {
+    const std::scoped_lock lock(mutex_);
+    job_ = job;
+    next_chunk_.store(0);
+    error_ = nullptr;
+    busy_workers_ = static_cast<int>(workers_.size());
+    ++generation_;
+  }
+  wake_cv_.notify_all();
+
+  in_parallel_region = true;
+  RunChunks(job);
+  in_parallel_region = false;
+
+  std::unique_lock lock(mutex_);
+  done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+void ThreadPool::WorkerLoop(int index, uint64_t seen_generation) {
+  in_parallel_region = true;
+  ppc::util::affinity::PinCurrentThread(ppc::util::affinity::GetThreadCpu(index));
+  while (true) {
+    Job job;
+    {
+      std::unique_lock lock(mutex_);
+      wake_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+      if (stop_) {
+        return;
+      }
+      seen_generation = generation_;
+      job = job_;
+    }
+    RunChunks(job);
+    const std::scoped_lock lock(mutex_);
+    if (--busy_workers_ == 0) {
+      done_cv_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::RunChunks(const Job &job) {
+  const int64_t num_chunks = (job.last - job.first + job.grain - 1) / job.grain;
+  for (int64_t chunk = next_chunk_.fetch_add(1); chunk < num_chunks; chunk = next_chunk_.fetch_add(1)) {
+    const int64_t begin = job.first + (chunk * job.grain);
+    const int64_t end = std::min(job.last, begin + job.grain);
+    try {
+      job.run_chunk(job.context, begin, end, static_cast<std::size_t>(chunk));
+    } catch (...) {
+      const std::scoped_lock lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      // Skip the remaining chunks
+      next_chunk_.store(num_chunks);
+    }
+  }
+}
+
+}  // namespace ppc::util
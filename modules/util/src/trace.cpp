@@ -0,0 +1,353 @@
+#include "util/include/trace.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <libenvpp/detail/get.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/include/comm.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util::trace {
+
+namespace {
+
+constexpr std::size_t kMaxNameLength = 47;
+constexpr std::size_t kBufferCapacity = 4096;
+static_assert((kBufferCapacity & (kBufferCapacity - 1)) == 0, "capacity must be a power of two");
+
+struct Event {
+  std::array<char, kMaxNameLength + 1> name{};
+  const char *category = nullptr;
+  int64_t begin_ns = 0;
+  int64_t end_ns = 0;
+};
+
+// Ring buffer with a single producer (the owning thread) and a single consumer (the collector, serialized
+// by the registry mutex)
+struct ThreadBuffer {
+  uint32_t tid = 0;
+  std::array<Event, kBufferCapacity> events{};
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> tail{0};
+  std::atomic<uint64_t> dropped{0};
+
+  template <typename Func>
+  void Drain(Func &&func) {
+    const uint64_t end = head.load(std::memory_order_acquire);
+    for (uint64_t i = tail.load(std::memory_order_relaxed); i < end; i++) {
+      func(events[i & (kBufferCapacity - 1)]);
+    }
+    tail.store(end, std::memory_order_release);
+  }
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  // Buffers of exited threads, reused by new ones so that short-lived workers do not grow memory
+  std::vector<ThreadBuffer *> free_buffers;
+  // Spans left in the buffers of exited threads
+  std::vector<std::pair<uint32_t, Event>> retired;
+  uint64_t retired_dropped = 0;
+};
+
+Registry &GetRegistry() {
+  // Never destroyed: worker threads may record or exit after static destruction has started
+  static auto *registry = new Registry();  // NOLINT(cppcoreguidelines-owning-memory)
+  return *registry;
+}
+
+// Span durations summed by name while Perf measures; guarded by a mutex since user spans are coarse
+struct SpanTotals {
+  std::atomic<bool> active{false};
+  std::mutex mutex;
+  std::vector<std::pair<std::string, double>> totals;
+};
+
+SpanTotals &GetSpanTotals() {
+  static auto *totals = new SpanTotals();  // NOLINT(cppcoreguidelines-owning-memory)
+  return *totals;
+}
+
+void AddSpanTotal(std::string_view name, int64_t duration_ns) {
+  auto &span_totals = GetSpanTotals();
+  const std::scoped_lock lock(span_totals.mutex);
+  auto &totals = span_totals.totals;
+  auto it = std::ranges::find_if(totals, [&](const auto &entry) { return entry.first == name; });
+  if (it == totals.end()) {
+    totals.emplace_back(std::string(name), 0.0);
+    it = std::prev(totals.end());
+  }
+  it->second += static_cast<double>(duration_ns) * 1e-9;
+}
+
+std::atomic<bool> &EnabledFlag() {
+  static std::atomic<bool> enabled{GetTraceEnabled()};
+  return enabled;
+}
+
+ThreadBuffer *AcquireBuffer() {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  if (!registry.free_buffers.empty()) {
+    ThreadBuffer *buffer = registry.free_buffers.back();
+    registry.free_buffers.pop_back();
+    return buffer;
+  }
+  registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+  registry.buffers.back()->tid = static_cast<uint32_t>(registry.buffers.size() - 1);
+  return registry.buffers.back().get();
+}
+
+void ReleaseBuffer(ThreadBuffer *buffer) {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  buffer->Drain([&](const Event &event) { registry.retired.emplace_back(buffer->tid, event); });
+  registry.retired_dropped += buffer->dropped.exchange(0);
+  registry.free_buffers.push_back(buffer);
+}
+
+struct ThreadHandle {
+  ThreadBuffer *buffer = nullptr;
+  ThreadHandle() = default;
+  ThreadHandle(const ThreadHandle &) = delete;
+  ThreadHandle &operator=(const ThreadHandle &) = delete;
+  ~ThreadHandle() {
+    if (buffer != nullptr) {
+      ReleaseBuffer(buffer);
+    }
+  }
+};
+
+ThreadBuffer &LocalBuffer() {
+  thread_local ThreadHandle handle;
+  if (handle.buffer == nullptr) {
+    handle.buffer = AcquireBuffer();
+  }
+  return *handle.buffer;
+}
+
+void WriteEscaped(std::ostream &out, std::string_view text) {
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ' ';
+    } else {
+      out << c;
+    }
+  }
+}
+
+void WriteEvent(std::ostream &out, const Event &event, int pid, uint32_t tid) {
+  out << R"({"name":")";
+  WriteEscaped(out, event.name.data());
+  out << R"(","cat":")" << event.category << R"(","ph":"X","ts":)" << (static_cast<double>(event.begin_ns) / 1e3)
+      << ",\"dur\":" << (static_cast<double>(event.end_ns - event.begin_ns) / 1e3) << ",\"pid\":" << pid
+      << ",\"tid\":" << tid << '}';
+}
+
+void WriteMetadata(std::ostream &out, const char *kind, int pid, uint32_t tid, const std::string &name,
+                   uint64_t dropped) {
+  out << R"({"name":")" << kind << R"(","ph":"M","pid":)" << pid << ",\"tid\":" << tid << R"(,"args":{"name":")"
+      << name << '"';
+  if (dropped != 0) {
+    out << ",\"dropped\":" << dropped;
+  }
+  out << "}}";
+}
+
+bool IsMpiActive() {
+  int initialized = 0;
+  int finalized = 0;
+  MPI_Initialized(&initialized);
+  MPI_Finalized(&finalized);
+  return initialized != 0 && finalized == 0;
+}
+
+}  // namespace
+
+bool IsEnabled() {
+  return EnabledFlag().load(std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled) {
+  EnabledFlag().store(enabled, std::memory_order_relaxed);
+}
+
+bool IsRecording() {
+  return IsEnabled() || GetSpanTotals().active.load(std::memory_order_relaxed);
+}
+
+void BeginSpanTotals() {
+  auto &span_totals = GetSpanTotals();
+  const std::scoped_lock lock(span_totals.mutex);
+  span_totals.totals.clear();
+  span_totals.active.store(true);
+}
+
+std::vector<std::pair<std::string, double>> EndSpanTotals() {
+  auto &span_totals = GetSpanTotals();
+  const std::scoped_lock lock(span_totals.mutex);
+  span_totals.active.store(false);
+  return std::exchange(span_totals.totals, {});
+}
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void RecordSpan(std::string_view name, const char *category, int64_t begin_ns, int64_t end_ns) {
+  if (GetSpanTotals().active.load(std::memory_order_relaxed) && std::string_view(category) != "task") {
+    AddSpanTotal(name, end_ns - begin_ns);
+  }
+  if (!IsEnabled()) {
+    return;
+  }
+  auto &buffer = LocalBuffer();
+  const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  if (head - buffer.tail.load(std::memory_order_acquire) >= kBufferCapacity) {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Event &event = buffer.events[head & (kBufferCapacity - 1)];
+  const std::size_t length = std::min(name.size(), kMaxNameLength);
+  std::copy_n(name.data(), length, event.name.data());
+  event.name[length] = '\0';
+  event.category = category;
+  event.begin_ns = begin_ns;
+  event.end_ns = end_ns;
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Clear() {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  for (auto &buffer : registry.buffers) {
+    buffer->Drain([](const Event & /*event*/) {});
+    buffer->dropped.store(0);
+  }
+  registry.retired.clear();
+  registry.retired_dropped = 0;
+}
+
+std::string CollectEvents(int pid) {
+  auto &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  std::map<uint32_t, uint64_t> threads;  // tid -> dropped spans
+  auto write = [&](const Event &event, uint32_t tid) {
+    if (out.tellp() > 0) {
+      out << ',';
+    }
+    WriteEvent(out, event, pid, tid);
+    threads.try_emplace(tid, 0);
+  };
+  for (const auto &[tid, event] : registry.retired) {
+    write(event, tid);
+  }
+  registry.retired.clear();
+  for (auto &buffer : registry.buffers) {
+    buffer->Drain([&](const Event &event) { write(event, buffer->tid); });
+    if (const uint64_t dropped = buffer->dropped.exchange(0); dropped != 0) {
+      threads[buffer->tid] += dropped;
+    }
+  }
+  if (out.tellp() == 0) {
+    return {};
+  }
+  threads.begin()->second += std::exchange(registry.retired_dropped, 0);
+  out << ',';
+  WriteMetadata(out, "process_name", pid, 0, "rank " + std::to_string(pid), 0);
+  for (const auto &[tid, dropped] : threads) {
+    out << ',';
+    WriteMetadata(out, "thread_name", pid, tid, "thread " + std::to_string(tid), dropped);
+  }
+  return out.str();
+}
+
+std::string MakeChromeTrace(const std::vector<std::string> &chunks) {
+  std::string trace = R"({"displayTimeUnit":"ms","traceEvents":[)";
+  bool first = true;
+  for (const auto &chunk : chunks) {
+    if (chunk.empty()) {
+      continue;
+    }
+    if (!first) {
+      trace += ',';
+    }
+    trace += chunk;
+    first = false;
+  }
+  trace += "]}\n";
+  return trace;
+}
+
+std::string GatherChromeTrace() {
+  if (!IsMpiActive()) {
+    return MakeChromeTrace({CollectEvents(0)});
+  }
+  MPI_Comm comm = GetTaskComm();
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const std::string local = CollectEvents(rank);
+  const int local_size = static_cast<int>(local.size());
+  std::vector<int> sizes(rank == 0 ? size : 0);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+  std::vector<int> displs(sizes.size(), 0);
+  if (rank == 0) {
+    std::exclusive_scan(sizes.begin(), sizes.end(), displs.begin(), 0);
+  }
+  std::string all(rank == 0 ? static_cast<std::size_t>(displs.back() + sizes.back()) : 0, '\0');
+  MPI_Gatherv(local.data(), local_size, MPI_CHAR, all.data(), sizes.data(), displs.data(), MPI_CHAR, 0, comm);
+  if (rank != 0) {
+    return {};
+  }
+  std::vector<std::string> chunks;
+  chunks.reserve(sizes.size());
+  for (std::size_t i = 0; i < sizes.size(); i++) {
+    chunks.push_back(all.substr(static_cast<std::size_t>(displs[i]), static_cast<std::size_t>(sizes[i])));
+  }
+  return MakeChromeTrace(chunks);
+}
+
+void DumpTestTrace() {
+  if (!IsEnabled()) {
+    return;
+  }
+  const std::string trace = GatherChromeTrace();
+  const auto tmp_dir = env::get<std::string>("PPC_TEST_TMPDIR");
+  if (trace.empty() || !tmp_dir.has_value()) {
+    return;
+  }
+  const std::filesystem::path path = std::filesystem::path(tmp_dir.value()) / "trace.json";
+  std::ofstream file(path);
+  file << trace;
+  std::cerr << "[ TRACE    ] " << path.string() << '\n';
+}
+
+}  // namespace ppc::util::trace
@@ -52,6 +52,34 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+double ppc::util::GetPerfTargetRse() {
+  const auto val = env::get<double>("PPC_PERF_TARGET_RSE");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0.0;
+}
+
+bool ppc::util::GetPerfCountersEnabled() {
+  const auto val = env::get<int>("PPC_PERF_COUNTERS");
+  return val.has_value() && val.value() != 0;
+}
+
+bool ppc::util::GetPerfSweepEnabled() {
+  const auto val = env::get<int>("PPC_PERF_SWEEP");
+  return val.has_value() && val.value() != 0;
+}
+
+std::string ppc::util::GetPerfHistoryPath() {
+  const auto val = env::get<std::string>("PPC_PERF_HISTORY");
+  return val.has_value() ? val.value() : std::string{};
+}
+
+bool ppc::util::GetTraceEnabled() {
+  const auto val = env::get<int>("PPC_TRACE");
+  return val.has_value() && val.value() != 0;
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
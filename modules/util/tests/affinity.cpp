@@ -0,0 +1,92 @@
+#include "util/include/affinity.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Two sockets, one NUMA node each, two cores per socket with two hyperthreads per core
+ppc::util::affinity::Topology MakeDualSocketTopology() {
+  ppc::util::affinity::Topology topology;
+  topology.cpus = {
+      {.id = 0, .core = 0, .package = 0, .node = 0}, {.id = 1, .core = 1, .package = 0, .node = 0},
+      {.id = 2, .core = 0, .package = 1, .node = 1}, {.id = 3, .core = 1, .package = 1, .node = 1},
+      {.id = 4, .core = 0, .package = 0, .node = 0}, {.id = 5, .core = 1, .package = 0, .node = 0},
+      {.id = 6, .core = 0, .package = 1, .node = 1}, {.id = 7, .core = 1, .package = 1, .node = 1},
+  };
+  topology.num_packages = 2;
+  topology.num_nodes = 2;
+  return topology;
+}
+
+}  // namespace
+
+TEST(AffinityTest, ParsesPlacementNames) {
+  using ppc::util::affinity::Placement;
+  EXPECT_EQ(ppc::util::affinity::ParsePlacement("none"), Placement::kNone);
+  EXPECT_EQ(ppc::util::affinity::ParsePlacement("compact"), Placement::kCompact);
+  EXPECT_EQ(ppc::util::affinity::ParsePlacement("scatter"), Placement::kScatter);
+  EXPECT_EQ(ppc::util::affinity::ParsePlacement("numa-local"), Placement::kNumaLocal);
+  EXPECT_EQ(ppc::util::affinity::GetPlacementName(Placement::kNumaLocal), "numa-local");
+  EXPECT_THROW((void)ppc::util::affinity::ParsePlacement("spread"), std::invalid_argument);
+}
+
+TEST(AffinityTest, NonePlacementPlansNothing) {
+  EXPECT_TRUE(
+      ppc::util::affinity::PlanCpus(MakeDualSocketTopology(), ppc::util::affinity::Placement::kNone, 4, 0).empty());
+}
+
+TEST(AffinityTest, CompactKeepsSiblingsTogether) {
+  const auto cpus =
+      ppc::util::affinity::PlanCpus(MakeDualSocketTopology(), ppc::util::affinity::Placement::kCompact, 4, 0);
+  EXPECT_EQ(cpus, (std::vector<int>{0, 4, 1, 5}));
+}
+
+TEST(AffinityTest, ScatterAlternatesSocketsAndPrefersPhysicalCores) {
+  const auto cpus =
+      ppc::util::affinity::PlanCpus(MakeDualSocketTopology(), ppc::util::affinity::Placement::kScatter, 4, 0);
+  EXPECT_EQ(cpus, (std::vector<int>{0, 2, 1, 3}));
+}
+
+TEST(AffinityTest, ProcessesOnOneNodeGetDisjointCpus) {
+  const auto topology = MakeDualSocketTopology();
+  const auto first = ppc::util::affinity::PlanCpus(topology, ppc::util::affinity::Placement::kCompact, 2, 0);
+  const auto second = ppc::util::affinity::PlanCpus(topology, ppc::util::affinity::Placement::kCompact, 2, 1);
+  EXPECT_EQ(first, (std::vector<int>{0, 4}));
+  EXPECT_EQ(second, (std::vector<int>{1, 5}));
+}
+
+TEST(AffinityTest, NumaLocalKeepsProcessOnOneNode) {
+  const auto topology = MakeDualSocketTopology();
+  const auto first = ppc::util::affinity::PlanCpus(topology, ppc::util::affinity::Placement::kNumaLocal, 3, 0);
+  const auto second = ppc::util::affinity::PlanCpus(topology, ppc::util::affinity::Placement::kNumaLocal, 3, 1);
+  EXPECT_EQ(first, (std::vector<int>{0, 1, 4}));
+  EXPECT_EQ(second, (std::vector<int>{2, 3, 6}));
+}
+
+TEST(AffinityTest, ThreadsWrapAroundWhenOversubscribed) {
+  const auto cpus =
+      ppc::util::affinity::PlanCpus(MakeDualSocketTopology(), ppc::util::affinity::Placement::kScatter, 10, 0);
+  ASSERT_EQ(cpus.size(), 10U);
+  EXPECT_EQ(cpus[8], cpus[0]);
+  EXPECT_EQ(cpus[9], cpus[1]);
+}
+
+TEST(AffinityTest, TopologyListsAvailableCpus) {
+  const auto &topology = ppc::util::affinity::GetTopology();
+  EXPECT_FALSE(topology.cpus.empty());
+  EXPECT_GE(topology.num_packages, 1);
+  EXPECT_GE(topology.num_nodes, 1);
+  EXPECT_NE(ppc::util::affinity::Describe(2).find("packages="), std::string::npos);
+}
+
+TEST(AffinityTest, StartPinnedThreadRunsFunction) {
+  std::atomic<int> counter(0);
+  auto thread = ppc::util::affinity::StartPinnedThread(0, [&counter] { counter++; });
+  thread.join();
+  EXPECT_EQ(counter.load(), 1);
+}
@@ -0,0 +1,103 @@
+#include "util/include/bench.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+
+namespace {
+
+// Sums 1..n
+class SumTask : public ppc::task::Task<int, long> {
+ public:
+  explicit SumTask(int in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+  bool ValidationImpl() override {
+    return GetInput() >= 0;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = 0;
+    for (int i = 1; i <= GetInput(); ++i) {
+      GetOutput() += i;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+ppc::util::BenchArgs Parse(std::vector<std::string_view> args) {
+  return ppc::util::ParseBenchArgs(args);
+}
+
+}  // namespace
+
+TEST(BenchTest, ParsesCommandLine) {
+  const auto args = Parse({"--task", "example_threads", "--impl", "omp", "--size", "4096", "--repeat", "3",
+                           "--mode", "pipeline", "--json"});
+  EXPECT_EQ(args.task, "example_threads");
+  EXPECT_EQ(args.type, ppc::task::TypeOfTask::kOMP);
+  EXPECT_EQ(args.options.size, 4096U);
+  EXPECT_EQ(args.options.repeat, 3U);
+  EXPECT_EQ(args.options.mode, ppc::performance::PerfResults::TypeOfRunning::kPipeline);
+  EXPECT_TRUE(args.json);
+  EXPECT_TRUE(Parse({"--list"}).list);
+}
+
+TEST(BenchTest, RejectsInvalidCommandLines) {
+  EXPECT_THROW(Parse({}), std::invalid_argument);
+  EXPECT_THROW(Parse({"--task", "t", "--impl", "cuda"}), std::invalid_argument);
+  EXPECT_THROW(Parse({"--task", "t", "--size", "-5"}), std::invalid_argument);
+  EXPECT_THROW(Parse({"--task", "t", "--repeat", "0"}), std::invalid_argument);
+  EXPECT_THROW(Parse({"--task", "t", "--size"}), std::invalid_argument);
+  EXPECT_THROW(Parse({"--task", "t", "--threads", "4"}), std::invalid_argument);
+}
+
+TEST(BenchTest, RunsRegisteredTaskAtRequestedSize) {
+  ppc::util::RegisterBenchTasks<int, long, SumTask>(
+      "bench_test_sum", {.default_size = 10,
+                         .make = [](std::size_t size) { return static_cast<int>(size); },
+                         .check = [](std::size_t size, const long &output) {
+                           return output == static_cast<long>(size * (size + 1) / 2);
+                         }});
+  const auto *entry = ppc::util::BenchRegistry::Find("bench_test_sum", ppc::task::TypeOfTask::kSEQ);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(ppc::util::BenchRegistry::Find("bench_test_sum", ppc::task::TypeOfTask::kMPI), nullptr);
+
+  const auto result = entry->run({.size = 1000, .repeat = 4});
+  EXPECT_EQ(result.size, 1000U);
+  EXPECT_EQ(result.results.samples.size(), 4U);
+  EXPECT_TRUE(result.correct);
+
+  const std::string line = ppc::util::FormatBenchResult(*entry, {}, result, 1, false);
+  EXPECT_EQ(line.rfind("bench_test_sum_seq:task_run:size=1000:np=1:", 0), 0U) << line;
+  const std::string json = ppc::util::FormatBenchResult(*entry, {}, result, 1, true);
+  EXPECT_NE(json.find(R"("size":1000)"), std::string::npos) << json;
+  EXPECT_NE(json.find(R"("correct":true)"), std::string::npos) << json;
+}
+
+TEST(BenchTest, KeepsWorkExponentForWeakScaling) {
+  ppc::util::RegisterBenchTasks<int, long, SumTask>(
+      "bench_test_work", {.default_size = 10,
+                          .make = [](std::size_t size) { return static_cast<int>(size); },
+                          .check = {},
+                          .work_exponent = 2.0});
+  const auto *entry = ppc::util::BenchRegistry::Find("bench_test_work", ppc::task::TypeOfTask::kSEQ);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_DOUBLE_EQ(entry->work_exponent, 2.0);
+}
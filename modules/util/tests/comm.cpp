@@ -0,0 +1,61 @@
+#include "util/include/comm.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <stdexcept>
+#include <vector>
+
+TEST(CommTest, ParsesGroupSizes) {
+  EXPECT_EQ(ppc::util::ParseCommGroups("2,4,8"), (std::vector<int>{2, 4, 8}));
+  EXPECT_EQ(ppc::util::ParseCommGroups("3"), (std::vector<int>{3}));
+}
+
+TEST(CommTest, RejectsInvalidGroupSizes) {
+  EXPECT_THROW(ppc::util::ParseCommGroups(""), std::invalid_argument);
+  EXPECT_THROW(ppc::util::ParseCommGroups("2,,4"), std::invalid_argument);
+  EXPECT_THROW(ppc::util::ParseCommGroups("2,0"), std::invalid_argument);
+  EXPECT_THROW(ppc::util::ParseCommGroups("2,x"), std::invalid_argument);
+  EXPECT_THROW(ppc::util::ParseCommGroups("4 "), std::invalid_argument);
+}
+
+TEST(CommTest, AssignsConsecutiveRanksToGroups) {
+  const std::vector<int> sizes = {2, 4, 8};
+  std::vector<int> groups;
+  for (int rank = 0; rank < 14; ++rank) {
+    groups.push_back(ppc::util::AssignCommGroup(sizes, rank, 14));
+  }
+  EXPECT_EQ(groups, (std::vector<int>{0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2}));
+}
+
+TEST(CommTest, RejectsGroupsNotCoveringTheWorld) {
+  EXPECT_THROW(ppc::util::AssignCommGroup({2, 2}, 0, 3), std::invalid_argument);
+  EXPECT_THROW(ppc::util::AssignCommGroup({2, 2}, 0, 5), std::invalid_argument);
+}
+
+TEST(CommTest, TaskCommDefaultsToWorld) {
+  EXPECT_EQ(ppc::util::GetTaskComm(), MPI_COMM_WORLD);
+  EXPECT_EQ(ppc::util::GetTaskCommGroup(), -1);
+
+  ppc::util::SetTaskComm(MPI_COMM_SELF, 2);
+  EXPECT_EQ(ppc::util::GetTaskComm(), MPI_COMM_SELF);
+  EXPECT_EQ(ppc::util::GetTaskCommGroup(), 2);
+
+  ppc::util::SetTaskComm(MPI_COMM_WORLD);
+  EXPECT_EQ(ppc::util::GetTaskCommGroup(), -1);
+}
+
+TEST(CommTest, RegisteredTasksRunOnTheTaskComm) {
+  ppc::util::RegisterTaskCommTest("comm_test_task_mpi_enabled");
+
+  EXPECT_TRUE(ppc::util::IsTaskCommTest("Prefix/Suite.Test/comm_test_task_mpi_enabled_case1"));
+  EXPECT_TRUE(ppc::util::IsTaskCommTest("Prefix/Suite.Test/comm_test_task_mpi_enabled"));
+  EXPECT_FALSE(ppc::util::IsTaskCommTest("Prefix/Suite.Test/comm_test_task_mpi_enabled2_case1"));
+  EXPECT_FALSE(ppc::util::IsTaskCommTest("Prefix/Suite.Test/other_comm_test_task_mpi_enabled_case1"));
+  EXPECT_FALSE(ppc::util::IsTaskCommTest("Suite.comm_test_task_mpi_enabled"));
+
+  EXPECT_FALSE(ppc::util::IsWorldCommTest("Prefix/Suite.Test/comm_test_task_mpi_enabled_case1"));
+  EXPECT_TRUE(ppc::util::IsWorldCommTest("Prefix/Suite.Test/comm_test_other_mpi_enabled_case1"));
+  EXPECT_TRUE(ppc::util::IsWorldCommTest("Prefix/Suite.Test/comm_test_other_all_enabled_case1"));
+  EXPECT_FALSE(ppc::util::IsWorldCommTest("Prefix/Suite.Test/comm_test_other_seq_enabled_case1"));
+}
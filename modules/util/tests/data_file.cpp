@@ -0,0 +1,87 @@
+#include "util/include/data_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string TempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+TEST(DataFileTest, MapsTextWithoutCopying) {
+  const std::string path = TempPath("ppc_mapped.txt");
+  std::ofstream(path) << "Hello. World!\n";
+
+  const ppc::util::MappedFile file(path);
+  EXPECT_EQ(file.Text(), "Hello. World!\n");
+  EXPECT_EQ(file.Size(), 14U);
+
+  std::ofstream(path, std::ios::trunc).close();
+  EXPECT_TRUE(ppc::util::MappedFile(path).Empty());
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(ppc::util::MappedFile(TempPath("ppc_missing.txt")), std::runtime_error);
+}
+
+TEST(DataFileTest, ParsesWhitespaceSeparatedNumbers) {
+  EXPECT_EQ(ppc::util::ParseValues<int>(" 1 -2\n+3\r\n\t40 "), (std::vector<int>{1, -2, 3, 40}));
+  EXPECT_EQ(ppc::util::ParseValues<double>("0.5 1e3"), (std::vector<double>{0.5, 1000.0}));
+  EXPECT_TRUE(ppc::util::ParseValues<int>("").empty());
+  EXPECT_THROW((void)ppc::util::ParseValues<int>("1 2x 3"), std::invalid_argument);
+}
+
+TEST(DataFileTest, BinaryFileRoundTripsShapeAndValues) {
+  const std::string path = TempPath("ppc_matrix.bin");
+  const std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  ppc::util::WriteBinaryFile<double>(path, values, {2, 3});
+
+  const ppc::util::BinaryFile file(path);
+  EXPECT_EQ(file.Type(), ppc::util::DataType::kFloat64);
+  EXPECT_EQ(file.Shape(), (std::vector<std::size_t>{2, 3}));
+  EXPECT_TRUE(file.VerifyChecksum());
+  const auto view = file.Values<double>();
+  EXPECT_EQ(std::vector<double>(view.begin(), view.end()), values);
+  EXPECT_THROW((void)file.Values<int>(), std::invalid_argument);
+  std::filesystem::remove(path);
+}
+
+TEST(DataFileTest, LoadValuesReadsTextAndConvertedBinary) {
+  const std::string text_path = TempPath("ppc_values.txt");
+  const std::string binary_path = TempPath("ppc_values.bin");
+  std::ofstream(text_path) << "5 -1 7\n";
+
+  ppc::util::ConvertTextToBinary<int>(text_path, binary_path);
+  EXPECT_EQ(ppc::util::LoadValues<int>(text_path), (std::vector<int>{5, -1, 7}));
+  EXPECT_EQ(ppc::util::LoadValues<int>(binary_path), (std::vector<int>{5, -1, 7}));
+  std::filesystem::remove(text_path);
+  std::filesystem::remove(binary_path);
+}
+
+TEST(DataFileTest, RejectsTruncatedAndCorruptBinaryFiles) {
+  const std::string path = TempPath("ppc_corrupt.bin");
+  const std::vector<int> values = {1, 2, 3, 4};
+  ppc::util::WriteBinaryFile<int>(path, values);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_THROW(ppc::util::BinaryFile{path}, std::runtime_error);
+
+  ppc::util::WriteBinaryFile<int>(path, values);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put('\x7f');
+  }
+  EXPECT_FALSE(ppc::util::BinaryFile(path).VerifyChecksum());
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(ppc::util::WriteBinaryFile<int>(path, values, {3}), std::invalid_argument);
+}
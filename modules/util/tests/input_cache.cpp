@@ -0,0 +1,81 @@
+#include "util/include/input_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+class InputCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ppc::util::InputCache::Clear();
+  }
+
+  void TearDown() override {
+    ppc::util::InputCache::Clear();
+  }
+};
+
+}  // namespace
+
+TEST_F(InputCacheTest, BuildsInputOncePerKey) {
+  int calls = 0;
+  auto make = [&calls] {
+    ++calls;
+    return std::vector<int>(1000, 7);
+  };
+
+  const auto first = ppc::util::InputCache::GetOrCreate<std::vector<int>>("suite/a", make);
+  const auto second = ppc::util::InputCache::GetOrCreate<std::vector<int>>("suite/a", make);
+
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(ppc::util::InputCache::Size(), 1U);
+}
+
+TEST_F(InputCacheTest, KeepsDifferentKeysApart) {
+  const auto small =
+      ppc::util::InputCache::GetOrCreate<std::vector<int>>("suite/10", [] { return std::vector<int>(10); });
+  const auto large =
+      ppc::util::InputCache::GetOrCreate<std::vector<int>>("suite/20", [] { return std::vector<int>(20); });
+
+  EXPECT_EQ(small->size(), 10U);
+  EXPECT_EQ(large->size(), 20U);
+  EXPECT_EQ(ppc::util::InputCache::Size(), 2U);
+}
+
+TEST_F(InputCacheTest, ClearReleasesCacheButNotHeldInputs) {
+  int calls = 0;
+  auto make = [&calls] {
+    ++calls;
+    return std::string("graph");
+  };
+  const auto held = ppc::util::InputCache::GetOrCreate<std::string>("suite", make);
+
+  ppc::util::InputCache::Clear();
+
+  EXPECT_EQ(ppc::util::InputCache::Size(), 0U);
+  EXPECT_EQ(*held, "graph");
+  const auto rebuilt = ppc::util::InputCache::GetOrCreate<std::string>("suite", make);
+  EXPECT_EQ(calls, 2);
+  EXPECT_NE(held.get(), rebuilt.get());
+}
+
+TEST_F(InputCacheTest, ThrowsOnTypeMismatch) {
+  (void)ppc::util::InputCache::GetOrCreate<int>("suite", [] { return 1; });
+
+  EXPECT_THROW((void)ppc::util::InputCache::GetOrCreate<double>("suite", [] { return 1.0; }), std::logic_error);
+}
+
+TEST_F(InputCacheTest, FailedFactoryLeavesNoEntry) {
+  EXPECT_THROW(
+      (void)ppc::util::InputCache::GetOrCreate<int>("suite", []() -> int { throw std::runtime_error("no input"); }),
+      std::runtime_error);
+
+  EXPECT_EQ(ppc::util::InputCache::Size(), 0U);
+  EXPECT_EQ(*ppc::util::InputCache::GetOrCreate<int>("suite", [] { return 3; }), 3);
+}
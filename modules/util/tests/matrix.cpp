@@ -0,0 +1,48 @@
+#include "util/include/matrix.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+TEST(MatrixTest, StoresRowsContiguouslyAndAligned) {
+  ppc::util::Matrix<double> matrix{{1, 2, 3}, {4, 5, 6}};
+  EXPECT_EQ(matrix.Rows(), 2U);
+  EXPECT_EQ(matrix.Cols(), 3U);
+  EXPECT_EQ(matrix(1, 0), 4);
+  EXPECT_EQ(matrix.Row(1).data(), matrix.Data() + 3);
+  EXPECT_EQ(std::vector<double>(matrix.Flat().begin(), matrix.Flat().end()), (std::vector<double>{1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.Data()) % ppc::util::kMatrixAlignment, 0U);
+}
+
+TEST(MatrixTest, ConvertsFromAndToNestedVectors) {
+  const std::vector<std::vector<int>> rows = {{1, 2}, {3, 4}, {5, 6}};
+  const auto matrix = ppc::util::Matrix<int>::FromRows(rows);
+  EXPECT_EQ(matrix, (ppc::util::Matrix<int>{{1, 2}, {3, 4}, {5, 6}}));
+  EXPECT_EQ(matrix.ToRows(), rows);
+}
+
+TEST(MatrixTest, RejectsRaggedRows) {
+  EXPECT_THROW((ppc::util::Matrix<int>{{1, 2}, {3}}), std::invalid_argument);
+  EXPECT_THROW(ppc::util::Matrix<int>::FromRows({{1}, {2, 3}}), std::invalid_argument);
+}
+
+TEST(MatrixTest, ViewsTilesAndColumnsInPlace) {
+  ppc::util::Matrix<int> matrix(3, 4);
+  for (std::size_t i = 0; i < matrix.Size(); ++i) {
+    matrix.Flat()[i] = static_cast<int>(i);
+  }
+
+  const auto tile = matrix.Tile(1, 2, 2, 2);
+  EXPECT_EQ(tile.Stride(), 4U);
+  EXPECT_EQ(tile(0, 0), 6);
+  EXPECT_EQ(tile(1, 1), 11);
+  tile(1, 0) = -1;
+  EXPECT_EQ(matrix(2, 2), -1);
+
+  const auto column = matrix.Column(3);
+  EXPECT_EQ(column.Rows(), 3U);
+  EXPECT_EQ(column(2, 0), 11);
+}
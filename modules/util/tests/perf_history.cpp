@@ -0,0 +1,65 @@
+#include "util/include/perf_history.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+ppc::util::PerfHistoryRecord MakeRecord() {
+  return {.task = "example_processes",
+          .implementation = "mpi",
+          .mode = "pipeline",
+          .test = "example_processes_mpi_enabled_group1_np4",
+          .processes = 4,
+          .threads = 1,
+          .time_sec = 0.5,
+          .samples = {0.25, 0.75}};
+}
+
+}  // namespace
+
+TEST(PerfHistoryTest, FormatsRecordAsJsonLine) {
+  const ppc::util::HostInfo host{.host = "node1", .cpu_model = "cpu", .cpus = 8, .fingerprint = "abc"};
+  const std::string line = ppc::util::FormatHistoryRecord(MakeRecord(), host, "1234abcd", "2025-01-02T03:04:05Z");
+  EXPECT_EQ(line.find('\n'), std::string::npos);
+
+  const auto json = nlohmann::json::parse(line);
+  EXPECT_EQ(json["revision"], "1234abcd");
+  EXPECT_EQ(json["timestamp"], "2025-01-02T03:04:05Z");
+  EXPECT_EQ(json["fingerprint"], "abc");
+  EXPECT_EQ(json["task"], "example_processes");
+  EXPECT_EQ(json["implementation"], "mpi");
+  EXPECT_EQ(json["processes"], 4);
+  EXPECT_EQ(json["samples"].get<std::vector<double>>(), (std::vector<double>{0.25, 0.75}));
+}
+
+TEST(PerfHistoryTest, HostFingerprintIsStable) {
+  const auto first = ppc::util::GetHostInfo();
+  const auto second = ppc::util::GetHostInfo();
+  EXPECT_EQ(first.fingerprint, second.fingerprint);
+  EXPECT_EQ(first.fingerprint.size(), 16U);
+  EXPECT_FALSE(first.host.empty());
+  EXPECT_FALSE(ppc::util::GetBuildRevision().empty());
+}
+
+TEST(PerfHistoryTest, AppendsOneLinePerRecord) {
+  const std::string path = (std::filesystem::temp_directory_path() / "ppc_perf_history.jsonl").string();
+  std::filesystem::remove(path);
+  ppc::util::AppendHistoryRecord(path, MakeRecord());
+  ppc::util::AppendHistoryRecord(path, MakeRecord());
+
+  std::ifstream in(path);
+  std::string line;
+  int lines = 0;
+  while (std::getline(in, line)) {
+    EXPECT_EQ(nlohmann::json::parse(line)["test"], "example_processes_mpi_enabled_group1_np4");
+    lines++;
+  }
+  EXPECT_EQ(lines, 2);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,61 @@
+#include "util/include/shard.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+TEST(ShardTest, MatchesGTestFilters) {
+  EXPECT_TRUE(ppc::util::MatchesTestFilter("Suite.example_mpi_1", "*_mpi_*"));
+  EXPECT_TRUE(ppc::util::MatchesTestFilter("Suite.example_all_1", "*_all_*:*_mpi_*"));
+  EXPECT_FALSE(ppc::util::MatchesTestFilter("Suite.example_omp_1", "*_all_*:*_mpi_*"));
+  EXPECT_TRUE(ppc::util::MatchesTestFilter("Suite.a", ""));
+  EXPECT_TRUE(ppc::util::MatchesTestFilter("Suite.a", "Suite.?"));
+  EXPECT_FALSE(ppc::util::MatchesTestFilter("Suite.a", "*-Suite.a"));
+  EXPECT_FALSE(ppc::util::MatchesTestFilter("Suite.b", "-Suite.a:Suite.b"));
+  EXPECT_TRUE(ppc::util::MatchesTestFilter("Suite.c", "-Suite.a:Suite.b"));
+}
+
+TEST(ShardTest, ExcludesTestsFromFilter) {
+  EXPECT_EQ(ppc::util::ExcludeFromTestFilter("*_mpi_*", {"A.a", "B.b"}), "*_mpi_*-A.a:B.b");
+  EXPECT_EQ(ppc::util::ExcludeFromTestFilter("*-C.c", {"A.a"}), "*-C.c:A.a");
+  EXPECT_EQ(ppc::util::ExcludeFromTestFilter("", {"A.a"}), "*-A.a");
+  EXPECT_EQ(ppc::util::ExcludeFromTestFilter("*_mpi_*", {}), "*_mpi_*");
+
+  const std::string filter = ppc::util::ExcludeFromTestFilter("*_mpi_*", {"A.x_mpi_1"});
+  EXPECT_FALSE(ppc::util::MatchesTestFilter("A.x_mpi_1", filter));
+  EXPECT_TRUE(ppc::util::MatchesTestFilter("A.x_mpi_2", filter));
+}
+
+TEST(ShardTest, MpiTestsNeedTwoProcessesByDefault) {
+  EXPECT_EQ(ppc::util::GetTestMinProcs("Func.example_seq_1"), 1);
+  EXPECT_EQ(ppc::util::GetTestMinProcs("Func.example_mpi_1"), ppc::util::kMpiTestMinProcs);
+  EXPECT_EQ(ppc::util::GetTestMinProcs("Func.example_all_1"), ppc::util::kMpiTestMinProcs);
+
+  ppc::util::RegisterTestMinProcs("ShardRegistered.*_mpi_*", 4);
+  EXPECT_EQ(ppc::util::GetTestMinProcs("ShardRegistered.example_mpi_1"), 4);
+  EXPECT_EQ(ppc::util::GetTestMinProcs("Func.example_mpi_1"), ppc::util::kMpiTestMinProcs);
+}
+
+TEST(ShardTest, BalancesTestsAcrossEligibleGroups) {
+  const std::vector<ppc::util::ShardedTest> tests = {
+      {.name = "a", .min_procs = 1}, {.name = "b", .min_procs = 4}, {.name = "c", .min_procs = 2},
+      {.name = "d", .min_procs = 1}, {.name = "e", .min_procs = 1}, {.name = "f", .min_procs = 1},
+  };
+  const auto groups = ppc::util::AssignTestShards(tests, {4, 2, 1});
+  ASSERT_EQ(groups.size(), tests.size());
+  EXPECT_EQ(groups[1], 0);
+  EXPECT_EQ(groups[2], 1);
+  // Every group ends up with two tests
+  std::vector<int> load(3, 0);
+  for (int group : groups) {
+    ++load[group];
+  }
+  EXPECT_EQ(load, (std::vector<int>{2, 2, 2}));
+  EXPECT_EQ(groups, ppc::util::AssignTestShards(tests, {4, 2, 1}));
+}
+
+TEST(ShardTest, SendsUnsatisfiableTestsToLargestGroup) {
+  const std::vector<ppc::util::ShardedTest> tests = {{.name = "a", .min_procs = 8}};
+  EXPECT_EQ(ppc::util::AssignTestShards(tests, {1, 3, 2}), (std::vector<int>{1}));
+}
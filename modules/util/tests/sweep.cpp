@@ -0,0 +1,46 @@
+#include "util/include/sweep.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+TEST(SweepTest, SizesAreGeometricAndEndAtMax) {
+  EXPECT_EQ(ppc::util::SweepSizes({.min_size = 1000, .max_size = 1000000, .factor = 4.0}),
+            (std::vector<std::size_t>{1000, 4000, 16000, 64000, 256000, 1000000}));
+  EXPECT_EQ(ppc::util::SweepSizes({.min_size = 8, .max_size = 8}), (std::vector<std::size_t>{8}));
+  // Rounding does not repeat sizes
+  EXPECT_EQ(ppc::util::SweepSizes({.min_size = 1, .max_size = 4, .factor = 1.2}),
+            (std::vector<std::size_t>{1, 2, 3, 4}));
+}
+
+TEST(SweepTest, RejectsInvalidRanges) {
+  EXPECT_THROW(ppc::util::SweepSizes({.min_size = 0, .max_size = 10}), std::invalid_argument);
+  EXPECT_THROW(ppc::util::SweepSizes({.min_size = 20, .max_size = 10}), std::invalid_argument);
+  EXPECT_THROW(ppc::util::SweepSizes({.min_size = 1, .max_size = 10, .factor = 1.0}), std::invalid_argument);
+}
+
+TEST(SweepTest, CrossoverIsWhereTheImplementationStaysFaster) {
+  const std::vector<ppc::util::SweepPoint> points = {
+      {.size = 10, .baseline_sec = 1.0, .time_sec = 2.0},
+      {.size = 100, .baseline_sec = 2.0, .time_sec = 1.5},  // noise: slower again at 1000
+      {.size = 1000, .baseline_sec = 3.0, .time_sec = 3.5},
+      {.size = 10000, .baseline_sec = 9.0, .time_sec = 4.0},
+      {.size = 100000, .baseline_sec = 90.0, .time_sec = 20.0},
+  };
+  EXPECT_EQ(ppc::util::FindCrossover(points), std::optional<std::size_t>(10000));
+
+  const std::vector<ppc::util::SweepPoint> never = {{.size = 10, .baseline_sec = 1.0, .time_sec = 2.0},
+                                                    {.size = 100, .baseline_sec = 2.0, .time_sec = 3.0}};
+  EXPECT_EQ(ppc::util::FindCrossover(never), std::nullopt);
+  EXPECT_EQ(ppc::util::FindCrossover({}), std::nullopt);
+}
+
+TEST(SweepTest, FormatsLines) {
+  EXPECT_EQ(ppc::util::FormatSweepPoint("t_mpi_enabled", {.size = 1000, .baseline_sec = 0.003, .time_sec = 0.0012}),
+            "t_mpi_enabled:sweep:size=1000:0.0012000000:seq=0.0030000000:speedup=2.50");
+  EXPECT_EQ(ppc::util::FormatCrossover("t_mpi_enabled", 4000), "t_mpi_enabled:crossover:size=4000");
+  EXPECT_EQ(ppc::util::FormatCrossover("t_mpi_enabled", std::nullopt), "t_mpi_enabled:crossover:none");
+}
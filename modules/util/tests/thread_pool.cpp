@@ -0,0 +1,136 @@
+#include "util/include/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ppc::util::ThreadPool pool(4);
+  std::vector<std::atomic<int>> visits(1000);
+
+  pool.ParallelFor(0, 1000, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      visits[i]++;
+    }
+  });
+
+  for (const auto &count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, GrainControlsChunkSize) {
+  ppc::util::ThreadPool pool(3);
+  std::mutex mutex;
+  std::vector<std::size_t> sizes;
+
+  auto record = [&](std::size_t begin, std::size_t end) {
+    const std::scoped_lock lock(mutex);
+    sizes.push_back(end - begin);
+  };
+
+  pool.ParallelFor(std::size_t{0}, std::size_t{10}, record, std::size_t{4});
+
+  std::ranges::sort(sizes);
+  EXPECT_EQ(sizes, (std::vector<std::size_t>{2, 4, 4}));
+}
+
+TEST(ThreadPoolTest, ParallelReduceCombinesChunksInOrder) {
+  ppc::util::ThreadPool pool(4);
+
+  const auto sum = pool.ParallelReduce(
+      int64_t{1}, int64_t{100001}, int64_t{0},
+      [](int64_t begin, int64_t end, int64_t acc) {
+        for (int64_t i = begin; i < end; ++i) {
+          acc += i;
+        }
+        return acc;
+      },
+      [](int64_t lhs, int64_t rhs) { return lhs + rhs; });
+  EXPECT_EQ(sum, int64_t{5000050000});
+
+  // Chunks are combined left to right, so non-commutative reductions keep the order of the range
+  const auto digits = pool.ParallelReduce(
+      0, 10, std::string{},
+      [](int begin, int end, std::string acc) {
+        for (int i = begin; i < end; ++i) {
+          acc += static_cast<char>('0' + i);
+        }
+        return acc;
+      },
+      [](std::string lhs, const std::string &rhs) { return lhs + rhs; }, 3);
+  EXPECT_EQ(digits, "0123456789");
+}
+
+TEST(ThreadPoolTest, ReusesWorkerThreadsAcrossLoops) {
+  ppc::util::ThreadPool pool(3);
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  auto record = [&](int /*begin*/, int /*end*/) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const std::scoped_lock lock(mutex);
+    ids.insert(std::this_thread::get_id());
+  };
+
+  for (int run = 0; run < 20; ++run) {
+    pool.ParallelFor(0, 30, record, 1);
+  }
+
+  // The caller plus at most two workers, however many loops ran
+  EXPECT_LE(ids.size(), 3U);
+  EXPECT_TRUE(ids.contains(std::this_thread::get_id()));
+}
+
+TEST(ThreadPoolTest, RethrowsExceptionFromBody) {
+  ppc::util::ThreadPool pool(4);
+
+  auto fail_at_50 = [](int begin, int /*end*/) {
+    if (begin == 50) {
+      throw std::runtime_error("chunk failed");
+    }
+  };
+
+  EXPECT_THROW(pool.ParallelFor(0, 100, fail_at_50, 1), std::runtime_error);
+
+  // The pool stays usable after a failed loop
+  std::atomic<int> count(0);
+  pool.ParallelFor(0, 100, [&](int begin, int end) { count += end - begin; });
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST(ThreadPoolTest, NestedLoopsRunInline) {
+  ppc::util::ThreadPool pool(4);
+  std::atomic<int> count(0);
+
+  auto outer = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      pool.ParallelFor(0, 10, [&](int inner_begin, int inner_end) { count += inner_end - inner_begin; });
+    }
+  };
+
+  pool.ParallelFor(0, 8, outer, 1);
+
+  EXPECT_EQ(count.load(), 80);
+}
+
+TEST(ThreadPoolTest, RestartsAfterPause) {
+  ppc::util::ThreadPool pool(2);
+  std::atomic<int> count(0);
+
+  pool.ParallelFor(0, 10, [&](int begin, int end) { count += end - begin; });
+  pool.Pause();
+  pool.Pause();
+  pool.ParallelFor(0, 10, [&](int begin, int end) { count += end - begin; });
+
+  EXPECT_EQ(count.load(), 20);
+}
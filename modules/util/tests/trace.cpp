@@ -0,0 +1,140 @@
+#include "util/include/trace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <latch>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class TraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    was_enabled_ = ppc::util::trace::IsEnabled();
+    ppc::util::trace::Clear();
+    ppc::util::trace::SetEnabled(true);
+  }
+
+  void TearDown() override {
+    ppc::util::trace::SetEnabled(was_enabled_);
+    ppc::util::trace::Clear();
+  }
+
+  static std::vector<nlohmann::json> SpanEvents(const nlohmann::json &trace) {
+    std::vector<nlohmann::json> spans;
+    for (const auto &event : trace["traceEvents"]) {
+      if (event["ph"] == "X") {
+        spans.push_back(event);
+      }
+    }
+    return spans;
+  }
+
+ private:
+  bool was_enabled_ = false;
+};
+
+}  // namespace
+
+TEST_F(TraceTest, DisabledTracingRecordsNothing) {
+  ppc::util::trace::SetEnabled(false);
+  {
+    const ppc::util::trace::ScopedSpan span("ignored");
+  }
+  EXPECT_TRUE(ppc::util::trace::CollectEvents(0).empty());
+}
+
+TEST_F(TraceTest, CollectsSpansOfAllThreadsAsChromeTrace) {
+  {
+    const ppc::util::trace::ScopedSpan span("main \"quoted\"");
+  }
+  constexpr int kWorkers = 3;
+  std::latch all_recorded(kWorkers);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kWorkers; i++) {
+    threads.emplace_back([&all_recorded] {
+      {
+        const ppc::util::trace::ScopedSpan worker_span("worker", "test");
+      }
+      // Keep every worker alive until all of them own a buffer
+      all_recorded.arrive_and_wait();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto trace = nlohmann::json::parse(ppc::util::trace::MakeChromeTrace({ppc::util::trace::CollectEvents(3)}));
+  const auto spans = SpanEvents(trace);
+  ASSERT_EQ(spans.size(), 4U);
+
+  std::set<int> tids;
+  std::size_t workers = 0;
+  for (const auto &span : spans) {
+    EXPECT_EQ(span["pid"], 3);
+    EXPECT_GE(span["dur"].get<double>(), 0.0);
+    tids.insert(span["tid"].get<int>());
+    if (span["name"] == "worker") {
+      EXPECT_EQ(span["cat"], "test");
+      workers++;
+    } else {
+      EXPECT_EQ(span["name"], "main \"quoted\"");
+      EXPECT_EQ(span["cat"], "user");
+    }
+  }
+  EXPECT_EQ(workers, static_cast<std::size_t>(kWorkers));
+  EXPECT_EQ(tids.size(), static_cast<std::size_t>(kWorkers + 1));
+
+  // Collected spans are drained
+  EXPECT_TRUE(ppc::util::trace::CollectEvents(3).empty());
+}
+
+TEST_F(TraceTest, TruncatesLongNames) {
+  const std::string long_name(200, 'a');
+  ppc::util::trace::RecordSpan(long_name, "test", 0, 1000);
+
+  const auto trace = nlohmann::json::parse(ppc::util::trace::MakeChromeTrace({ppc::util::trace::CollectEvents(0)}));
+  const auto spans = SpanEvents(trace);
+  ASSERT_EQ(spans.size(), 1U);
+  const auto name = spans[0]["name"].get<std::string>();
+  EXPECT_LT(name.size(), long_name.size());
+  EXPECT_EQ(name, long_name.substr(0, name.size()));
+  EXPECT_DOUBLE_EQ(spans[0]["dur"].get<double>(), 1.0);
+}
+
+TEST_F(TraceTest, DropsSpansWhenBufferIsFullAndReportsThem) {
+  constexpr int kSpans = 10000;
+  for (int i = 0; i < kSpans; i++) {
+    ppc::util::trace::RecordSpan("span", "test", i, i + 1);
+  }
+
+  const auto trace = nlohmann::json::parse(ppc::util::trace::MakeChromeTrace({ppc::util::trace::CollectEvents(0)}));
+  const auto recorded = SpanEvents(trace).size();
+  EXPECT_LT(recorded, static_cast<std::size_t>(kSpans));
+
+  std::size_t dropped = 0;
+  for (const auto &event : trace["traceEvents"]) {
+    if (event["name"] == "thread_name" && event["args"].contains("dropped")) {
+      dropped += event["args"]["dropped"].get<std::size_t>();
+    }
+  }
+  EXPECT_EQ(recorded + dropped, static_cast<std::size_t>(kSpans));
+}
+
+TEST_F(TraceTest, MergesChunksOfSeveralProcesses) {
+  ppc::util::trace::RecordSpan("rank0", "test", 0, 10);
+  const std::string rank0 = ppc::util::trace::CollectEvents(0);
+  ppc::util::trace::RecordSpan("rank1", "test", 0, 10);
+  const std::string rank1 = ppc::util::trace::CollectEvents(1);
+
+  const auto trace = nlohmann::json::parse(ppc::util::trace::MakeChromeTrace({rank0, "", rank1}));
+  const auto spans = SpanEvents(trace);
+  ASSERT_EQ(spans.size(), 2U);
+  EXPECT_EQ(spans[0]["pid"], 0);
+  EXPECT_EQ(spans[1]["pid"], 1);
+}
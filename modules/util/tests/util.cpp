@@ -124,3 +124,19 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(GetPerfTargetRse, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<double>("PPC_PERF_TARGET_RSE");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_TARGET_RSE");
+  }
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfTargetRse(), 0.0);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_TARGET_RSE", std::to_string(*old));
+  }
+}
+
+TEST(GetPerfTargetRse, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_TARGET_RSE", "0.05");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfTargetRse(), 0.05);
+}
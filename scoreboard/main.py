@@ -1,6 +1,6 @@
 from pathlib import Path
 from collections import defaultdict
-from datetime import datetime
+from datetime import datetime, timedelta, timezone
 import csv
 import argparse
 import subprocess
@@ -282,6 +282,213 @@ def calculate_performance_metrics(perf_val, eff_num_proc, task_type, seq_val=Non
     return acceleration, efficiency
 
 
+def load_perf_history(paths: list[Path]) -> list[dict]:
+    """Load perf history records (JSON lines written by ppc_perf_tests via PPC_PERF_HISTORY)."""
+    records: list[dict] = []
+    for path in paths:
+        if not path.exists():
+            continue
+        with open(path, "r") as f:
+            for line in f:
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    records.append(json.loads(line))
+                except json.JSONDecodeError as e:
+                    logger.warning(
+                        "Skipping malformed perf history record in %s: %s", path, e
+                    )
+    return records
+
+
+def _history_workers(record: dict) -> int:
+    """Number of workers a result ran on: processes, threads, or both for hybrid tasks."""
+    impl = record.get("implementation")
+    processes = int(record.get("processes", 1) or 1)
+    threads = int(record.get("threads", 1) or 1)
+    if impl == "seq":
+        return 1
+    if impl == "mpi":
+        return processes
+    if impl == "all":
+        return processes * threads
+    return threads
+
+
+def _median(values: list[float]) -> float:
+    s = sorted(values)
+    n = len(s)
+    return s[n // 2] if n % 2 else (s[n // 2 - 1] + s[n // 2]) / 2.0
+
+
+def build_perf_trends(records: list[dict], mode: str = "task_run") -> dict:
+    """Build speedup/efficiency series per (task, implementation, workers, host fingerprint).
+
+    Samples of repeated runs of one revision are pooled; speedup is the median
+    time of ``seq`` of the same task, revision and host divided by the median
+    time of the implementation. Every series holds the results of one machine,
+    so that later comparisons never mix hosts. Points are ordered by
+    measurement time.
+    """
+    pooled: dict[tuple, list[float]] = defaultdict(list)
+    stamps: dict[tuple, str] = {}
+    host_names: dict[str, str] = {}
+    for r in records:
+        if r.get("mode") != mode or "task" not in r or "revision" not in r:
+            continue
+        key = (
+            r["task"],
+            r.get("implementation", "?"),
+            _history_workers(r),
+            r["revision"],
+            r.get("fingerprint", ""),
+        )
+        pooled[key].extend(r.get("samples") or [r.get("time_sec", 0.0)])
+        stamps[key] = max(stamps.get(key, ""), r.get("timestamp", ""))
+        host_names[key[4]] = r.get("host") or key[4] or "?"
+
+    seq_times = {
+        (task, rev, host): _median(samples)
+        for (task, impl, _, rev, host), samples in pooled.items()
+        if impl == "seq" and samples
+    }
+    trends: dict[tuple, list[dict]] = defaultdict(list)
+    for (task, impl, workers, rev, host), samples in pooled.items():
+        if impl == "seq" or not samples:
+            continue
+        time_sec = _median(samples)
+        seq_time = seq_times.get((task, rev, host))
+        speedup = seq_time / time_sec if seq_time and time_sec > 0 else None
+        trends[(task, impl, workers, host)].append(
+            {
+                "host": host_names[host],
+                "revision": rev,
+                "timestamp": stamps[(task, impl, workers, rev, host)],
+                "time": time_sec,
+                "speedup": speedup,
+                "efficiency": speedup / workers if speedup is not None else None,
+            }
+        )
+    for points in trends.values():
+        points.sort(key=lambda p: p["timestamp"])
+    return dict(trends)
+
+
+def perf_leaderboards(trends: dict, limit: int = 10) -> dict:
+    """Slowest results and worst efficiencies at the latest measurement of every series."""
+    latest = [
+        {"task": task, "impl": impl, "workers": workers, **points[-1]}
+        for (task, impl, workers, _), points in trends.items()
+        if points
+    ]
+    with_eff = [e for e in latest if e["efficiency"] is not None]
+    return {
+        "slowest": sorted(latest, key=lambda e: -e["time"])[:limit],
+        "worst_efficiency": sorted(with_eff, key=lambda e: e["efficiency"])[:limit],
+    }
+
+
+def perf_regressions(
+    trends: dict, now: datetime, days: int = 7, threshold: float = 0.10
+) -> list[dict]:
+    """Series whose latest time grew by more than threshold over the last days.
+
+    The latest point inside the window is compared with the last point measured
+    before the window started (or the first point inside it). Series are per
+    host, so both points always come from the same machine.
+    """
+    start = (now - timedelta(days=days)).strftime("%Y-%m-%dT%H:%M:%S")
+    found = []
+    for (task, impl, workers, _), points in trends.items():
+        recent = [p for p in points if p["timestamp"] >= start]
+        older = [p for p in points if p["timestamp"] < start]
+        if not recent:
+            continue
+        reference = older[-1] if older else recent[0]
+        latest = recent[-1]
+        if reference is latest or reference["time"] <= 0:
+            continue
+        change = latest["time"] / reference["time"] - 1.0
+        if change > threshold:
+            found.append(
+                {
+                    "task": task,
+                    "impl": impl,
+                    "workers": workers,
+                    "host": latest["host"],
+                    "change": change,
+                    "from_revision": reference["revision"],
+                    "to_revision": latest["revision"],
+                    "time": latest["time"],
+                    "speedup": latest["speedup"],
+                }
+            )
+    return sorted(found, key=lambda r: -r["change"])
+
+
+_CHART_COLORS = ["#2b6cb0", "#c53030", "#2f855a", "#b7791f", "#6b46c1", "#319795"]
+
+
+def perf_trend_charts(trends: dict, width: int = 480, height: int = 200) -> list[dict]:
+    """Precompute SVG polylines of speedup over time, one chart per task.
+
+    Every line is one host; labels name the host when a task was measured on
+    several.
+    """
+    pad = 30
+    by_task: dict[str, dict] = defaultdict(dict)
+    for (task, impl, workers, host), points in trends.items():
+        by_task[task][(impl, workers, host)] = points
+    charts = []
+    for task in sorted(by_task):
+        series = by_task[task]
+        stamps = sorted({p["timestamp"] for pts in series.values() for p in pts})
+        x_of = {
+            ts: pad + (width - 2 * pad) * (i / max(len(stamps) - 1, 1))
+            for i, ts in enumerate(stamps)
+        }
+        speedups = [
+            p["speedup"]
+            for pts in series.values()
+            for p in pts
+            if p["speedup"] is not None
+        ]
+        y_max = max(speedups + [1.0]) * 1.1
+        several_hosts = len({host for _, _, host in series}) > 1
+        lines = []
+        for idx, ((impl, workers, _), pts) in enumerate(sorted(series.items())):
+            coords = [
+                f"{x_of[p['timestamp']]:.1f},"
+                f"{height - pad - (height - 2 * pad) * p['speedup'] / y_max:.1f}"
+                for p in pts
+                if p["speedup"] is not None
+            ]
+            if coords:
+                lines.append(
+                    {
+                        "label": f"{impl} x{workers}"
+                        + (f" @ {pts[-1]['host']}" if several_hosts else ""),
+                        "color": _CHART_COLORS[idx % len(_CHART_COLORS)],
+                        "points": " ".join(coords),
+                    }
+                )
+        if lines:
+            charts.append(
+                {
+                    "task": task,
+                    "width": width,
+                    "height": height,
+                    "pad": pad,
+                    "y_max": y_max,
+                    "first": stamps[0][:10],
+                    "last": stamps[-1][:10],
+                    "lines": lines,
+                }
+            )
+    return charts
+
+
 def _find_max_solution(points_info, task_type: str) -> int:
     """Resolve max S for a given task type from points-info (threads list)."""
     threads_tasks = (points_info.get("threads", {}) or {}).get("tasks", [])
@@ -680,10 +887,11 @@ def _build_rows_for_task_types(
 def main():
     """Main function to generate the scoreboard.
 
-    Now generates three pages in the output dir:
+    Now generates four pages in the output dir:
       - index.html: simple menu linking to threads.html and processes.html
       - threads.html: scoreboard for thread-based tasks
       - processes.html: scoreboard for process-based tasks
+      - performance.html: speedup/efficiency trends from the perf results history
     """
     cfg, eff_num_proc, deadlines_cfg, plagiarism_cfg_local = load_configurations()
 
@@ -1246,6 +1454,13 @@ def main():
     parser.add_argument(
         "-o", "--output", type=str, required=True, help="Output directory path"
     )
+    parser.add_argument(
+        "--perf-history",
+        type=str,
+        nargs="*",
+        help="Perf history JSON lines files (PPC_PERF_HISTORY); "
+        "default: perf_stat_dir/perf_history.jsonl",
+    )
     args = parser.parse_args()
 
     output_path = Path(args.output)
@@ -1332,6 +1547,30 @@ def main():
     with open(output_path / "processes.html", "w") as f:
         f.write(processes_html)
 
+    # ——— Performance trends from the perf results history ——————————————
+    if args.perf_history:
+        history_paths = [Path(p) for p in args.perf_history]
+    else:
+        history_paths = [
+            script_dir.parent / "build" / "perf_stat_dir" / "perf_history.jsonl",
+            script_dir.parent / "perf_stat_dir" / "perf_history.jsonl",
+        ]
+    history = load_perf_history(history_paths)
+    if not history:
+        logger.warning(
+            "No perf history found at %s", ", ".join(map(str, history_paths))
+        )
+    trends = build_perf_trends(history)
+    performance_html = env.get_template("performance.html.j2").render(
+        generated_msk=generated_msk,
+        regressions=perf_regressions(trends, datetime.now(timezone.utc)),
+        leaderboards=perf_leaderboards(trends),
+        charts=perf_trend_charts(trends),
+        num_records=len(history),
+    )
+    with open(output_path / "performance.html", "w") as f:
+        f.write(performance_html)
+
     # ——— Build per-group pages and group menus ————————————————————————
     def _load_group_number(dir_name: str):
         import json
@@ -1496,6 +1735,7 @@ def main():
             "<ul>"
             '<li><a href="threads.html">Threads Scoreboard</a></li>'
             '<li><a href="processes.html">Processes Scoreboard</a></li>'
+            '<li><a href="performance.html">Performance Trends</a></li>'
             "</ul></body></html>"
         )
     else:
@@ -1503,6 +1743,7 @@ def main():
             pages=[
                 {"href": "threads.html", "title": "Threads Scoreboard"},
                 {"href": "processes.html", "title": "Processes Scoreboard"},
+                {"href": "performance.html", "title": "Performance Trends"},
             ],
             groups_threads=threads_groups_menu,
             groups_processes=processes_groups_menu,
@@ -1524,7 +1765,8 @@ def main():
         logger.warning("Static directory not found at %s", static_src)
 
     logger.info(
-        "HTML pages generated at %s (index.html, threads.html, processes.html)",
+        "HTML pages generated at %s (index.html, threads.html, processes.html, "
+        "performance.html)",
         output_path,
     )
 
@@ -0,0 +1,115 @@
+"""
+Tests for the performance trend dashboard built from the perf results history.
+"""
+
+from datetime import datetime, timezone
+
+from main import (
+    build_perf_trends,
+    load_perf_history,
+    perf_leaderboards,
+    perf_regressions,
+    perf_trend_charts,
+)
+
+
+def _record(
+    task, impl, revision, timestamp, samples, processes=1, threads=1, host="node1"
+):
+    return {
+        "task": task,
+        "implementation": impl,
+        "mode": "task_run",
+        "revision": revision,
+        "timestamp": timestamp,
+        "host": host,
+        "fingerprint": f"fp-{host}",
+        "processes": processes,
+        "threads": threads,
+        "time_sec": sum(samples) / len(samples),
+        "samples": samples,
+    }
+
+
+def _history():
+    return [
+        _record("sum", "seq", "r1", "2025-03-01T10:00:00Z", [1.0, 1.0, 1.0]),
+        _record("sum", "omp", "r1", "2025-03-01T10:00:00Z", [0.5, 0.5, 0.6], threads=4),
+        _record("sum", "seq", "r2", "2025-03-09T10:00:00Z", [1.0, 1.0, 1.0]),
+        _record("sum", "omp", "r2", "2025-03-09T10:00:00Z", [1.0, 1.0, 1.0], threads=4),
+        _record("sort", "seq", "r2", "2025-03-09T10:00:00Z", [4.0]),
+        _record("sort", "mpi", "r2", "2025-03-09T10:00:00Z", [1.0], processes=4),
+    ]
+
+
+class TestPerfTrends:
+    def test_speedup_and_efficiency_per_revision(self):
+        trends = build_perf_trends(_history())
+        points = trends[("sum", "omp", 4, "fp-node1")]
+        assert [p["revision"] for p in points] == ["r1", "r2"]
+        assert points[0]["speedup"] == 2.0
+        assert points[0]["efficiency"] == 0.5
+        assert points[1]["speedup"] == 1.0
+        assert points[0]["host"] == "node1"
+        assert trends[("sort", "mpi", 4, "fp-node1")][0]["efficiency"] == 1.0
+        assert ("sum", "seq", 1, "fp-node1") not in trends
+
+    def test_other_modes_are_ignored(self):
+        pipeline = [dict(r, mode="pipeline") for r in _history()]
+        assert build_perf_trends(pipeline) == {}
+
+    def test_leaderboards_use_latest_point(self):
+        boards = perf_leaderboards(build_perf_trends(_history()))
+        assert boards["worst_efficiency"][0]["task"] == "sum"
+        assert boards["worst_efficiency"][0]["efficiency"] == 0.25
+        assert boards["slowest"][0]["time"] == 1.0
+
+    def test_regressions_in_window(self):
+        trends = build_perf_trends(_history())
+        now = datetime(2025, 3, 10, tzinfo=timezone.utc)
+        found = perf_regressions(trends, now, days=7)
+        assert len(found) == 1
+        assert found[0]["task"] == "sum"
+        assert found[0]["from_revision"] == "r1"
+        assert abs(found[0]["change"] - 1.0) < 1e-9
+        # Nothing was measured in the window a month later
+        assert found[0]["host"] == "node1"
+        assert (
+            perf_regressions(trends, datetime(2025, 4, 10, tzinfo=timezone.utc)) == []
+        )
+
+    def test_hosts_are_never_compared(self):
+        # r2 only ran on a slower machine, which is not a regression of node1
+        history = [
+            _record("sum", "seq", "r1", "2025-03-01T10:00:00Z", [1.0]),
+            _record("sum", "omp", "r1", "2025-03-01T10:00:00Z", [0.5], threads=4),
+            _record("sum", "seq", "r2", "2025-03-09T10:00:00Z", [3.0], host="slow"),
+            _record(
+                "sum",
+                "omp",
+                "r2",
+                "2025-03-09T10:00:00Z",
+                [1.5],
+                threads=4,
+                host="slow",
+            ),
+        ]
+        trends = build_perf_trends(history)
+        assert len(trends[("sum", "omp", 4, "fp-node1")]) == 1
+        assert trends[("sum", "omp", 4, "fp-slow")][0]["speedup"] == 2.0
+        now = datetime(2025, 3, 10, tzinfo=timezone.utc)
+        assert perf_regressions(trends, now, days=30) == []
+
+        labels = [line["label"] for line in perf_trend_charts(trends)[0]["lines"]]
+        assert labels == ["omp x4 @ node1", "omp x4 @ slow"]
+
+    def test_charts_per_task(self):
+        charts = perf_trend_charts(build_perf_trends(_history()))
+        assert [c["task"] for c in charts] == ["sort", "sum"]
+        assert charts[1]["lines"][0]["label"] == "omp x4"
+        assert len(charts[1]["lines"][0]["points"].split(" ")) == 2
+
+    def test_load_skips_missing_and_malformed(self, temp_dir):
+        path = temp_dir / "history.jsonl"
+        path.write_text('{"task": "a"}\nnot json\n\n')
+        assert load_perf_history([path, temp_dir / "missing.jsonl"]) == [{"task": "a"}]
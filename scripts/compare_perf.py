@@ -0,0 +1,327 @@
+#!/usr/bin/env python3
+"""Compare two revisions in the performance results history written by ppc_perf_tests.
+
+Records are JSON lines appended to the file named by PPC_PERF_HISTORY. Every
+(task, implementation, mode, processes, threads, host) key measured at both the
+baseline and the candidate revision is compared with a two-sided Mann-Whitney U
+test over the per-run samples (exact for small samples without ties). The
+p-values are corrected for the number of keys (Benjamini-Hochberg by default),
+and a key is only reported as changed if its median moved by more than
+--threshold as well.
+
+With few samples even a clean separation is not significant after the
+correction: for a single change among m keys, n runs per side give at best a
+p-value of 2 / C(2n, n), which must stay below alpha / m. The script prints
+the runs needed when the samples fall short, e.g. 7 per side for 80 keys at
+alpha 0.05, and --fail-on-inconclusive fails on large changes it cannot
+resolve.
+"""
+
+import argparse
+import csv
+import json
+import math
+import sys
+from collections import defaultdict
+
+KEY_FIELDS = ("task", "implementation", "mode", "processes", "threads", "fingerprint")
+
+
+def load_history(paths: list[str]) -> list[dict]:
+    records = []
+    for path in paths:
+        with open(path, encoding="utf-8") as f:
+            for line_no, line in enumerate(f, 1):
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    records.append(json.loads(line))
+                except json.JSONDecodeError as e:
+                    print(
+                        f"{path}:{line_no}: skipping malformed record ({e})",
+                        file=sys.stderr,
+                    )
+    return records
+
+
+def revisions_by_time(records: list[dict]) -> list[str]:
+    """Revisions ordered by their latest measurement."""
+    latest = {}
+    for r in records:
+        latest[r["revision"]] = max(
+            latest.get(r["revision"], ""), r.get("timestamp", "")
+        )
+    return sorted(latest, key=lambda rev: latest[rev])
+
+
+def group_samples(records: list[dict], revision: str, any_host: bool) -> dict:
+    """Pools the samples of repeated runs of one key at one revision."""
+    groups = defaultdict(list)
+    for r in records:
+        if r["revision"] != revision:
+            continue
+        key = tuple(
+            "*" if any_host and f == "fingerprint" else r[f] for f in KEY_FIELDS
+        )
+        groups[key].extend(r.get("samples") or [r["time_sec"]])
+    return groups
+
+
+def median(values: list[float]) -> float:
+    s = sorted(values)
+    n = len(s)
+    return s[n // 2] if n % 2 else (s[n // 2 - 1] + s[n // 2]) / 2.0
+
+
+# Largest sample sizes, n1 + n2, whose U distribution is computed exactly
+EXACT_MAX_SAMPLES = 60
+
+
+def exact_u_counts(n1: int, n2: int) -> list[int]:
+    """Number of orderings of n1 + n2 distinct values per value of U, index u = 0..n1 * n2."""
+    # counts[j][u]: orderings of i values of the first and j of the second sample
+    counts = [[1] for _ in range(n2 + 1)]
+    for i in range(1, n1 + 1):
+        row = [[1]]
+        for j in range(1, n2 + 1):
+            # The largest value comes from the first sample (adding j to U) or from the second
+            take_first = [0] * j + counts[j]
+            take_second = row[j - 1]
+            size = max(len(take_first), len(take_second))
+            row.append(
+                [
+                    (take_first[u] if u < len(take_first) else 0)
+                    + (take_second[u] if u < len(take_second) else 0)
+                    for u in range(size)
+                ]
+            )
+        counts = row
+    return counts[n2]
+
+
+def min_p_value(n1: int, n2: int) -> float:
+    """Smallest two-sided p-value the exact test can reach with n1 and n2 samples."""
+    return min(1.0, 2.0 / math.comb(n1 + n2, n1)) if n1 and n2 else 1.0
+
+
+def runs_needed(keys: int, alpha: float, correction: str) -> int:
+    """Runs per side that let one clean change among keys stay significant after correction."""
+    limit = alpha if correction == "none" else alpha / max(keys, 1)
+    n = 1
+    while min_p_value(n, n) >= limit:
+        n += 1
+    return n
+
+
+def mann_whitney_p(a: list[float], b: list[float]) -> float:
+    """Two-sided p-value of the Mann-Whitney U test.
+
+    Exact for small samples without ties, otherwise the normal approximation
+    with tie correction.
+    """
+    n1, n2 = len(a), len(b)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    if n1 + n2 <= EXACT_MAX_SAMPLES and len(set(a) | set(b)) == n1 + n2:
+        u = sum(1 for x in a for y in b if x > y)
+        counts = exact_u_counts(n1, n2)
+        total = math.comb(n1 + n2, n1)
+        lower = sum(counts[: u + 1]) / total
+        upper = sum(counts[u:]) / total
+        return min(1.0, 2.0 * min(lower, upper))
+    pooled = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        t = j - i + 1
+        tie_term += t**3 - t
+        i = j + 1
+    rank_sum_a = sum(rank for rank, (_, src) in zip(ranks, pooled) if src == 0)
+    u = rank_sum_a - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2.0) - 0.5) / math.sqrt(variance)
+    return min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2.0)))
+
+
+def adjust_p_values(p_values: list[float], method: str) -> list[float]:
+    m = len(p_values)
+    if m == 0 or method == "none":
+        return list(p_values)
+    order = sorted(range(m), key=lambda i: p_values[i])
+    adjusted = [0.0] * m
+    if method == "holm":
+        running = 0.0
+        for rank, i in enumerate(order):
+            running = max(running, min(1.0, (m - rank) * p_values[i]))
+            adjusted[i] = running
+    else:  # Benjamini-Hochberg
+        running = 1.0
+        for rank in range(m - 1, -1, -1):
+            i = order[rank]
+            running = min(running, p_values[i] * m / (rank + 1))
+            adjusted[i] = running
+    return adjusted
+
+
+def compare(
+    baseline: dict, candidate: dict, alpha: float, threshold: float, correction: str
+) -> list[dict]:
+    keys = sorted(set(baseline) & set(candidate))
+    rows = []
+    for key in keys:
+        base, cand = baseline[key], candidate[key]
+        base_median, cand_median = median(base), median(cand)
+        rows.append(
+            dict(zip(KEY_FIELDS, key))
+            | {
+                "n_baseline": len(base),
+                "n_candidate": len(cand),
+                "baseline_median": base_median,
+                "candidate_median": cand_median,
+                "change": cand_median / base_median - 1.0 if base_median > 0 else 0.0,
+                "p_value": mann_whitney_p(base, cand),
+            }
+        )
+    for row, p_adj in zip(
+        rows, adjust_p_values([r["p_value"] for r in rows], correction)
+    ):
+        row["p_adjusted"] = p_adj
+        significant = p_adj < alpha
+        if abs(row["change"]) <= threshold:
+            row["status"] = "unchanged"
+        elif significant:
+            row["status"] = "regression" if row["change"] > 0 else "improvement"
+        else:
+            # Large change without enough samples to be sure, e.g. 5 runs per side
+            row["status"] = "inconclusive"
+    return sorted(rows, key=lambda r: -r["change"])
+
+
+def print_sample_advice(rows: list[dict], alpha: float, correction: str) -> None:
+    """Tells how many runs per side the comparison needs when some keys have fewer."""
+    needed = runs_needed(len(rows), alpha, correction)
+    short = [r for r in rows if min(r["n_baseline"], r["n_candidate"]) < needed]
+    if short:
+        print(
+            f"error: {len(short)} of {len(rows)} results have fewer than {needed} samples per side, "
+            f"which {len(rows)} comparisons need to detect any change at alpha {alpha}; "
+            f"raise num_running or pool repeated launches",
+            file=sys.stderr,
+        )
+
+
+def print_report(rows: list[dict], baseline: str, candidate: str) -> None:
+    print(
+        f"Baseline {baseline} -> candidate {candidate}: {len(rows)} comparable results"
+    )
+    header = f"{'status':<13} {'change':>8} {'p_adj':>9} {'n':>7}  test"
+    print(header)
+    for r in rows:
+        name = f"{r['task']}_{r['implementation']}:{r['mode']} np={r['processes']} threads={r['threads']}"
+        n = f"{r['n_baseline']}/{r['n_candidate']}"
+        print(
+            f"{r['status']:<13} {r['change']:>+8.1%} {r['p_adjusted']:>9.2g} {n:>7}  {name}"
+        )
+    counts = defaultdict(int)
+    for r in rows:
+        counts[r["status"]] += 1
+    print(
+        ", ".join(
+            f"{status}: {counts[status]}"
+            for status in ("regression", "improvement", "inconclusive")
+        )
+    )
+
+
+def write_csv(path: str, rows: list[dict]) -> None:
+    fields = list(KEY_FIELDS) + [
+        "n_baseline",
+        "n_candidate",
+        "baseline_median",
+        "candidate_median",
+        "change",
+        "p_value",
+        "p_adjusted",
+        "status",
+    ]
+    with open(path, "w", newline="", encoding="utf-8") as f:
+        writer = csv.DictWriter(f, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument(
+        "history", nargs="+", help="JSON lines files written via PPC_PERF_HISTORY"
+    )
+    parser.add_argument(
+        "--baseline", help="Baseline revision (default: second latest revision)"
+    )
+    parser.add_argument(
+        "--candidate", help="Candidate revision (default: latest revision)"
+    )
+    parser.add_argument(
+        "--alpha", type=float, default=0.05, help="Significance level after correction"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="Smallest relative change of the median to report",
+    )
+    parser.add_argument("--correction", choices=["bh", "holm", "none"], default="bh")
+    parser.add_argument(
+        "--any-host",
+        action="store_true",
+        help="Compare results measured on different machines as well",
+    )
+    parser.add_argument(
+        "--fail-on-inconclusive",
+        action="store_true",
+        help="Also exit with status 1 on changes above --threshold that are not significant",
+    )
+    parser.add_argument("--csv", help="Also write the comparison to this CSV file")
+    args = parser.parse_args(argv)
+
+    records = load_history(args.history)
+    revisions = revisions_by_time(records)
+    candidate = args.candidate or (revisions[-1] if revisions else None)
+    baseline = args.baseline or next(
+        (rev for rev in reversed(revisions) if rev != candidate), None
+    )
+    if baseline is None or candidate is None:
+        print("Need results of two revisions to compare", file=sys.stderr)
+        return 2
+
+    rows = compare(
+        group_samples(records, baseline, args.any_host),
+        group_samples(records, candidate, args.any_host),
+        args.alpha,
+        args.threshold,
+        args.correction,
+    )
+    print_report(rows, baseline, candidate)
+    print_sample_advice(rows, args.alpha, args.correction)
+    if args.csv:
+        write_csv(args.csv, rows)
+    failing = (
+        {"regression", "inconclusive"} if args.fail_on_inconclusive else {"regression"}
+    )
+    return 1 if any(r["status"] in failing and r["change"] > 0 for r in rows) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,6 +1,8 @@
 import argparse
 import os
 import re
+import sys
+import json
 import xlsxwriter
 import csv
 
@@ -23,6 +25,11 @@ NEW_PATTERN = re.compile(
 SIMPLE_PATTERN = re.compile(
     r"(.+?)_(omp|seq|tbb|stl|all|mpi)_enabled[^:]*:(task_run|pipeline):(-*\d*\.\d*)"
 )
+# Per-stage breakdown printed after the total time, e.g.
+#   example_processes_mpi_enabled:pipeline:stages:Construct=0.01,Validation=0.0,...,scatter=0.2
+STAGES_PATTERN = re.compile(
+    r"(.+?)_(omp|seq|tbb|stl|all|mpi)_enabled[^:]*:(task_run|pipeline):stages:(\S*)"
+)
 
 
 def _ensure_task_tables(result_tables: dict, perf_type: str, task_name: str) -> None:
@@ -113,6 +120,76 @@ def _write_excel_sheet(
         row += 1
 
 
+def _parse_stages(text: str) -> dict:
+    stages = {}
+    for item in filter(None, text.split(",")):
+        name, _, value = item.partition("=")
+        try:
+            stages[name] = float(value)
+        except ValueError:
+            continue
+    return stages
+
+
+def _stage_rows(tasks_list: list[str], cols: list[str], stage_table: dict):
+    for task_name in tasks_list:
+        for ttype in cols:
+            stages = stage_table.get(task_name, {}).get(ttype)
+            # Task names taken from NEW_PATTERN keep the implementation suffix
+            if stages is None and task_name.endswith("_" + ttype):
+                stages = stage_table.get(task_name[: -len(ttype) - 1], {}).get(ttype)
+            if stages is not None:
+                yield task_name, ttype, stages
+
+
+def _stage_columns(
+    tasks_list: list[str], cols: list[str], stage_table: dict
+) -> list[str]:
+    """Stage names in order of first appearance (pipeline stages first, then task spans)."""
+    columns = []
+    for _, _, stages in _stage_rows(tasks_list, cols, stage_table):
+        for name in stages:
+            if name not in columns:
+                columns.append(name)
+    return columns
+
+
+def _write_stages_sheet(
+    workbook, tasks_list: list[str], cols: list[str], stage_table: dict
+):
+    stage_cols = _stage_columns(tasks_list, cols, stage_table)
+    if not stage_cols:
+        return
+    worksheet = workbook.add_worksheet("stages")
+    worksheet.set_column("A:Z", 23)
+    bold = workbook.add_format({"bold": True, "bottom": 2})
+    for col, title in enumerate(["Task", "Type"] + stage_cols):
+        worksheet.write(0, col, title, bold)
+    for row, (task_name, ttype, stages) in enumerate(
+        _stage_rows(tasks_list, cols, stage_table), start=1
+    ):
+        worksheet.write(row, 0, task_name)
+        worksheet.write(row, 1, ttype)
+        for col, name in enumerate(stage_cols, start=2):
+            worksheet.write(row, col, stages.get(name, "—"))
+
+
+def _write_stages_csv(
+    path: str, tasks_list: list[str], cols: list[str], stage_table: dict
+):
+    stage_cols = _stage_columns(tasks_list, cols, stage_table)
+    if not stage_cols:
+        return
+    with open(path, "w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(["Task", "Type"] + stage_cols)
+        for task_name, ttype, stages in _stage_rows(tasks_list, cols, stage_table):
+            writer.writerow(
+                [task_name, ttype.upper()]
+                + [stages.get(name, "?") for name in stage_cols]
+            )
+
+
 def _write_csv(path: str, header: list[str], tasks_list: list[str], table: dict):
     """Write raw times (seconds) to CSV so downstream can derive speedups correctly."""
     with open(path, "w", newline="") as csvfile:
@@ -128,16 +205,240 @@ def _write_csv(path: str, header: list[str], tasks_list: list[str], table: dict)
             writer.writerow(row)
 
 
+# -------------------------------
+# Scaling analysis (run_tests.py --running-type=scaling)
+# -------------------------------
+
+# Largest count whose efficiency still reaches this value is reported as the useful count
+MIN_USEFUL_EFFICIENCY = 0.5
+
+SCALING_COLUMNS = [
+    "Task",
+    "Type",
+    "Scaling",
+    "Count",
+    "Size",
+    "Time",
+    "SEQ",
+    "Speedup",
+    "Efficiency",
+    "KarpFlatt",
+]
+SCALING_FIT_COLUMNS = [
+    "Task",
+    "Type",
+    "Scaling",
+    "SerialFraction",
+    "MaxSpeedup",
+    "MeanKarpFlatt",
+    "UsefulCount",
+]
+
+
+def _karp_flatt(speedup: float, count: int):
+    """Experimentally determined serial fraction e = (1/S - 1/p) / (1 - 1/p); undefined for p = 1."""
+    if count <= 1 or speedup <= 0.0:
+        return None
+    return (1.0 / speedup - 1.0 / count) / (1.0 - 1.0 / count)
+
+
+def _fit_amdahl(points: list[dict]):
+    """Least-squares serial fraction f of S(p) = 1 / (f + (1 - f) / p), i.e. 1/S - 1/p = f * (1 - 1/p)."""
+    xs = [1.0 - 1.0 / pt["count"] for pt in points if pt["speedup"] > 0.0]
+    ys = [
+        1.0 / pt["speedup"] - 1.0 / pt["count"] for pt in points if pt["speedup"] > 0.0
+    ]
+    denominator = sum(x * x for x in xs)
+    if denominator == 0.0:
+        return None
+    return min(max(sum(x * y for x, y in zip(xs, ys)) / denominator, 0.0), 1.0)
+
+
+def _fit_gustafson(points: list[dict]):
+    """Least-squares serial fraction a of the scaled speedup S(p) = p - a * (p - 1)."""
+    xs = [pt["count"] - 1.0 for pt in points]
+    ys = [pt["count"] - pt["speedup"] for pt in points]
+    denominator = sum(x * x for x in xs)
+    if denominator == 0.0:
+        return None
+    return min(max(sum(x * y for x, y in zip(xs, ys)) / denominator, 0.0), 1.0)
+
+
+def _load_scaling(path: str) -> list[dict]:
+    with open(path, "r") as results_file:
+        return [json.loads(line) for line in results_file if line.strip()]
+
+
+def _scaling_series(records: list[dict]) -> dict:
+    """Group runs into {(task, impl, scaling): [points sorted by count]} with speedups against seq.
+
+    The baseline is the seq run of the same task and size; without one the count-1 run of the
+    implementation itself is used.
+    """
+    seq_times = {
+        (r["task"], r["size"]): r["time_sec"] for r in records if r["impl"] == "seq"
+    }
+    series = {}
+    for r in records:
+        if r["impl"] == "seq":
+            continue
+        series.setdefault((r["task"], r["impl"], r["scaling"]), []).append(r)
+
+    result = {}
+    for key, runs in sorted(series.items()):
+        runs.sort(key=lambda r: r["count"])
+        own_base = next((r["time_sec"] for r in runs if r["count"] == 1), None)
+        points = []
+        for r in runs:
+            base = seq_times.get((r["task"], r["size"]), own_base)
+            if base is None or r["time_sec"] <= 0.0:
+                continue
+            speedup = base / r["time_sec"]
+            points.append(
+                {
+                    "count": r["count"],
+                    "size": r["size"],
+                    "time": r["time_sec"],
+                    "seq": base,
+                    "speedup": speedup,
+                    "efficiency": speedup / r["count"],
+                    "karp_flatt": _karp_flatt(speedup, r["count"]),
+                }
+            )
+        if points:
+            result[key] = points
+    return result
+
+
+def _scaling_fit(scaling: str, points: list[dict]) -> dict:
+    serial = _fit_amdahl(points) if scaling == "strong" else _fit_gustafson(points)
+    karp_flatt = [pt["karp_flatt"] for pt in points if pt["karp_flatt"] is not None]
+    useful = [pt["count"] for pt in points if pt["efficiency"] >= MIN_USEFUL_EFFICIENCY]
+    return {
+        "serial": serial,
+        # Amdahl's bound 1/f only applies to a fixed problem size
+        "max_speedup": (1.0 / serial)
+        if scaling == "strong" and serial is not None and serial > 0.0
+        else None,
+        "karp_flatt": sum(karp_flatt) / len(karp_flatt) if karp_flatt else None,
+        "useful_count": max(useful) if useful else None,
+    }
+
+
+def _or_unknown(value):
+    return "?" if value is None else value
+
+
+def _write_scaling_csv(path: str, series: dict):
+    with open(path, "w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(SCALING_COLUMNS)
+        for (task, impl, scaling), points in series.items():
+            for pt in points:
+                writer.writerow(
+                    [task, impl.upper(), scaling, pt["count"], pt["size"], pt["time"]]
+                    + [pt["seq"], pt["speedup"], pt["efficiency"]]
+                    + [_or_unknown(pt["karp_flatt"])]
+                )
+
+
+def _write_scaling_fit_csv(path: str, series: dict):
+    with open(path, "w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(SCALING_FIT_COLUMNS)
+        for (task, impl, scaling), points in series.items():
+            fit = _scaling_fit(scaling, points)
+            writer.writerow(
+                [task, impl.upper(), scaling]
+                + [_or_unknown(fit[k]) for k in ["serial", "max_speedup"]]
+                + [_or_unknown(fit[k]) for k in ["karp_flatt", "useful_count"]]
+            )
+
+
+def _write_scaling_workbook(path: str, series: dict):
+    """Tables of the runs and fits plus one speedup-vs-count chart per task, implementation and mode."""
+    workbook = xlsxwriter.Workbook(path)
+    bold = workbook.add_format({"bold": True, "bottom": 2})
+
+    runs_sheet = workbook.add_worksheet("scaling")
+    runs_sheet.set_column("A:Z", 16)
+    for col, title in enumerate(SCALING_COLUMNS):
+        runs_sheet.write(0, col, title, bold)
+    fit_sheet = workbook.add_worksheet("fit")
+    fit_sheet.set_column("A:Z", 16)
+    for col, title in enumerate(SCALING_FIT_COLUMNS):
+        fit_sheet.write(0, col, title, bold)
+    curves_sheet = workbook.add_worksheet("curves")
+
+    row = 1
+    for index, ((task, impl, scaling), points) in enumerate(series.items()):
+        first_row = row
+        for pt in points:
+            values = [task, impl.upper(), scaling, pt["count"], pt["size"], pt["time"]]
+            values += [pt["seq"], pt["speedup"], pt["efficiency"]]
+            values += [_or_unknown(pt["karp_flatt"])]
+            for col, value in enumerate(values):
+                runs_sheet.write(row, col, value)
+            row += 1
+
+        fit = _scaling_fit(scaling, points)
+        fit_values = [task, impl.upper(), scaling, fit["serial"], fit["max_speedup"]]
+        fit_values += [fit["karp_flatt"], fit["useful_count"]]
+        for col, value in enumerate(fit_values):
+            fit_sheet.write(index + 1, col, _or_unknown(value))
+
+        chart = workbook.add_chart(
+            {"type": "scatter", "subtype": "straight_with_markers"}
+        )
+        counts = ["scaling", first_row, 3, row - 1, 3]
+        chart.add_series(
+            {
+                "name": "speedup",
+                "categories": counts,
+                "values": ["scaling", first_row, 7, row - 1, 7],
+            }
+        )
+        chart.add_series(
+            {
+                "name": "ideal",
+                "categories": counts,
+                "values": counts,
+                "line": {"dash_type": "dash"},
+            }
+        )
+        chart.set_title({"name": f"{task} {impl} ({scaling})"})
+        chart.set_x_axis({"name": "count"})
+        chart.set_y_axis({"name": "speedup"})
+        curves_sheet.insert_chart(index * 16, 0, chart)
+    workbook.close()
+
+
+def _write_scaling_outputs(results_path: str, output_dir: str):
+    series = _scaling_series(_load_scaling(results_path))
+    _write_scaling_csv(os.path.join(output_dir, "scaling.csv"), series)
+    _write_scaling_fit_csv(os.path.join(output_dir, "scaling_fit.csv"), series)
+    _write_scaling_workbook(os.path.join(output_dir, "scaling.xlsx"), series)
+
+
 parser = argparse.ArgumentParser()
+parser.add_argument("-i", "--input", help="Input file path (logs of perf tests, .txt)")
 parser.add_argument(
-    "-i", "--input", help="Input file path (logs of perf tests, .txt)", required=True
+    "-o", "--output", help="Output file path (path to .xlsx table)", required=True
 )
 parser.add_argument(
-    "-o", "--output", help="Output file path (path to .xlsx table)", required=True
+    "--scaling",
+    help="Scaling results of run_tests.py --running-type=scaling (.jsonl); writes scaling.csv, "
+    "scaling_fit.csv and scaling.xlsx",
 )
 args = parser.parse_args()
-logs_path = os.path.abspath(args.input)
+if args.input is None and args.scaling is None:
+    parser.error("at least one of --input and --scaling is required")
 xlsx_path = os.path.abspath(args.output)
+if args.scaling is not None:
+    _write_scaling_outputs(os.path.abspath(args.scaling), xlsx_path)
+if args.input is None:
+    sys.exit(0)
+logs_path = os.path.abspath(args.input)
 
 # For each perf_type (pipeline/task_run) store times per task
 result_tables = {"pipeline": {}, "task_run": {}}
@@ -145,6 +446,8 @@ result_tables = {"pipeline": {}, "task_run": {}}
 task_categories = {}
 # Track tasks per category to split output
 tasks_by_category = {"threads": set(), "processes": set()}
+# perf_type -> task name -> task type -> {stage: seconds}
+stage_tables = {"pipeline": {}, "task_run": {}}
 
 with open(logs_path, "r") as logs_file:
     logs_lines = logs_file.readlines()
@@ -245,6 +548,15 @@ for line in logs_lines:
         tasks_by_category[task_category].add(task_name)
 
 
+for line in logs_lines:
+    stages_result = STAGES_PATTERN.findall(line)
+    if len(stages_result):
+        task_name, task_type, perf_type, stages = stages_result[0]
+        stage_tables.setdefault(perf_type, {}).setdefault(task_name, {})[task_type] = (
+            _parse_stages(stages)
+        )
+
+
 for table_name, table_data in result_tables.items():
     # Prepare two workbooks/CSVs: threads and processes
     for category in ["threads", "processes"]:
@@ -275,6 +587,9 @@ for table_name, table_data in result_tables.items():
         workbook = xlsxwriter.Workbook(wb_path)
         worksheet = workbook.add_worksheet()
         _write_excel_sheet(workbook, worksheet, cpu_num, tasks_list, cols, table_data)
+        _write_stages_sheet(
+            workbook, tasks_list, cols, stage_tables.get(table_name, {})
+        )
         workbook.close()
 
         # CSV
@@ -283,3 +598,9 @@ for table_name, table_data in result_tables.items():
             xlsx_path, f"{category}_" + table_name + "_perf_table.csv"
         )
         _write_csv(csv_path, header, tasks_list, table_data)
+        stages_csv_path = os.path.join(
+            xlsx_path, f"{category}_" + table_name + "_perf_stages.csv"
+        )
+        _write_stages_csv(
+            stages_csv_path, tasks_list, cols, stage_tables.get(table_name, {})
+        )
@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 
+import json
 import os
 import shlex
 import subprocess
@@ -14,7 +15,7 @@ def init_cmd_args():
     parser.add_argument(
         "--running-type",
         required=True,
-        choices=["threads", "processes", "performance"],
+        choices=["threads", "processes", "performance", "scaling"],
         help="Specify the execution mode. Choose 'threads' for multithreading or 'processes' for multiprocessing.",
     )
     parser.add_argument(
@@ -29,6 +30,35 @@ def init_cmd_args():
         type=int,
         help="List of process/thread counts to run sequentially",
     )
+    parser.add_argument(
+        "--scaling",
+        choices=["strong", "weak", "both"],
+        default="both",
+        help="Scaling mode: fixed size (strong), work proportional to the count (weak) or both",
+    )
+    parser.add_argument(
+        "--tasks",
+        nargs="+",
+        help="Tasks to run in scaling mode (default: every task registered with ppc_bench)",
+    )
+    parser.add_argument(
+        "--size",
+        type=int,
+        default=0,
+        help="Base problem size in scaling mode (default: the size registered by each task)",
+    )
+    parser.add_argument(
+        "--repeat", type=int, default=5, help="Measured runs per point in scaling mode"
+    )
+    parser.add_argument(
+        "--scaling-output",
+        help="JSON lines file for scaling results (default: build/perf_stat_dir/scaling.jsonl)",
+    )
+    parser.add_argument(
+        "--mpi-shards",
+        help="Comma-separated MPI group sizes (e.g. 4,2,1,1): in processes mode run the MPI and ALL functional "
+        "tests once on their sum of processes, every group executing its share of the tests",
+    )
     parser.add_argument(
         "--verbose", action="store_true", help="Print commands executed by the script"
     )
@@ -92,12 +122,24 @@ class PPCRunner:
         else:
             self.work_dir = Path(self.__get_project_path()) / "build" / "bin"
 
-    def __run_exec(self, command):
+    def __run_exec(self, command, env=None):
+        if self.verbose:
+            print("Executing:", " ".join(shlex.quote(part) for part in command))
+        env = self.__ppc_env if env is None else env
+        result = subprocess.run(command, shell=False, env=env)
+        if result.returncode != 0:
+            raise Exception(f"Subprocess return {result.returncode}.")
+
+    def __run_capture(self, command, env):
         if self.verbose:
             print("Executing:", " ".join(shlex.quote(part) for part in command))
-        result = subprocess.run(command, shell=False, env=self.__ppc_env)
+        result = subprocess.run(
+            command, shell=False, env=env, stdout=subprocess.PIPE, text=True
+        )
+        print(result.stdout, end="", flush=True)
         if result.returncode != 0:
             raise Exception(f"Subprocess return {result.returncode}.")
+        return result.stdout
 
     def __detect_mpi_impl(self):
         """Detect MPI implementation and return (env_mode, np_flag).
@@ -131,7 +173,8 @@ class PPCRunner:
             return "mpich", "-n"
         return "unknown", "-np"
 
-    def __build_mpi_cmd(self, ppc_num_proc, additional_mpi_args):
+    def __build_mpi_cmd(self, ppc_num_proc, additional_mpi_args, env=None):
+        env = self.__ppc_env if env is None else env
         base = [self.mpi_exec] + shlex.split(additional_mpi_args)
 
         if self.platform == "Windows":
@@ -139,11 +182,13 @@ class PPCRunner:
             env_args = [
                 "-env",
                 "PPC_NUM_THREADS",
-                self.__ppc_env["PPC_NUM_THREADS"],
+                env["PPC_NUM_THREADS"],
                 "-env",
                 "OMP_NUM_THREADS",
-                self.__ppc_env["OMP_NUM_THREADS"],
+                env["OMP_NUM_THREADS"],
             ]
+            if "PPC_MPI_SHARDS" in env:
+                env_args += ["-env", "PPC_MPI_SHARDS", env["PPC_MPI_SHARDS"]]
             np_args = ["-n", ppc_num_proc]
             return base + env_args + np_args
 
@@ -155,17 +200,21 @@ class PPCRunner:
                 "-x",
                 "OMP_NUM_THREADS",
             ]
+            if "PPC_MPI_SHARDS" in env:
+                env_args += ["-x", "PPC_MPI_SHARDS"]
             np_flag = "-np"
         elif self.mpi_env_mode == "mpich":
             # Explicitly set env variables for all ranks
             env_args = [
                 "-env",
                 "PPC_NUM_THREADS",
-                self.__ppc_env["PPC_NUM_THREADS"],
+                env["PPC_NUM_THREADS"],
                 "-env",
                 "OMP_NUM_THREADS",
-                self.__ppc_env["OMP_NUM_THREADS"],
+                env["OMP_NUM_THREADS"],
             ]
+            if "PPC_MPI_SHARDS" in env:
+                env_args += ["-env", "PPC_MPI_SHARDS", env["PPC_MPI_SHARDS"]]
             np_flag = "-n"
         else:
             # Unknown MPI flavor: rely on environment inheritance and default to -np
@@ -213,7 +262,10 @@ class PPCRunner:
             [str(self.work_dir / "core_func_tests")] + self.__get_gtest_settings(1, "*")
         )
 
-    def run_processes(self, additional_mpi_args):
+    def run_processes(self, additional_mpi_args, mpi_shards=None):
+        if mpi_shards:
+            self.__run_processes_sharded(additional_mpi_args, mpi_shards)
+            return
         ppc_num_proc = self.__ppc_env.get("PPC_NUM_PROC")
         if ppc_num_proc is None:
             raise EnvironmentError(
@@ -227,6 +279,32 @@ class PPCRunner:
                     + [str(self.work_dir / "ppc_func_tests")]
                     + self.__get_gtest_settings(1, "_" + task_type + "_")
                 )
+            self.__run_core_processes(mpi_running)
+
+    def __run_core_processes(self, mpi_running):
+        # Core tests named like MPI tasks exercise the collectives of the framework on several processes
+        self.__run_exec(
+            mpi_running
+            + [str(self.work_dir / "core_func_tests")]
+            + self.__get_gtest_settings(1, "_mpi_")
+        )
+
+    def __run_processes_sharded(self, additional_mpi_args, mpi_shards):
+        # One launch for all groups: the runner splits the ranks by PPC_MPI_SHARDS and gives every group its tests
+        sizes = [int(size) for size in mpi_shards.split(",")]
+        env = dict(self.__ppc_env, PPC_MPI_SHARDS=mpi_shards)
+        mpi_running = self.__build_mpi_cmd(str(sum(sizes)), additional_mpi_args, env)
+        if self.__ppc_env.get("PPC_ASAN_RUN"):
+            return
+        self.__run_exec(
+            mpi_running
+            + [str(self.work_dir / "ppc_func_tests")]
+            + self.__get_gtest_settings(1, "_all_*:*_mpi_"),
+            env,
+        )
+        self.__run_core_processes(
+            self.__build_mpi_cmd(str(sum(sizes)), additional_mpi_args)
+        )
 
     def run_performance(self):
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
@@ -245,6 +323,122 @@ class PPCRunner:
                 + self.__get_gtest_settings(1, "_" + task_type + "_")
             )
 
+    def __list_bench_tasks(self):
+        """Return (task, impl, default_size, work_exponent) of every task registered with ppc_bench."""
+        output = self.__run_capture(
+            [str(self.work_dir / "ppc_bench"), "--list"], self.__ppc_env
+        )
+        entries = []
+        for line in output.splitlines():
+            parts = line.split()
+            if len(parts) >= 3 and parts[2].startswith("size="):
+                work = [part for part in parts[3:] if part.startswith("work=")]
+                entries.append(
+                    (
+                        parts[0],
+                        parts[1],
+                        int(parts[2].removeprefix("size=")),
+                        float(work[0].removeprefix("work=")) if work else 1.0,
+                    )
+                )
+        return entries
+
+    @staticmethod
+    def weak_scaling_size(base_size, count, work_exponent):
+        """Return the size that gives count workers the work of one worker at base_size.
+
+        The work of a task grows as size ** work_exponent, e.g. 2 for an n x n matrix.
+        """
+        return max(1, round(base_size * count ** (1.0 / work_exponent)))
+
+    def __run_bench(self, task, impl, size, count, repeat, additional_mpi_args):
+        """Run ppc_bench once and return its JSON record.
+
+        MPI and hybrid implementations scale the process count, threaded ones the thread count.
+        """
+        num_proc = count if impl in ["mpi", "all"] else 1
+        num_threads = count if impl in ["omp", "tbb", "stl"] else 1
+        if impl == "all":
+            num_threads = int(self.__ppc_num_threads)
+        env = dict(self.__ppc_env)
+        env["PPC_NUM_PROC"] = str(num_proc)
+        env["PPC_NUM_THREADS"] = str(num_threads)
+        env["OMP_NUM_THREADS"] = str(num_threads)
+
+        command = [
+            str(self.work_dir / "ppc_bench"),
+            "--task",
+            task,
+            "--impl",
+            impl,
+            "--size",
+            str(size),
+            "--repeat",
+            str(repeat),
+            "--json",
+        ]
+        if impl in ["mpi", "all"]:
+            command = (
+                self.__build_mpi_cmd(str(num_proc), additional_mpi_args, env) + command
+            )
+
+        output = self.__run_capture(command, env)
+        records = [line for line in output.splitlines() if line.startswith("{")]
+        if not records:
+            raise Exception(f"ppc_bench printed no result for {task} {impl}")
+        return json.loads(records[-1])
+
+    def run_scaling(
+        self, counts, scaling, tasks, size, repeat, output, additional_mpi_args
+    ):
+        """Run every selected task over counts with ppc_bench and write one JSON record per run.
+
+        Strong scaling keeps the problem size, weak scaling grows it so that the work, which the task registers
+        as size ** work_exponent, is proportional to the count.
+        Each size is also run with the seq implementation as the speedup baseline.
+        """
+        modes = ["strong", "weak"] if scaling == "both" else [scaling]
+        entries = [
+            entry
+            for entry in self.__list_bench_tasks()
+            if tasks is None or entry[0] in tasks
+        ]
+        registered = {(task, impl) for task, impl, _, _ in entries}
+        baselines = {}
+
+        output.parent.mkdir(parents=True, exist_ok=True)
+        with open(output, "w") as results:
+
+            def write(record, mode, count):
+                record.update({"scaling": mode, "count": count})
+                results.write(json.dumps(record) + "\n")
+                results.flush()
+
+            for task, impl, default_size, work_exponent in entries:
+                if impl == "seq":
+                    continue
+                base_size = size if size > 0 else default_size
+                for mode in modes:
+                    for count in counts:
+                        run_size = (
+                            self.weak_scaling_size(base_size, count, work_exponent)
+                            if mode == "weak"
+                            else base_size
+                        )
+                        baseline_key = (task, run_size)
+                        if (
+                            task,
+                            "seq",
+                        ) in registered and baseline_key not in baselines:
+                            baselines[baseline_key] = self.__run_bench(
+                                task, "seq", run_size, 1, repeat, additional_mpi_args
+                            )
+                            write(dict(baselines[baseline_key]), mode, 1)
+                        record = self.__run_bench(
+                            task, impl, run_size, count, repeat, additional_mpi_args
+                        )
+                        write(record, mode, count)
+
 
 def _execute(args_dict, env):
     runner = PPCRunner(verbose=args_dict.get("verbose", False))
@@ -256,9 +450,27 @@ def _execute(args_dict, env):
     if args_dict["running_type"] == "threads":
         runner.run_threads()
     elif args_dict["running_type"] == "processes":
-        runner.run_processes(args_dict["additional_mpi_args"])
+        runner.run_processes(
+            args_dict["additional_mpi_args"], args_dict.get("mpi_shards")
+        )
     elif args_dict["running_type"] == "performance":
         runner.run_performance()
+    elif args_dict["running_type"] == "scaling":
+        output = args_dict["scaling_output"]
+        runner.run_scaling(
+            args_dict["counts"] or [1],
+            args_dict["scaling"],
+            args_dict["tasks"],
+            args_dict["size"],
+            args_dict["repeat"],
+            Path(output)
+            if output
+            else Path(__file__).resolve().parent.parent
+            / "build"
+            / "perf_stat_dir"
+            / "scaling.jsonl",
+            args_dict["additional_mpi_args"],
+        )
     else:
         raise Exception("running-type is wrong!")
 
@@ -267,7 +479,13 @@ if __name__ == "__main__":
     args_dict = init_cmd_args()
     counts = args_dict.get("counts")
 
-    if counts:
+    if args_dict["running_type"] == "scaling":
+        # Counts are swept inside the scaling run
+        env_copy = os.environ.copy()
+        env_copy.setdefault("PPC_NUM_THREADS", "1")
+        env_copy.setdefault("PPC_NUM_PROC", "1")
+        _execute(args_dict, env_copy)
+    elif counts:
         for count in counts:
             env_copy = os.environ.copy()
 
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "afanasyev_a_elem_vec_avg/common/include/common.hpp"
+#include "util/include/trace.hpp"
 
 namespace afanasyev_a_elem_vec_avg {
 
@@ -55,19 +56,28 @@ bool AfanasyevAElemVecAvgMPI::RunImpl() {
   int local_n = send_counts[rank];
   std::vector<int> local_vec(local_n);
 
-  MPI_Scatterv(rank == 0 ? global_vec.data() : nullptr, send_counts.data(), displs.data(), MPI_INT, local_vec.data(),
-               local_n, MPI_INT, 0, MPI_COMM_WORLD);
+  {
+    const ppc::util::trace::ScopedSpan span("scatter");
+    MPI_Scatterv(rank == 0 ? global_vec.data() : nullptr, send_counts.data(), displs.data(), MPI_INT,
+                 local_vec.data(), local_n, MPI_INT, 0, MPI_COMM_WORLD);
+  }
 
   int64_t local_sum = std::accumulate(local_vec.begin(), local_vec.end(), static_cast<int64_t>(0));
   int64_t global_sum = 0;
 
-  MPI_Reduce(&local_sum, &global_sum, 1, MPI_INT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+  {
+    const ppc::util::trace::ScopedSpan span("reduce");
+    MPI_Reduce(&local_sum, &global_sum, 1, MPI_INT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+  }
 
   if (rank == 0) {
     GetOutput() = static_cast<OutType>(global_sum) / static_cast<double>(global_n);
   }
 
-  MPI_Bcast(static_cast<void *>(&GetOutput()), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  {
+    const ppc::util::trace::ScopedSpan span("bcast");
+    MPI_Bcast(static_cast<void *>(&GetOutput()), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  }
 
   return true;
 }
@@ -3,12 +3,14 @@
 
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <numeric>
 #include <random>
 
 #include "afanasyev_a_elem_vec_avg/common/include/common.hpp"
 #include "afanasyev_a_elem_vec_avg/mpi/include/ops_mpi.hpp"
 #include "afanasyev_a_elem_vec_avg/seq/include/ops_seq.hpp"
+#include "util/include/input_cache.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace afanasyev_a_elem_vec_avg {
@@ -18,12 +20,21 @@ class AfanasyevAElemVecAvgPerfTests : public ppc::util::BaseRunPerfTests<InType,
   static constexpr int kVectorSize = 100000000;
 
  protected:
+  struct TestData {
+    InType input;
+    OutType expected_output = 0.0;
+  };
+
+  // The vector is generated once per suite and shared by the SEQ/MPI pipeline and task_run cases
   void SetUp() override {
-    if constexpr (kVectorSize <= 0) {
-      input_data_ = {};
-      expected_output_ = 0.0;
-    } else {
-      input_data_.resize(kVectorSize);
+    data_ = ppc::util::InputCache::GetOrCreate<TestData>(
+        ::testing::UnitTest::GetInstance()->current_test_suite()->name(), GenerateTestData);
+  }
+
+  static TestData GenerateTestData() {
+    TestData data;
+    if constexpr (kVectorSize > 0) {
+      data.input.resize(kVectorSize);
 
       unsigned int seed = 42;
       int is_mpi_init = 0;
@@ -45,26 +56,26 @@ class AfanasyevAElemVecAvgPerfTests : public ppc::util::BaseRunPerfTests<InType,
       std::uniform_int_distribution<> distrib(-10, 10);
 
       for (int i = 0; i < kVectorSize; ++i) {
-        input_data_[i] = distrib(gen);
+        data.input[i] = distrib(gen);
       }
 
-      int64_t sum = std::accumulate(input_data_.begin(), input_data_.end(), static_cast<int64_t>(0));
-      expected_output_ = static_cast<double>(sum) / kVectorSize;
+      int64_t sum = std::accumulate(data.input.begin(), data.input.end(), static_cast<int64_t>(0));
+      data.expected_output = static_cast<double>(sum) / kVectorSize;
     }
+    return data;
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
     const double tolerance = 1e-5;
-    return std::abs(output_data - expected_output_) < tolerance;
+    return std::abs(output_data - data_->expected_output) < tolerance;
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    return data_->input;
   }
 
  private:
-  InType input_data_;
-  OutType expected_output_ = 0.0;
+  std::shared_ptr<const TestData> data_;
 };
 
 TEST_P(AfanasyevAElemVecAvgPerfTests, RunPerfModes) {
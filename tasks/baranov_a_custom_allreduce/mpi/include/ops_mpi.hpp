@@ -14,6 +14,7 @@ class BaranovACustomAllreduceMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
   explicit BaranovACustomAllreduceMPI(const InType &in);
 
   static void CustomAllreduce(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
@@ -202,8 +202,7 @@ bool BaranovACustomAllreduceMPI::RunImpl() {
         return true;
       }
       auto result_data = std::get<std::vector<int>>(output);
-      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_INT, MPI_SUM, MPI_COMM_WORLD,
-                      0);
+      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_INT, MPI_SUM, GetComm(), 0);
 
       GetOutput() = InTypeVariant{result_data};
     } else if (std::holds_alternative<std::vector<float>>(input)) {
@@ -213,8 +212,7 @@ bool BaranovACustomAllreduceMPI::RunImpl() {
         return true;
       }
       auto result_data = std::get<std::vector<float>>(output);
-      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_FLOAT, MPI_SUM,
-                      MPI_COMM_WORLD, 0);
+      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_FLOAT, MPI_SUM, GetComm(), 0);
       GetOutput() = InTypeVariant{result_data};
     } else if (std::holds_alternative<std::vector<double>>(input)) {
       auto data = std::get<std::vector<double>>(input);
@@ -224,7 +222,7 @@ bool BaranovACustomAllreduceMPI::RunImpl() {
       }
       auto result_data = std::get<std::vector<double>>(output);
       CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_DOUBLE, MPI_SUM,
-                      MPI_COMM_WORLD, 0);
+                      GetComm(), 0);
       GetOutput() = InTypeVariant{result_data};
     }
     return true;
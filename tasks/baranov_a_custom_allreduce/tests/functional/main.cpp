@@ -14,6 +14,7 @@
 #include "baranov_a_custom_allreduce/common/include/common.hpp"
 #include "baranov_a_custom_allreduce/mpi/include/ops_mpi.hpp"
 #include "baranov_a_custom_allreduce/seq/include/ops_seq.hpp"
+#include "util/include/comm.hpp"
 #include "util/include/func_test_util.hpp"
 
 namespace baranov_a_custom_allreduce {
@@ -251,7 +252,7 @@ class BaranovACustomAllreduceFuncTests : public ppc::util::BaseRunFuncTests<InTy
         }
 
         int world_size = 1;
-        MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+        MPI_Comm_size(ppc::util::GetTaskComm(), &world_size);
 
         if (std::holds_alternative<std::vector<int>>(output_data)) {
           return CheckMpiIntOutput(std::get<std::vector<int>>(output_data), world_size);
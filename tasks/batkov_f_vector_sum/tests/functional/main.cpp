@@ -3,14 +3,13 @@
 #include <array>
 #include <cctype>
 #include <cstddef>
-#include <fstream>
-#include <stdexcept>
 #include <string>
 #include <tuple>
 
 #include "batkov_f_vector_sum/common/include/common.hpp"
 #include "batkov_f_vector_sum/mpi/include/ops_mpi.hpp"
 #include "batkov_f_vector_sum/seq/include/ops_seq.hpp"
+#include "util/include/data_file.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -34,18 +33,7 @@ class BatkovFRunFuncTestsProcesses : public ppc::util::BaseRunFuncTests<InType,
     expected_sum_ = std::get<1>(params);
 
     std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_batkov_f_vector_sum, filename);
-    std::ifstream file(abs_path);
-
-    if (!file.is_open()) {
-      throw std::runtime_error("Failed to open file: " + abs_path);
-    }
-
-    int value = 0;
-    while (file >> value) {
-      input_data_.push_back(value);
-    }
-
-    file.close();
+    input_data_ = ppc::util::LoadValues<int>(abs_path);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -1,13 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
-#include <fstream>
-#include <stdexcept>
 #include <string>
 
 #include "batkov_f_vector_sum/common/include/common.hpp"
 #include "batkov_f_vector_sum/mpi/include/ops_mpi.hpp"
 #include "batkov_f_vector_sum/seq/include/ops_seq.hpp"
+#include "util/include/data_file.hpp"
 #include "util/include/perf_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -22,23 +21,12 @@ class BatkovFRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, O
     expected_sum_ = -2609880;
 
     std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_batkov_f_vector_sum, filename);
-    std::ifstream file(abs_path);
-
-    if (!file.is_open()) {
-      throw std::runtime_error("Failed to open file: " + abs_path);
-    }
-
-    int value = 0;
-    while (file >> value) {
-      input_data_.push_back(value);
-    }
+    input_data_ = ppc::util::LoadValues<int>(abs_path);
 
     for (size_t i = 0; i < 7; ++i) {
       input_data_.insert(input_data_.end(), input_data_.begin(), input_data_.end());
     }
     expected_sum_ *= 128;
-
-    file.close();
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
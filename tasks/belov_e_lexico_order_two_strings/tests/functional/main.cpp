@@ -2,17 +2,40 @@
 
 #include <array>
 #include <cstddef>
-#include <fstream>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "belov_e_lexico_order_two_strings/common/include/common.hpp"
 #include "belov_e_lexico_order_two_strings/mpi/include/ops_mpi.hpp"
 #include "belov_e_lexico_order_two_strings/seq/include/ops_seq.hpp"
+#include "task/include/batch_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/comm.hpp"
+#include "util/include/data_file.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
 namespace belov_e_lexico_order_two_strings {
+namespace {
+
+// Each file holds one line "<first>_<second>_<1 if first precedes second>"
+std::tuple<std::string, std::string, bool> ReadTestCase(const TestType &file_name) {
+  std::string path = ppc::util::GetAbsoluteTaskPath(PPC_ID_belov_e_lexico_order_two_strings, file_name);
+  const ppc::util::MappedFile file(path);
+  const std::string_view text = file.Text();
+  const std::string line(text.substr(0, text.find('\n')));
+
+  size_t first_sep = line.find('_');
+  size_t second_sep = line.find('_', first_sep + 1);
+  return {line.substr(0, first_sep), line.substr(first_sep + 1, second_sep - first_sep - 1),
+          line.substr(second_sep + 1) == "1"};
+}
+
+}  // namespace
+
 class BelovERunFuncTestsProcesses : public ppc::util::BaseRunFuncTests<InType, OutType, TestType> {
  public:
   static std::string PrintTestParam(const TestType &test_param) {
@@ -23,18 +46,7 @@ class BelovERunFuncTestsProcesses : public ppc::util::BaseRunFuncTests<InType, O
  protected:
   void SetUp() override {
     TestType params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
-    std::string path = ppc::util::GetAbsoluteTaskPath(PPC_ID_belov_e_lexico_order_two_strings, params);
-    std::ifstream file(path);
-    std::string line;
-    std::getline(file, line);
-
-    size_t first_sep = line.find('_');
-    size_t second_sep = line.find('_', first_sep + 1);
-
-    str1_ = line.substr(0, first_sep);
-    str2_ = line.substr(first_sep + 1, second_sep - first_sep - 1);
-    ans_ = (line.substr(second_sep + 1) == "1");
-    file.close();
+    std::tie(str1_, str2_, ans_) = ReadTestCase(params);
   }
   bool CheckTestOutputData(OutType &output_data) final {
     return output_data == ans_;
@@ -68,5 +80,42 @@ const auto kPerfTestName = BelovERunFuncTestsProcesses::PrintFuncTestName<BelovE
 
 INSTANTIATE_TEST_SUITE_P(LexicoOrderTwoStrings, BelovERunFuncTestsProcesses, kGtestValues, kPerfTestName);
 
+// All files in one batch: whole pairs are spread over the processes and compared by one SEQ task per process
+class BelovELexicoOrderTwoStringsBatch : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(BelovELexicoOrderTwoStringsBatch, ComparesAllFilesInOneBatch) {
+  const auto type =
+      ppc::task::GetStringTaskType(ppc::task::TypeOfTask::kSEQ, PPC_SETTINGS_belov_e_lexico_order_two_strings);
+  if (type.find("disabled") != std::string::npos || GetParam().find("disabled") != std::string::npos) {
+    GTEST_SKIP();
+  }
+  std::vector<InType> inputs;
+  std::vector<OutType> expected;
+  for (const auto &file_name : kTestParam) {
+    auto [first, second, answer] = ReadTestCase(file_name);
+    inputs.emplace_back(std::move(first), std::move(second));
+    expected.push_back(answer);
+  }
+
+  ppc::task::BatchTask<InType, OutType> task(std::move(inputs),
+                                             ppc::task::TaskGetter<BelovELexicoOrderTwoStringsSEQ, InType>);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), expected);
+}
+
+// The batch runs as an MPI task, so it is named like one for the `_mpi_` runs to select it
+const std::string kBatchTestName =
+    std::string(ppc::util::GetNamespace<BelovELexicoOrderTwoStringsSEQ>()) + "_" +
+    ppc::task::GetStringTaskType(ppc::task::TypeOfTask::kMPI, PPC_SETTINGS_belov_e_lexico_order_two_strings) + "_batch";
+
+// BatchTask communicates only on its GetComm(), so the batch may run on a group of processes
+[[maybe_unused]] const bool kBatchUsesTaskComm = ppc::util::RegisterTaskCommTest(kBatchTestName);
+
+INSTANTIATE_TEST_SUITE_P(LexicoOrderTwoStrings, BelovELexicoOrderTwoStringsBatch, ::testing::Values(kBatchTestName),
+                         [](const ::testing::TestParamInfo<std::string> &info) { return info.param; });
+
 }  // namespace
 }  // namespace belov_e_lexico_order_two_strings
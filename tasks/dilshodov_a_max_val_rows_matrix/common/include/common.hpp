@@ -5,10 +5,11 @@
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace dilshodov_a_max_val_rows_matrix {
 
-using InType = std::vector<std::vector<int>>;
+using InType = ppc::util::Matrix<int>;
 using OutType = std::vector<int>;
 using TestType = std::tuple<int, int, std::string>;
 using BaseTask = ppc::task::Task<InType, OutType>;
@@ -9,13 +9,14 @@
 #include <vector>
 
 #include "dilshodov_a_max_val_rows_matrix/common/include/common.hpp"
+#include "mpi/include/datatype.hpp"
+#include "mpi/include/matrix.hpp"
 
 namespace dilshodov_a_max_val_rows_matrix {
 
 MaxValRowsMatrixTaskMPI::MaxValRowsMatrixTaskMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType copy = in;
-  GetInput().swap(copy);
+  GetInput() = in;
 }
 
 bool MaxValRowsMatrixTaskMPI::ValidationImpl() {
@@ -24,17 +25,8 @@ bool MaxValRowsMatrixTaskMPI::ValidationImpl() {
 
   int is_valid = 0;
   if (rank == 0) {
-    const auto &input = GetInput();
-    if (!input.empty() && !input[0].empty()) {
-      std::size_t cols = input[0].size();
-      is_valid = 1;
-      for (const auto &row : input) {
-        if (row.size() != cols) {
-          is_valid = 0;
-          break;
-        }
-      }
-    }
+    // Matrix rows always have equal length
+    is_valid = (GetInput().Rows() > 0 && GetInput().Cols() > 0) ? 1 : 0;
   }
 
   MPI_Bcast(&is_valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
@@ -46,7 +38,7 @@ bool MaxValRowsMatrixTaskMPI::PreProcessingImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   if (rank == 0) {
-    GetOutput().assign(GetInput().size(), std::numeric_limits<int>::min());
+    GetOutput().assign(GetInput().Rows(), std::numeric_limits<int>::min());
   }
   return true;
 }
@@ -60,8 +52,8 @@ bool MaxValRowsMatrixTaskMPI::RunImpl() {
   std::array<int, 2> dims = {0, 0};
   if (rank == 0) {
     const auto &input = GetInput();
-    dims[0] = static_cast<int>(input.size());
-    dims[1] = static_cast<int>(input[0].size());
+    dims[0] = static_cast<int>(input.Rows());
+    dims[1] = static_cast<int>(input.Cols());
   }
   MPI_Bcast(dims.data(), 2, MPI_INT, 0, MPI_COMM_WORLD);
 
@@ -71,50 +63,39 @@ bool MaxValRowsMatrixTaskMPI::RunImpl() {
   int extra_rows = rows % size;
   int local_rows = base_rows + ((rank < extra_rows) ? 1 : 0);
 
-  std::vector<int> local_matrix(static_cast<size_t>(local_rows) * cols);
   std::vector<int> local_max(local_rows);
 
   if (rank == 0) {
-    RunMaster(rows, cols, base_rows, extra_rows, local_rows, local_matrix, local_max);
+    RunMaster(rows, cols, base_rows, extra_rows, local_rows, local_max);
   } else {
-    RunWorker(cols, local_rows, local_matrix, local_max);
+    RunWorker(cols, local_rows, local_max);
   }
 
   return true;
 }
 
 void MaxValRowsMatrixTaskMPI::RunMaster(int rows, int cols, int base_rows, int extra_rows, int local_rows,
-                                        std::vector<int> &local_matrix, std::vector<int> &local_max) {
+                                        std::vector<int> &local_max) {
   int size = 0;
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
   const auto &input = GetInput();
 
-  for (int i = 0; i < local_rows; ++i) {
-    std::ranges::copy(input[i], local_matrix.data() + (static_cast<std::ptrdiff_t>(i) * cols));
-  }
-
+  // Row blocks are contiguous in the matrix, so each one is sent in place without a staging buffer
   std::vector<MPI_Request> send_requests(size - 1);
-  std::vector<std::vector<int>> send_buffers(size - 1);
+  std::vector<ppc::mpi::Datatype> block_types(size - 1);
 
   int row_offset = local_rows;
   for (int proc = 1; proc < size; ++proc) {
     int proc_rows = base_rows + ((proc < extra_rows) ? 1 : 0);
-    send_buffers[proc - 1].resize(static_cast<size_t>(proc_rows) * cols);
-
-    for (int i = 0; i < proc_rows; ++i) {
-      std::ranges::copy(input[row_offset + i], send_buffers[proc - 1].data() + (static_cast<std::ptrdiff_t>(i) * cols));
-    }
-
-    MPI_Isend(send_buffers[proc - 1].data(), proc_rows * cols, MPI_INT, proc, 0, MPI_COMM_WORLD,
-              &send_requests[proc - 1]);
+    const auto block = input.Tile(row_offset, 0, proc_rows, cols);
+    block_types[proc - 1] = ppc::mpi::ViewDatatype(block);
+    MPI_Isend(block.Data(), 1, block_types[proc - 1].Get(), proc, 0, MPI_COMM_WORLD, &send_requests[proc - 1]);
     row_offset += proc_rows;
   }
 
-  const int *row_ptr = local_matrix.data();
   for (int i = 0; i < local_rows; ++i) {
-    local_max[i] = *std::max_element(row_ptr, row_ptr + cols);
-    row_ptr += cols;
+    local_max[i] = std::ranges::max(input.Row(i));
   }
 
   if (size > 1) {
@@ -132,8 +113,8 @@ void MaxValRowsMatrixTaskMPI::RunMaster(int rows, int cols, int base_rows, int e
   }
 }
 
-void MaxValRowsMatrixTaskMPI::RunWorker(int cols, int local_rows, std::vector<int> &local_matrix,
-                                        std::vector<int> &local_max) {
+void MaxValRowsMatrixTaskMPI::RunWorker(int cols, int local_rows, std::vector<int> &local_max) {
+  std::vector<int> local_matrix(static_cast<size_t>(local_rows) * cols);
   MPI_Recv(local_matrix.data(), local_rows * cols, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
 
   const int *row_ptr = local_matrix.data();
@@ -10,34 +10,24 @@ namespace dilshodov_a_max_val_rows_matrix {
 
 MaxValRowsMatrixTaskSequential::MaxValRowsMatrixTaskSequential(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType copy = in;
-  GetInput().swap(copy);
+  GetInput() = in;
 }
 
 bool MaxValRowsMatrixTaskSequential::ValidationImpl() {
-  const auto &input = GetInput();
-  if (input.empty()) {
-    return false;
-  }
-  std::size_t cols = input[0].size();
-  if (cols == 0) {
-    return false;
-  }
-  return std::ranges::all_of(input, [&](const auto &row) { return row.size() == cols; });
+  // Matrix rows always have equal length
+  return GetInput().Rows() > 0 && GetInput().Cols() > 0;
 }
 
 bool MaxValRowsMatrixTaskSequential::PreProcessingImpl() {
-  GetOutput().assign(GetInput().size(), std::numeric_limits<int>::min());
+  GetOutput().assign(GetInput().Rows(), std::numeric_limits<int>::min());
   return true;
 }
 
 bool MaxValRowsMatrixTaskSequential::RunImpl() {
   const auto &input = GetInput();
   auto &output = GetOutput();
-  int rows = static_cast<int>(input.size());
-
-  for (int i = 0; i < rows; ++i) {
-    output[i] = *std::max_element(input[i].begin(), input[i].end());
+  for (std::size_t i = 0; i < input.Rows(); ++i) {
+    output[i] = std::ranges::max(input.Row(i));
   }
 
   return true;
@@ -29,23 +29,20 @@ class DilshodovMaxValRowsMatrixFuncTest : public ppc::util::BaseRunFuncTests<InT
     int rows = std::get<0>(params);
     int cols = std::get<1>(params);
 
-    input_data_.resize(rows);
-    for (int i = 0; i < rows; ++i) {
-      input_data_[i].resize(cols);
-    }
+    input_data_ = InType(rows, cols);
 
     std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<int> dist(-1000, 1000);
 
     for (int i = 0; i < rows; ++i) {
       for (int j = 0; j < cols; ++j) {
-        input_data_[i][j] = dist(gen);
+        input_data_(i, j) = dist(gen);
       }
     }
 
     expected_output_.resize(rows);
     for (int i = 0; i < rows; ++i) {
-      expected_output_[i] = *std::max_element(input_data_[i].begin(), input_data_[i].end());
+      expected_output_[i] = std::ranges::max(input_data_.Row(i));
     }
   }
 
@@ -19,23 +19,20 @@ class DilshodovMaxValRowsMatrixPerfTest : public ppc::util::BaseRunPerfTests<InT
   OutType expected_output_;
 
   void SetUp() override {
-    input_data_.resize(kRows);
-    for (int i = 0; i < kRows; ++i) {
-      input_data_[i].resize(kCols);
-    }
+    input_data_ = InType(kRows, kCols);
 
     std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<int> dist(-10000, 10000);
 
     for (int i = 0; i < kRows; ++i) {
       for (int j = 0; j < kCols; ++j) {
-        input_data_[i][j] = dist(gen);
+        input_data_(i, j) = dist(gen);
       }
     }
 
     expected_output_.resize(kRows);
     for (int i = 0; i < kRows; ++i) {
-      expected_output_[i] = *std::max_element(input_data_[i].begin(), input_data_[i].end());
+      expected_output_[i] = std::ranges::max(input_data_.Row(i));
     }
   }
 
@@ -10,6 +10,7 @@ class NesterovATestTaskMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
   explicit NesterovATestTaskMPI(const InType &in);
 
  private:
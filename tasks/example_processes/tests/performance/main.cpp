@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <utility>
+
 #include "example_processes/common/include/common.hpp"
 #include "example_processes/mpi/include/ops_mpi.hpp"
 #include "example_processes/seq/include/ops_seq.hpp"
+#include "util/include/bench.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace nesterov_a_test_task_processes {
@@ -37,4 +41,17 @@ const auto kPerfTestName = ExampleRunPerfTestProcesses::CustomPerfTestName;
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, ExampleRunPerfTestProcesses, kGtestValues, kPerfTestName);
 
+// ppc_bench --size sets the input value
+const ppc::util::BenchInput<InType, OutType> kBenchInput = {
+    .default_size = 100,
+    .make = [](std::size_t size) { return static_cast<InType>(size); },
+    .check = [](std::size_t size, const OutType &output) { return std::cmp_equal(output, size); },
+    // Three nested loops over n, each step filling a vector of up to 3n elements
+    .work_exponent = 4.0,
+};
+
+[[maybe_unused]] const bool kBenchRegistered =
+    ppc::util::RegisterBenchTasks<InType, OutType, NesterovATestTaskMPI, NesterovATestTaskSEQ>(PPC_ID_example_processes,
+                                                                                               kBenchInput);
+
 }  // namespace nesterov_a_test_task_processes
@@ -45,7 +45,7 @@ bool NesterovATestTaskMPI::RunImpl() {
   GetOutput() *= num_threads;
 
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetComm(), &rank);
 
   if (rank == 0) {
     GetOutput() /= num_threads;
@@ -60,7 +60,7 @@ bool NesterovATestTaskMPI::RunImpl() {
     }
   }
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(GetComm());
   return GetOutput() > 0;
 }
 
@@ -10,6 +10,7 @@ class NesterovATestTaskALL : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kALL;
   }
+  static constexpr bool kUsesTaskComm = true;
   explicit NesterovATestTaskALL(const InType &in);
 
  private:
@@ -44,7 +44,7 @@ bool NesterovATestTaskALL::RunImpl() {
     GetOutput() *= num_threads;
 
     int rank = -1;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_rank(GetComm(), &rank);
     if (rank == 0) {
       std::atomic<int> counter(0);
 #pragma omp parallel default(none) shared(counter) num_threads(ppc::util::GetNumThreads())
@@ -73,7 +73,7 @@ bool NesterovATestTaskALL::RunImpl() {
     tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) { counter++; });
     GetOutput() /= counter;
   }
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(GetComm());
   return GetOutput() > 0;
 }
 
@@ -1,12 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <utility>
+
 #include "example_threads/all/include/ops_all.hpp"
 #include "example_threads/common/include/common.hpp"
 #include "example_threads/omp/include/ops_omp.hpp"
 #include "example_threads/seq/include/ops_seq.hpp"
 #include "example_threads/stl/include/ops_stl.hpp"
 #include "example_threads/tbb/include/ops_tbb.hpp"
+#include "util/include/bench.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/sweep.hpp"
 
 namespace nesterov_a_test_task_threads {
 
@@ -41,4 +46,43 @@ const auto kPerfTestName = ExampleRunPerfTestThreads::CustomPerfTestName;
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, ExampleRunPerfTestThreads, kGtestValues, kPerfTestName);
 
+// O(n^4) work from n = 16 up to four times the perf test size, to find where each threaded version overtakes SEQ
+class ExampleRunSweepPerfTestThreads : public ppc::util::BaseRunSweepPerfTests<InType, OutType> {
+  ppc::util::SizeSweep GetSizeSweep() final {
+    return {.min_size = 16, .max_size = 800, .factor = 2.0};
+  }
+
+  InType GetSweepInput(std::size_t size) final {
+    return static_cast<InType>(size);
+  }
+
+  bool CheckSweepOutput(std::size_t size, OutType &output_data) final {
+    return std::cmp_equal(output_data, size);
+  }
+};
+
+TEST_P(ExampleRunSweepPerfTestThreads, RunSizeSweep) {
+  ExecuteSweep(GetParam());
+}
+
+const auto kSweepPerfTasks =
+    ppc::util::MakeSweepPerfTasks<InType, NesterovATestTaskSEQ, NesterovATestTaskALL, NesterovATestTaskOMP,
+                                  NesterovATestTaskSTL, NesterovATestTaskTBB>(PPC_SETTINGS_example_threads);
+
+INSTANTIATE_TEST_SUITE_P(SizeSweepTests, ExampleRunSweepPerfTestThreads, ppc::util::TupleToGTestValues(kSweepPerfTasks),
+                         ExampleRunSweepPerfTestThreads::CustomSweepTestName);
+
+// ppc_bench --size sets the input value
+const ppc::util::BenchInput<InType, OutType> kBenchInput = {
+    .default_size = 200,
+    .make = [](std::size_t size) { return static_cast<InType>(size); },
+    .check = [](std::size_t size, const OutType &output) { return std::cmp_equal(output, size); },
+    // Three nested loops over n, each step filling a vector of up to 3n elements
+    .work_exponent = 4.0,
+};
+
+[[maybe_unused]] const bool kBenchRegistered =
+    ppc::util::RegisterBenchTasks<InType, OutType, NesterovATestTaskALL, NesterovATestTaskOMP, NesterovATestTaskSEQ,
+                                  NesterovATestTaskSTL, NesterovATestTaskTBB>(PPC_ID_example_threads, kBenchInput);
+
 }  // namespace nesterov_a_test_task_threads
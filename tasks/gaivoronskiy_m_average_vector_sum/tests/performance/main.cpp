@@ -110,13 +110,10 @@ namespace {
 
 template <typename TaskType>
 auto MakePerfTaskTuplesForSize(std::size_t size, const std::string &settings_path) {
-  const auto base_name = std::string(ppc::util::GetNamespace<TaskType>()) + "_" +
-                         ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
-  const auto size_suffix = "_size" + std::to_string(size);
-  const auto task_name = base_name + size_suffix;
-  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InType>, task_name,
+  const auto task_name = ppc::task::GetTaskTestName<TaskType>(settings_path) + "_size" + std::to_string(size);
+  return std::make_tuple(std::make_tuple(ppc::util::PerfTaskGetter<TaskType, InType>, task_name,
                                          ppc::performance::PerfResults::TypeOfRunning::kPipeline),
-                         std::make_tuple(ppc::task::TaskGetter<TaskType, InType>, task_name,
+                         std::make_tuple(ppc::util::PerfTaskGetter<TaskType, InType>, task_name,
                                          ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
 }
 
@@ -3,14 +3,17 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
-#include <memory>
 #include <numbers>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "galkin_d_trapezoid_method/common/include/common.hpp"
 #include "galkin_d_trapezoid_method/mpi/include/ops_mpi.hpp"
 #include "galkin_d_trapezoid_method/seq/include/ops_seq.hpp"
+#include "task/include/batch_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/comm.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -88,45 +91,65 @@ const auto kFunctionalTestName = GalkinDTrapezoidFuncTests::PrintFuncTestName<Ga
 
 INSTANTIATE_TEST_SUITE_P(TrapezoidIntegralSuite, GalkinDTrapezoidFuncTests, kParameterizedValues, kFunctionalTestName);
 
-template <typename TaskType>
-void ExpectFullPipelineSuccess(const InType &in, double eps = 1e-4) {
-  auto task = std::make_shared<TaskType>(in);
-  ASSERT_TRUE(task->Validation());
-  ASSERT_TRUE(task->PreProcessing());
-  ASSERT_TRUE(task->Run());
-  ASSERT_TRUE(task->PostProcessing());
-
-  const double exact = GetExactIntegral(in);
-  ASSERT_NEAR(task->GetOutput(), exact, eps);
-}
-
-TEST(GalkinDTrapezoidStandalone, SeqPipelineStandardCases) {
-  const std::array<InType, 3> k_inputs = {
+// Small integrals run as one batch instead of one task each
+std::vector<InType> MakeStandardCases() {
+  return {
       InType{.a = 0.0, .b = 1.0, .n = 1000, .func_id = static_cast<int>(FunctionId::kLinear)},
       InType{.a = 0.0, .b = 2.0, .n = 2000, .func_id = static_cast<int>(FunctionId::kQuadratic)},
       InType{.a = 0.0, .b = kPi, .n = 4000, .func_id = static_cast<int>(FunctionId::kSin)},
+      InType{.a = -1.0, .b = 1.0, .n = 1500, .func_id = static_cast<int>(FunctionId::kLinear)},
+      InType{.a = 0.0, .b = kPi / 2.0, .n = 2500, .func_id = static_cast<int>(FunctionId::kSin)},
   };
+}
 
-  for (const auto &in : k_inputs) {
-    ExpectFullPipelineSuccess<GalkinDTrapezoidMethodSEQ>(in);
+void ExpectBatchSuccess(const ppc::task::ItemTaskFactory<InType, OutType> &make_item, ppc::task::BatchMode mode,
+                        double eps = 1e-4) {
+  const auto inputs = MakeStandardCases();
+  ppc::task::BatchTask<InType, OutType> task(inputs, make_item, mode);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  ASSERT_EQ(task.GetOutput().size(), inputs.size());
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    ASSERT_NEAR(task.GetOutput()[i], GetExactIntegral(inputs[i]), eps);
   }
 }
 
+TEST(GalkinDTrapezoidStandalone, SeqPipelineStandardCases) {
+  ExpectBatchSuccess(ppc::task::TaskGetter<GalkinDTrapezoidMethodSEQ, InType>, ppc::task::BatchMode::kSequential);
+}
+
+// Every process runs every case, so one MPI task instance splits each integral in turn
 TEST(GalkinDTrapezoidStandalone, MpiPipelineStandardCases) {
   if (!ppc::util::IsUnderMpirun()) {
     GTEST_SKIP();
   }
-  const std::array<InType, 3> k_inputs = {
-      InType{.a = 0.0, .b = 1.0, .n = 1000, .func_id = static_cast<int>(FunctionId::kLinear)},
-      InType{.a = 0.0, .b = 2.0, .n = 2000, .func_id = static_cast<int>(FunctionId::kQuadratic)},
-      InType{.a = 0.0, .b = kPi, .n = 4000, .func_id = static_cast<int>(FunctionId::kSin)},
-  };
+  ExpectBatchSuccess(ppc::task::TaskGetter<GalkinDTrapezoidMethodMPI, InType>, ppc::task::BatchMode::kSequential);
+}
+
+// Whole integrals are spread over the processes and computed by one SEQ task per process
+class GalkinDTrapezoidBatch : public ::testing::TestWithParam<std::string> {};
 
-  for (const auto &in : k_inputs) {
-    ExpectFullPipelineSuccess<GalkinDTrapezoidMethodMPI>(in);
+TEST_P(GalkinDTrapezoidBatch, ComputesStandardCasesInOneBatch) {
+  const auto type = ppc::task::GetStringTaskType(ppc::task::TypeOfTask::kSEQ, PPC_SETTINGS_galkin_d_trapezoid_method);
+  if (type.find("disabled") != std::string::npos || GetParam().find("disabled") != std::string::npos) {
+    GTEST_SKIP();
   }
+  ExpectBatchSuccess(ppc::task::TaskGetter<GalkinDTrapezoidMethodSEQ, InType>, ppc::task::BatchMode::kDistributed);
 }
 
+// The batch runs as an MPI task, so it is named like one for the `_mpi_` runs to select it
+const std::string kBatchTestName =
+    std::string(ppc::util::GetNamespace<GalkinDTrapezoidMethodSEQ>()) + "_" +
+    ppc::task::GetStringTaskType(ppc::task::TypeOfTask::kMPI, PPC_SETTINGS_galkin_d_trapezoid_method) + "_batch";
+
+// BatchTask communicates only on its GetComm(), so the batch may run on a group of processes
+[[maybe_unused]] const bool kBatchUsesTaskComm = ppc::util::RegisterTaskCommTest(kBatchTestName);
+
+INSTANTIATE_TEST_SUITE_P(TrapezoidIntegralSuite, GalkinDTrapezoidBatch, ::testing::Values(kBatchTestName),
+                         [](const ::testing::TestParamInfo<std::string> &info) { return info.param; });
+
 TEST(GalkinDTrapezoidValidation, RejectsNonPositiveNSeq) {
   InType in{.a = 0.0, .b = 1.0, .n = 0, .func_id = static_cast<int>(FunctionId::kLinear)};
   GalkinDTrapezoidMethodSEQ task(in);
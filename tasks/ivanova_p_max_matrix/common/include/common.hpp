@@ -2,13 +2,13 @@
 
 #include <string>
 #include <tuple>
-#include <vector>  // Добавлено для std::vector
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace ivanova_p_max_matrix {
 
-using InType = std::vector<std::vector<int>>;
+using InType = ppc::util::Matrix<int>;
 using OutType = int;
 using TestType = std::tuple<int, std::string>;
 using BaseTask = ppc::task::Task<InType, OutType>;
@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <limits>
 #include <random>
-#include <vector>
 
 #include "ivanova_p_max_matrix/common/include/common.hpp"
 
@@ -12,7 +11,7 @@ namespace ivanova_p_max_matrix::data {  // Объединенные namespace
 class MatrixGenerator {
  public:
   static InType GenerateMatrixWithKnownMax(int rows, int cols) {
-    InType matrix(rows, std::vector<int>(cols));
+    InType matrix(rows, cols);
     std::random_device rd;
     std::mt19937 gen(rd());
 
@@ -25,7 +24,7 @@ class MatrixGenerator {
 
     for (int i = 0; i < rows; ++i) {
       for (int j = 0; j < cols; ++j) {
-        matrix[i][j] = dist(gen);
+        matrix(i, j) = dist(gen);
       }
     }
 
@@ -35,13 +34,13 @@ class MatrixGenerator {
     std::uniform_int_distribution<int> col_dist(0, cols - 1);
     int max_i = row_dist(gen);
     int max_j = col_dist(gen);
-    matrix[max_i][max_j] = max_val;
+    matrix(max_i, max_j) = max_val;
 
     return matrix;
   }
 
   static InType GenerateSquareMatrixWithKnownMax(int size) {
-    InType matrix(size, std::vector<int>(size));
+    InType matrix(size, size);
     std::random_device rd;
     std::mt19937 gen(rd());
 
@@ -53,7 +52,7 @@ class MatrixGenerator {
 
     for (int i = 0; i < size; ++i) {
       for (int j = 0; j < size; ++j) {
-        matrix[i][j] = dist(gen);
+        matrix(i, j) = dist(gen);
       }
     }
 
@@ -61,14 +60,14 @@ class MatrixGenerator {
     std::uniform_int_distribution<int> pos_dist(0, size - 1);
     int max_i = pos_dist(gen);
     int max_j = pos_dist(gen);
-    matrix[max_i][max_j] = max_val;
+    matrix(max_i, max_j) = max_val;
 
     return matrix;
   }
 
   // Для отрицательных тестов - все значения отрицательные
   static InType GenerateAllNegativeMatrix(int rows, int cols) {
-    InType matrix(rows, std::vector<int>(cols));
+    InType matrix(rows, cols);
     std::random_device rd;
     std::mt19937 gen(rd());
 
@@ -77,25 +76,25 @@ class MatrixGenerator {
 
     for (int i = 0; i < rows; ++i) {
       for (int j = 0; j < cols; ++j) {
-        matrix[i][j] = dist(gen);
+        matrix(i, j) = dist(gen);
       }
     }
 
     // Максимум = -1 (самое большое отрицательное)
     std::uniform_int_distribution<int> row_dist(0, rows - 1);
     std::uniform_int_distribution<int> col_dist(0, cols - 1);
-    matrix[row_dist(gen)][col_dist(gen)] = -1;
+    matrix(row_dist(gen), col_dist(gen)) = -1;
 
     return matrix;
   }
 
   static int GetExpectedMax(const InType &matrix) {
-    if (matrix.empty() || matrix[0].empty()) {
+    if (matrix.Empty()) {
       return std::numeric_limits<int>::min();
     }
 
     // Для наших сгенерированных матриц максимум = большее из измерений
-    return static_cast<int>(std::max(matrix.size(), matrix[0].size()));  // Исправлено: явное приведение типа
+    return static_cast<int>(std::max(matrix.Rows(), matrix.Cols()));  // Исправлено: явное приведение типа
   }
 
   static int GetExpectedMaxForNegative([[maybe_unused]] const InType &matrix) {
@@ -3,7 +3,6 @@
 #include <mpi.h>
 
 #include <algorithm>
-#include <cstring>  // memcpy
 #include <limits>
 #include <vector>
 
@@ -21,7 +20,7 @@ IvanovaPMaxMatrixMPI::IvanovaPMaxMatrixMPI(const InType &in) {
   if (rank == 0) {
     GetInput() = in;  // Только root хранит входную матрицу
   } else {
-    GetInput().clear();  // Остальные — пустая матрица
+    GetInput() = InType();  // Остальные — пустая матрица
   }
 }
 
@@ -32,17 +31,8 @@ bool IvanovaPMaxMatrixMPI::ValidationImpl() {
   bool ok = true;
 
   if (rank == 0) {
-    if (GetInput().empty()) {
-      ok = false;
-    } else {
-      const size_t cols = GetInput()[0].size();
-      for (const auto &row : GetInput()) {
-        if (row.size() != cols) {
-          ok = false;
-          break;
-        }
-      }
-    }
+    // Строки Matrix всегда одной длины, достаточно проверки на пустоту
+    ok = !GetInput().Empty();
   }
 
   int ok_int = ok ? 1 : 0;
@@ -57,18 +47,6 @@ bool IvanovaPMaxMatrixMPI::PreProcessingImpl() {
 
 namespace {
 
-std::vector<int> PackMatrix(const InType &input, int rows, int cols) {
-  std::vector<int> flat(static_cast<size_t>(rows) * cols);
-
-  size_t pos = 0;
-  for (int i = 0; i < rows; ++i) {
-    // быстрее, чем двойной for: memcpy целой строки
-    std::memcpy(&flat[pos], input[i].data(), sizeof(int) * cols);
-    pos += cols;
-  }
-  return flat;
-}
-
 int FindLocalMax(const std::vector<int> &vec) {
   if (vec.empty()) {
     return std::numeric_limits<int>::min();
@@ -87,8 +65,8 @@ bool IvanovaPMaxMatrixMPI::RunImpl() {
   int rows = 0;
   int cols = 0;
   if (rank == 0) {
-    rows = static_cast<int>(GetInput().size());
-    cols = rows > 0 ? static_cast<int>(GetInput()[0].size()) : 0;
+    rows = static_cast<int>(GetInput().Rows());
+    cols = static_cast<int>(GetInput().Cols());
   }
 
   MPI_Bcast(&rows, 1, MPI_INT, 0, MPI_COMM_WORLD);
@@ -113,14 +91,10 @@ bool IvanovaPMaxMatrixMPI::RunImpl() {
     displs[rank_idx] = displs[rank_idx - 1] + sendcounts[rank_idx - 1];
   }
 
-  std::vector<int> flat;
-  if (rank == 0) {
-    flat = PackMatrix(GetInput(), rows, cols);
-  }
-
   std::vector<int> local(my_count);
 
-  MPI_Scatterv(rank == 0 ? flat.data() : nullptr, sendcounts.data(), displs.data(), MPI_INT, local.data(), my_count,
+  // Матрица хранится одним непрерывным буфером, поэтому рассылается без упаковки
+  MPI_Scatterv(rank == 0 ? GetInput().Data() : nullptr, sendcounts.data(), displs.data(), MPI_INT, local.data(), my_count,
                MPI_INT, 0, MPI_COMM_WORLD);
 
   int local_max = FindLocalMax(local);
@@ -1,9 +1,7 @@
 #include "ivanova_p_max_matrix/seq/include/ops_seq.hpp"
 
 #include <algorithm>  // для std::max
-#include <cstddef>    // для size_t
 #include <limits>
-#include <vector>
 
 #include "ivanova_p_max_matrix/common/include/common.hpp"
 
@@ -12,24 +10,14 @@ namespace ivanova_p_max_matrix {
 IvanovaPMaxMatrixSEQ::IvanovaPMaxMatrixSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
 
-  // Безопасная инициализация
-  GetInput().clear();
-  if (!in.empty()) {
-    GetInput() = in;
-  }
+  GetInput() = in;
 
   GetOutput() = std::numeric_limits<int>::min();
 }
 
 bool IvanovaPMaxMatrixSEQ::ValidationImpl() {
-  // Базовая проверка на пустоту
-  if (GetInput().empty()) {
-    return false;
-  }
-
-  const size_t cols = GetInput()[0].size();
-  return std::all_of(GetInput().begin(), GetInput().end(),
-                     [cols](const std::vector<int> &row) { return row.size() == cols; });
+  // Строки Matrix всегда одной длины, достаточно проверки на пустоту
+  return !GetInput().Empty();
 }
 
 bool IvanovaPMaxMatrixSEQ::PreProcessingImpl() {
@@ -41,10 +29,8 @@ bool IvanovaPMaxMatrixSEQ::PreProcessingImpl() {
 bool IvanovaPMaxMatrixSEQ::RunImpl() {
   int max_val = std::numeric_limits<int>::min();
 
-  for (const auto &row : GetInput()) {
-    for (int val : row) {
-      max_val = std::max(val, max_val);
-    }
+  for (int val : GetInput().Flat()) {
+    max_val = std::max(val, max_val);
   }
 
   GetOutput() = max_val;
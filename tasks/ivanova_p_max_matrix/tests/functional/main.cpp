@@ -5,6 +5,7 @@
 #include <cstddef>   // для std::size_t
 #include <iostream>  // для std::cout
 #include <limits>    // для std::numeric_limits
+#include <stdexcept>
 #include <string>
 #include <tuple>
 
@@ -40,10 +41,8 @@ class IvanovaPMaxMatrixFuncTests : public ppc::util::BaseRunFuncTests<InType, Ou
     }
 
     int actual_max = std::numeric_limits<int>::min();
-    for (const auto &row : test_matrix_) {
-      for (int val : row) {
-        actual_max = std::max(val, actual_max);
-      }
+    for (int val : test_matrix_.Flat()) {
+      actual_max = std::max(val, actual_max);
     }
   }
 
@@ -84,12 +83,8 @@ class IvanovaPMaxMatrixSpecialTests : public ::testing::Test {
   }
 
   static void TestJaggedMatrix() {
-    InType jagged_matrix = {{1, 2}, {3}};
-    IvanovaPMaxMatrixSEQ task(jagged_matrix);
-    EXPECT_FALSE(task.Validation());
-    EXPECT_TRUE(task.PreProcessing());
-    EXPECT_TRUE(task.Run());
-    EXPECT_TRUE(task.PostProcessing());
+    // Matrix не допускает строк разной длины
+    EXPECT_THROW((InType{{1, 2}, {3}}), std::invalid_argument);
   }
 
   static void TestSingleElement() {
@@ -24,10 +24,8 @@ class IvanovaPMaxMatrixPerfTests : public ppc::util::BaseRunPerfTests<InType, Ou
     expected_max_ = perf_matrix_size;
 
     int actual_max = std::numeric_limits<int>::min();
-    for (const auto &row : input_data_) {
-      for (int val : row) {
-        actual_max = std::max(val, actual_max);
-      }
+    for (int val : input_data_.Flat()) {
+      actual_max = std::max(val, actual_max);
     }
 
     std::cout << "Perf Test: Matrix " << perf_matrix_size << "x" << perf_matrix_size
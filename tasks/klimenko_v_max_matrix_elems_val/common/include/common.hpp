@@ -2,13 +2,13 @@
 
 #include <string>
 #include <tuple>
-#include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace klimenko_v_max_matrix_elems_val {
 
-using InType = std::vector<std::vector<int>>;
+using InType = ppc::util::Matrix<int>;
 using OutType = int;
 using TestType = std::tuple<int, std::string>;
 using BaseTask = ppc::task::Task<InType, OutType>;
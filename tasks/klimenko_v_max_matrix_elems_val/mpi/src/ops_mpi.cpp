@@ -3,20 +3,25 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <cstddef>
+#include <vector>
 
 #include "klimenko_v_max_matrix_elems_val/common/include/common.hpp"
+#include "mpi/include/collectives.hpp"
+#include "mpi/include/distribution.hpp"
 
 namespace klimenko_v_max_matrix_elems_val {
 
 KlimenkoVMaxMatrixElemsValMPI::KlimenkoVMaxMatrixElemsValMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in);
+  GetInput() = in;
   GetOutput() = 0;
 }
 
 bool KlimenkoVMaxMatrixElemsValMPI::ValidationImpl() {
-  if (GetInput().empty() || GetInput()[0].empty()) {
+  if (GetInput().Empty()) {
     GetOutput() = 0;
   }
   return true;
@@ -35,33 +40,32 @@ bool KlimenkoVMaxMatrixElemsValMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  int n = 0;
+  std::array<int, 2> shape = {0, 0};
   if (rank == 0) {
-    n = static_cast<int>(matrix.size());
+    shape = {static_cast<int>(matrix.Rows()), static_cast<int>(matrix.Cols())};
   }
 
-  MPI_Bcast(&n, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(shape.data(), 2, MPI_INT, 0, MPI_COMM_WORLD);
+  const int rows = shape[0];
+  const int cols = shape[1];
 
-  if (n == 0) {
-    int result = 0;
-    MPI_Bcast(&result, 1, MPI_INT, 0, MPI_COMM_WORLD);
-    GetOutput() = result;
+  if (rows == 0 || cols == 0) {
+    GetOutput() = 0;
     return true;
   }
 
-  int global_max = INT_MIN;
+  // Rows of the matrix are contiguous, so every process gets its block of rows straight from the input buffer
+  const ppc::mpi::BlockDistribution dist(rows, size);
+  std::vector<int> local(static_cast<std::size_t>(dist.Count(rank)) * cols);
+  ppc::mpi::Scatter(matrix.Flat(), local, dist, 0, MPI_COMM_WORLD, cols);
 
-  if (rank == 0) {
-    int local_max = INT_MIN;
-    for (const auto &row : matrix) {
-      for (int v : row) {
-        local_max = std::max(local_max, v);
-      }
-    }
-    global_max = local_max;
+  int local_max = INT_MIN;
+  for (int v : local) {
+    local_max = std::max(local_max, v);
   }
 
-  MPI_Bcast(&global_max, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  int global_max = INT_MIN;
+  MPI_Allreduce(&local_max, &global_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
 
   GetOutput() = global_max;
 
@@ -1,8 +1,6 @@
 #include "klimenko_v_max_matrix_elems_val/seq/include/ops_seq.hpp"
 
 #include <algorithm>
-#include <climits>
-#include <vector>
 
 #include "klimenko_v_max_matrix_elems_val/common/include/common.hpp"
 
@@ -10,12 +8,12 @@ namespace klimenko_v_max_matrix_elems_val {
 
 KlimenkoVMaxMatrixElemsValSEQ::KlimenkoVMaxMatrixElemsValSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in);
+  GetInput() = in;
   GetOutput() = 0;
 }
 
 bool KlimenkoVMaxMatrixElemsValSEQ::ValidationImpl() {
-  if (GetInput().empty() || GetInput()[0].empty()) {
+  if (GetInput().Empty()) {
     GetOutput() = 0;
   }
   return true;
@@ -28,19 +26,12 @@ bool KlimenkoVMaxMatrixElemsValSEQ::PreProcessingImpl() {
 bool KlimenkoVMaxMatrixElemsValSEQ::RunImpl() {
   const auto &matrix = GetInput();
 
-  if (matrix.empty()) {
+  if (matrix.Empty()) {
     GetOutput() = 0;
     return true;
   }
 
-  int max_element = matrix[0][0];
-  for (const auto &row : matrix) {
-    for (int element : row) {
-      max_element = std::max(element, max_element);
-    }
-  }
-
-  GetOutput() = max_element;
+  GetOutput() = std::ranges::max(matrix.Flat());
   return true;
 }
 
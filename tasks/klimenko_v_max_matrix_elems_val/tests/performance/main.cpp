@@ -13,12 +13,11 @@ class KlimenkoVMaxMatrixElemsValPerfTests : public ppc::util::BaseRunPerfTests<I
   OutType expected_max_ = 0;
 
   void SetUp() override {
-    input_data_.resize(n_);
+    input_data_ = InType(n_, n_);
     int val = 1;
     for (int i = 0; i < n_; i++) {
-      input_data_[i].resize(n_);
       for (int j = 0; j < n_; j++) {
-        input_data_[i][j] = val++;
+        input_data_(i, j) = val++;
       }
     }
     expected_max_ = n_ * n_;
@@ -12,6 +12,7 @@ class KlimenkoVSeidelMethodMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
   explicit KlimenkoVSeidelMethodMPI(const InType &in);
 
   bool ValidationImpl() override;
@@ -29,6 +30,19 @@ class KlimenkoVSeidelMethodMPI : public BaseTask {
                                        const std::vector<double> &x_old);
   static void UpdateLocalXVector(int local_rows, int start_row, const std::vector<double> &x,
                                  std::vector<double> &local_x_updated);
+
+ private:
+  std::vector<int> row_counts_;
+  std::vector<int> row_displs_;
+  std::vector<int> matrix_counts_;
+  std::vector<int> matrix_displs_;
+  std::vector<double> flat_matrix_;
+  std::vector<double> b_;
+  std::vector<double> local_matrix_;
+  std::vector<double> local_b_;
+  std::vector<double> x_;
+  std::vector<double> x_old_;
+  std::vector<double> local_x_updated_;
 };
 
 }  // namespace klimenko_v_seidel_method
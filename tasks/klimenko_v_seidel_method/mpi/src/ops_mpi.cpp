@@ -20,13 +20,13 @@ KlimenkoVSeidelMethodMPI::KlimenkoVSeidelMethodMPI(const InType &in) {
 
 bool KlimenkoVSeidelMethodMPI::ValidationImpl() {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetComm(), &rank);
 
   int is_valid = 0;
   if (rank == 0) {
     is_valid = ((GetInput() > 0) && (GetOutput() == 0)) ? 1 : 0;
   }
-  MPI_Bcast(&is_valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&is_valid, 1, MPI_INT, 0, GetComm());
 
   return is_valid != 0;
 }
@@ -34,12 +34,12 @@ bool KlimenkoVSeidelMethodMPI::ValidationImpl() {
 bool KlimenkoVSeidelMethodMPI::PreProcessingImpl() {
   int rank = 0;
   int size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
   GetOutput() = 0;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(GetComm());
   return true;
 }
 
@@ -48,50 +48,49 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
 
   int rank = 0;
   int size = 1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
-  std::vector<int> row_counts(size);
-  std::vector<int> row_displs(size);
-  std::vector<int> matrix_counts(size);
-  std::vector<int> matrix_displs(size);
-  ComputeRowDistribution(n, size, row_counts, row_displs, matrix_counts, matrix_displs);
+  // Buffers are members so a task reused through ResetInput() keeps their capacity
+  row_counts_.resize(size);
+  row_displs_.resize(size);
+  matrix_counts_.resize(size);
+  matrix_displs_.resize(size);
+  ComputeRowDistribution(n, size, row_counts_, row_displs_, matrix_counts_, matrix_displs_);
 
-  int local_rows = row_counts[rank];
-  int start_row = row_displs[rank];
+  int local_rows = row_counts_[rank];
+  int start_row = row_displs_[rank];
 
-  std::vector<double> flat_matrix;
-  std::vector<double> b;
   if (rank == 0) {
-    InitializeMatrixAndVector(flat_matrix, b, n);
+    InitializeMatrixAndVector(flat_matrix_, b_, n);
   }
 
-  std::vector<double> local_matrix(static_cast<size_t>(local_rows) * n, 0.0);
-  MPI_Scatterv(flat_matrix.data(), matrix_counts.data(), matrix_displs.data(), MPI_DOUBLE, local_matrix.data(),
-               local_rows * n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  local_matrix_.assign(static_cast<size_t>(local_rows) * n, 0.0);
+  MPI_Scatterv(flat_matrix_.data(), matrix_counts_.data(), matrix_displs_.data(), MPI_DOUBLE, local_matrix_.data(),
+               local_rows * n, MPI_DOUBLE, 0, GetComm());
 
-  std::vector<double> local_b(local_rows, 0.0);
-  MPI_Scatterv(b.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, local_b.data(), local_rows, MPI_DOUBLE, 0,
-               MPI_COMM_WORLD);
+  local_b_.assign(local_rows, 0.0);
+  MPI_Scatterv(b_.data(), row_counts_.data(), row_displs_.data(), MPI_DOUBLE, local_b_.data(), local_rows, MPI_DOUBLE,
+               0, GetComm());
 
-  std::vector<double> x(n, 0.0);
+  x_.assign(n, 0.0);
+  local_x_updated_.resize(local_rows);
   const double epsilon = 1e-6;
   const int max_iterations = 1000;
 
   for (int iteration = 0; iteration < max_iterations; iteration++) {
-    std::vector<double> x_old = x;
+    x_old_ = x_;
 
-    PerformSeidelIteration(local_rows, start_row, n, local_matrix, local_b, x);
+    PerformSeidelIteration(local_rows, start_row, n, local_matrix_, local_b_, x_);
 
-    std::vector<double> local_x_updated(local_rows);
-    UpdateLocalXVector(local_rows, start_row, x, local_x_updated);
+    UpdateLocalXVector(local_rows, start_row, x_, local_x_updated_);
 
-    MPI_Allgatherv(local_x_updated.data(), local_rows, MPI_DOUBLE, x.data(), row_counts.data(), row_displs.data(),
-                   MPI_DOUBLE, MPI_COMM_WORLD);
+    MPI_Allgatherv(local_x_updated_.data(), local_rows, MPI_DOUBLE, x_.data(), row_counts_.data(),
+                   row_displs_.data(), MPI_DOUBLE, GetComm());
 
-    double local_diff = ComputeLocalDifference(local_rows, start_row, x, x_old);
+    double local_diff = ComputeLocalDifference(local_rows, start_row, x_, x_old_);
     double global_diff = 0.0;
-    MPI_Allreduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, GetComm());
     global_diff = std::sqrt(global_diff);
 
     if (global_diff < epsilon) {
@@ -100,10 +99,10 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
   }
 
   if (rank == 0) {
-    GetOutput() = ComputeFinalResult(x, n);
+    GetOutput() = ComputeFinalResult(x_, n);
   }
 
-  MPI_Bcast(&GetOutput(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&GetOutput(), 1, MPI_INT, 0, GetComm());
   return true;
 }
 
@@ -146,8 +145,8 @@ void KlimenkoVSeidelMethodMPI::InitializeMatrixAndVector(std::vector<double> &fl
   std::uniform_real_distribution<double> dist_off_diag(0.0, 1.0);
   std::uniform_int_distribution<int> dist_diag(10, 19);
 
-  flat_matrix.resize(static_cast<size_t>(n) * n, 0.0);
-  b.resize(n, 0.0);
+  flat_matrix.assign(static_cast<size_t>(n) * n, 0.0);
+  b.assign(n, 0.0);
 
   std::vector<double> x_exact(n, 1.0);
 
@@ -10,6 +10,7 @@ class KondrashovaVSumColMatMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
 
   explicit KondrashovaVSumColMatMPI(const InType &in);
 
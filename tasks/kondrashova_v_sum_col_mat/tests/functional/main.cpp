@@ -13,6 +13,7 @@
 #include "kondrashova_v_sum_col_mat/common/include/common.hpp"
 #include "kondrashova_v_sum_col_mat/mpi/include/ops_mpi.hpp"
 #include "kondrashova_v_sum_col_mat/seq/include/ops_seq.hpp"
+#include "util/include/comm.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -97,7 +98,7 @@ class KondrashovaVSumColMatFuncTestsProcesses : public ppc::util::BaseRunFuncTes
 
     MPI_Initialized(&mpi_initialized);
     if (mpi_initialized != 0) {
-      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_rank(ppc::util::GetTaskComm(), &rank);
     }
 
     if (rank != 0) {
@@ -9,6 +9,7 @@
 #include "kondrashova_v_sum_col_mat/common/include/common.hpp"
 #include "kondrashova_v_sum_col_mat/mpi/include/ops_mpi.hpp"
 #include "kondrashova_v_sum_col_mat/seq/include/ops_seq.hpp"
+#include "util/include/comm.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace kondrashova_v_sum_col_mat {
@@ -28,7 +29,7 @@ class KondrashovaVSumColMatPerfTestsLittle : public ppc::util::BaseRunPerfTests<
 
     MPI_Initialized(&mpi_initialized);
     if (mpi_initialized == 1) {
-      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_rank(ppc::util::GetTaskComm(), &rank);
     }
 
     if (rank != 0) {
@@ -67,7 +68,7 @@ class KondrashovaVSumColMatPerfTestsLittle : public ppc::util::BaseRunPerfTests<
     MPI_Initialized(&mpi_initialized);
 
     if (mpi_initialized == 1) {
-      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_rank(ppc::util::GetTaskComm(), &rank);
     }
 
     if (rank != 0) {
@@ -6,10 +6,14 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "marin_l_cnt_mismat_chrt_in_two_str/common/include/common.hpp"
 #include "marin_l_cnt_mismat_chrt_in_two_str/mpi/include/ops_mpi.hpp"
 #include "marin_l_cnt_mismat_chrt_in_two_str/seq/include/ops_seq.hpp"
+#include "task/include/batch_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/comm.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -89,160 +93,72 @@ const auto kFunctionalTestName =
 INSTANTIATE_TEST_SUITE_P(MarinStringMismatchSuite, MarinLCntMismatChrtInTwoStrFuncTests, kParameterizedValues,
                          kFunctionalTestName);
 
-TEST(MarinLCntMismatStrMPI, IdenticalStrings) {
-  InType input = {"hello", "hello"};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
+// Short pairs and edge cases; each is far too small to be worth a task of its own, so they run as one batch
+std::vector<InType> MakeSmallPairs() {
+  return {
+      {"hello", "hello"},
+      {"world", "worle"},
+      {"abc", "abcdef"},
+      {"", ""},
+      {"", "abc"},
+      {"Hello", "hello"},
+      {"12345", "12995"},
+      {std::string(1000, 'a'), std::string(1000, 'b')},
+      {"A", "B"},
+      {std::string(200, 'x'), std::string(200, 'x')},
+      {"abc", "acb"},
+      {"", std::string(5000, 'q')},
+      {"abcdefX", "abcdefY"},
+      {"a b c", "abc "},
+      {"ñandú", "nandu"},
+  };
+}
+
+void RunSmallPairsBatch(const ppc::task::ItemTaskFactory<InType, OutType> &make_item, ppc::task::BatchMode mode) {
+  const auto pairs = MakeSmallPairs();
+  ppc::task::BatchTask<InType, OutType> task(pairs, make_item, mode);
   ASSERT_TRUE(task.Validation());
   ASSERT_TRUE(task.PreProcessing());
   ASSERT_TRUE(task.Run());
   ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("hello", "hello", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, OneDifference) {
-  InType input = {"world", "worle"};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("world", "worle", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, DifferentLength) {
-  InType input = {"abc", "abcdef"};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("abc", "abcdef", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, BothEmpty) {
-  InType input = {"", ""};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("", "", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, EmptyVsNonEmpty) {
-  InType input = {"", "abc"};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("", "abc", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, CaseSensitive) {
-  InType input = {"Hello", "hello"};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("Hello", "hello", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, NumericChars) {
-  InType input = {"12345", "12995"};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("12345", "12995", task.GetOutput());
-}
-
-TEST(MarinLCntMismatStrMPI, VeryLongStrings) {
-  std::string a(1000, 'a');
-  std::string b(1000, 'b');
-  InType input = {a, b};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr(a, b, task.GetOutput());
+  ASSERT_EQ(task.GetOutput().size(), pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    CntMismatChrtInTwoStr(pairs[i].first, pairs[i].second, task.GetOutput()[i]);
+  }
 }
 
-TEST(MarinLCntMismatStrSEQ, SingleCharDifference) {
-  InType input = {"A", "B"};
-  MarinLCntMismatChrtInTwoStrSEQ task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("A", "B", task.GetOutput());
+// Every process runs every pair, so one MPI task instance is reused for all of them
+TEST(MarinLCntMismatStrMPI, SmallPairsInOneBatch) {
+  RunSmallPairsBatch(ppc::task::TaskGetter<MarinLCntMismatChrtInTwoStrMPI, InType>, ppc::task::BatchMode::kSequential);
 }
 
-TEST(MarinLCntMismatStrSEQ, LongIdentical) {
-  std::string s(200, 'x');
-  InType input = {s, s};
-  MarinLCntMismatChrtInTwoStrSEQ task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr(s, s, task.GetOutput());
+TEST(MarinLCntMismatStrSEQ, SmallPairsInOneBatch) {
+  RunSmallPairsBatch(ppc::task::TaskGetter<MarinLCntMismatChrtInTwoStrSEQ, InType>, ppc::task::BatchMode::kSequential);
 }
 
-TEST(MarinLCntMismatStrSEQ, SwappedChars) {
-  InType input = {"abc", "acb"};
-  MarinLCntMismatChrtInTwoStrSEQ task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("abc", "acb", task.GetOutput());
-}
+// Whole pairs are spread over the processes and counted by one SEQ task per process
+class MarinLCntMismatChrtInTwoStrBatch : public ::testing::TestWithParam<std::string> {};
 
-TEST(MarinLCntMismatStrMPI, LengthGap5000) {
-  std::string a;
-  std::string b(5000, 'q');
-  InType input = {a, b};
-  MarinLCntMismatChrtInTwoStrMPI task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr(a, b, task.GetOutput());
+TEST_P(MarinLCntMismatChrtInTwoStrBatch, CountsSmallPairsInOneBatch) {
+  const auto type =
+      ppc::task::GetStringTaskType(ppc::task::TypeOfTask::kSEQ, PPC_SETTINGS_marin_l_cnt_mismat_chrt_in_two_str);
+  if (type.find("disabled") != std::string::npos || GetParam().find("disabled") != std::string::npos) {
+    GTEST_SKIP();
+  }
+  RunSmallPairsBatch(ppc::task::TaskGetter<MarinLCntMismatChrtInTwoStrSEQ, InType>, ppc::task::BatchMode::kDistributed);
 }
 
-TEST(MarinLCntMismatStrSEQ, DiffAtEnd) {
-  InType input = {"abcdefX", "abcdefY"};
-  MarinLCntMismatChrtInTwoStrSEQ task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("abcdefX", "abcdefY", task.GetOutput());
-}
+// The batch runs as an MPI task, so it is named like one for the `_mpi_` runs to select it
+const std::string kBatchTestName =
+    std::string(ppc::util::GetNamespace<MarinLCntMismatChrtInTwoStrSEQ>()) + "_" +
+    ppc::task::GetStringTaskType(ppc::task::TypeOfTask::kMPI, PPC_SETTINGS_marin_l_cnt_mismat_chrt_in_two_str) +
+    "_batch";
 
-TEST(MarinLCntMismatStrSEQ, SpacesIncluded) {
-  InType input = {"a b c", "abc "};
-  MarinLCntMismatChrtInTwoStrSEQ task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("a b c", "abc ", task.GetOutput());
-}
+// BatchTask communicates only on its GetComm(), so the batch may run on a group of processes
+[[maybe_unused]] const bool kBatchUsesTaskComm = ppc::util::RegisterTaskCommTest(kBatchTestName);
 
-TEST(MarinLCntMismatStrSEQ, UnicodeLikeChars) {
-  InType input = {"ñandú", "nandu"};
-  MarinLCntMismatChrtInTwoStrSEQ task(input);
-  ASSERT_TRUE(task.Validation());
-  ASSERT_TRUE(task.PreProcessing());
-  ASSERT_TRUE(task.Run());
-  ASSERT_TRUE(task.PostProcessing());
-  CntMismatChrtInTwoStr("ñandú", "nandu", task.GetOutput());
-}
+INSTANTIATE_TEST_SUITE_P(MarinStringMismatchSuite, MarinLCntMismatChrtInTwoStrBatch, ::testing::Values(kBatchTestName),
+                         [](const ::testing::TestParamInfo<std::string> &info) { return info.param; });
 
 }  // namespace
 
@@ -2,16 +2,14 @@
 
 #include <array>
 #include <cstddef>
-#include <fstream>
 #include <random>
-#include <sstream>
-#include <stdexcept>
 #include <string>
 #include <tuple>
 
 #include "morozov_n_sentence_count/common/include/common.hpp"
 #include "morozov_n_sentence_count/mpi/include/ops_mpi.hpp"
 #include "morozov_n_sentence_count/seq/include/ops_seq.hpp"
+#include "util/include/data_file.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -28,7 +26,6 @@ class MorozovNRunSentenceCountTests : public ppc::util::BaseRunFuncTests<InType,
 
  protected:
   void SetUp() override {
-    std::string text;
     TestType params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
     std::string test_file_path = std::get<1>(params);
     // Read text from params
@@ -37,16 +34,8 @@ class MorozovNRunSentenceCountTests : public ppc::util::BaseRunFuncTests<InType,
       input_data_ = GenerateTestData(task_answer_, 0);
     } else {
       std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_morozov_n_sentence_count, test_file_path);
-      std::ifstream file(abs_path);
-      if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + abs_path);
-      }
-      std::stringstream ss;
-      ss << file.rdbuf();
-      text = ss.str();
-
       task_answer_ = std::get<2>(params);
-      input_data_ = text;
+      input_data_ = std::string(ppc::util::MappedFile(abs_path).Text());
     }
   }
 
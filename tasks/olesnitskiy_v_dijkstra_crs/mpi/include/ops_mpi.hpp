@@ -1,10 +1,13 @@
 #pragma once
 
+#include <mpi.h>
+
 #include <functional>
 #include <queue>
 #include <utility>
 #include <vector>
 
+#include "mpi/include/shared_array.hpp"
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -15,7 +18,8 @@ class OlesnitskiyVDijkstraCrsMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit OlesnitskiyVDijkstraCrsMPI(const InType &in);
+  static constexpr bool kUsesTaskComm = true;
+  explicit OlesnitskiyVDijkstraCrsMPI(ppc::task::SharedInput<InType> in);
 
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
@@ -33,12 +37,13 @@ class OlesnitskiyVDijkstraCrsMPI : public BaseTask {
     int vertex{0};
   };
 
+  /// @brief Read-only graph shared by all processes of a node.
   struct GraphData {
     int vertices{0};
     int source{0};
-    std::vector<int> offsets;
-    std::vector<int> edges;
-    std::vector<int> weights;
+    ppc::mpi::NodeSharedArray<int> offsets;
+    ppc::mpi::NodeSharedArray<int> edges;
+    ppc::mpi::NodeSharedArray<int> weights;
   };
 
   struct DijkstraContext {
@@ -52,20 +57,20 @@ class OlesnitskiyVDijkstraCrsMPI : public BaseTask {
     std::vector<bool> local_visited;
     std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pq;
     std::vector<std::vector<Update>> send_bufs;
+    MPI_Comm comm{MPI_COMM_NULL};
   };
 
   static bool IsVertexLocal(int vertex, int start_idx, int end_idx);
   static int FindOwner(int vertex, const std::vector<int> &displs, const std::vector<int> &counts, int size);
-  static void ProcessLocalVertex(int vertex, int distance, const std::vector<int> &offsets,
-                                 const std::vector<int> &edges, const std::vector<int> &weights, DijkstraContext &ctx,
-                                 int rank, int size);
+  static void ProcessLocalVertex(int vertex, int distance, const GraphData &graph, DijkstraContext &ctx, int rank,
+                                 int size);
   static void ProcessReceivedData(const std::vector<int> &recv_data, int total_recv, DijkstraContext &ctx);
   static void PrepareSendData(const std::vector<std::vector<Update>> &send_bufs, std::vector<int> &send_data);
   static void CalculateDisplacements(const std::vector<int> &sizes, std::vector<int> &displs, int &total);
   static void PrepareByteArrays(const std::vector<int> &sizes, const std::vector<int> &displs,
                                 std::vector<int> &counts_bytes, std::vector<int> &displs_bytes);
-  static GraphData BroadcastGraphData(int rank, int /*size*/, const InType &input);
-  static DistVertexPair FindGlobalBestVertex(const DistVertexPair &local_best);
+  static GraphData BroadcastGraphData(int rank, MPI_Comm comm, const InType &input);
+  static DistVertexPair FindGlobalBestVertex(const DistVertexPair &local_best, MPI_Comm comm);
   static bool ShouldStopAlgorithm(const DistVertexPair &global_best);
   static void ExchangeUpdates(DijkstraContext &ctx);
   static DijkstraContext InitializeLocalData(int vertices, int size, int rank, int source);
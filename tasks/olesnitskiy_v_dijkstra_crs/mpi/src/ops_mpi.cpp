@@ -6,21 +6,24 @@
 #include <cstddef>
 #include <limits>
 #include <queue>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "mpi/include/shared_array.hpp"
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
 
-OlesnitskiyVDijkstraCrsMPI::OlesnitskiyVDijkstraCrsMPI(const InType &in) {
+OlesnitskiyVDijkstraCrsMPI::OlesnitskiyVDijkstraCrsMPI(ppc::task::SharedInput<InType> in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  BorrowInput(std::move(in));
   GetOutput() = std::vector<int>();
 }
 
 bool OlesnitskiyVDijkstraCrsMPI::ValidationImpl() {
-  const auto &input = GetInput();
+  const auto &input = GetInputView();
   int source = std::get<0>(input);
   const auto &offsets = std::get<1>(input);
   const auto &edges = std::get<2>(input);
@@ -61,15 +64,14 @@ int OlesnitskiyVDijkstraCrsMPI::FindOwner(int vertex, const std::vector<int> &di
   return 0;
 }
 
-void OlesnitskiyVDijkstraCrsMPI::ProcessLocalVertex(int vertex, int distance, const std::vector<int> &offsets,
-                                                    const std::vector<int> &edges, const std::vector<int> &weights,
+void OlesnitskiyVDijkstraCrsMPI::ProcessLocalVertex(int vertex, int distance, const GraphData &graph,
                                                     DijkstraContext &ctx, int rank, int size) {
-  int start = offsets[vertex];
-  int end = offsets[vertex + 1];
+  int start = graph.offsets[vertex];
+  int end = graph.offsets[vertex + 1];
 
   for (int i = start; i < end; ++i) {
-    int neighbor = edges[i];
-    int weight = weights[i];
+    int neighbor = graph.edges[i];
+    int weight = graph.weights[i];
     int new_dist = distance + weight;
 
     int owner = FindOwner(neighbor, ctx.displs, ctx.counts, size);
@@ -144,7 +146,7 @@ void OlesnitskiyVDijkstraCrsMPI::ExchangeUpdates(DijkstraContext &ctx) {
     send_sizes[i] = static_cast<int>(ctx.send_bufs[i].size());
   }
 
-  MPI_Alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1, MPI_INT, ctx.comm);
 
   std::vector<int> send_displs(size);
   std::vector<int> recv_displs(size);
@@ -174,7 +176,7 @@ void OlesnitskiyVDijkstraCrsMPI::ExchangeUpdates(DijkstraContext &ctx) {
   PrepareByteArrays(recv_sizes, recv_displs, recv_counts_bytes, recv_displs_bytes);
 
   MPI_Alltoallv(send_data.data(), send_counts_bytes.data(), send_displs_bytes.data(), MPI_INT, recv_data.data(),
-                recv_counts_bytes.data(), recv_displs_bytes.data(), MPI_INT, MPI_COMM_WORLD);
+                recv_counts_bytes.data(), recv_displs_bytes.data(), MPI_INT, ctx.comm);
 
   ProcessReceivedData(recv_data, total_recv, ctx);
 }
@@ -206,39 +208,27 @@ OlesnitskiyVDijkstraCrsMPI::DijkstraContext OlesnitskiyVDijkstraCrsMPI::Initiali
   return ctx;
 }
 
-OlesnitskiyVDijkstraCrsMPI::GraphData OlesnitskiyVDijkstraCrsMPI::BroadcastGraphData(int rank, int /*size*/,
+OlesnitskiyVDijkstraCrsMPI::GraphData OlesnitskiyVDijkstraCrsMPI::BroadcastGraphData(int rank, MPI_Comm comm,
                                                                                      const InType &input) {
   GraphData graph;
+  std::span<const int> offsets;
+  std::span<const int> edges;
+  std::span<const int> weights;
 
   if (rank == 0) {
-    const auto &inp = input;
-    graph.source = std::get<0>(inp);
-    graph.offsets = std::get<1>(inp);
-    graph.edges = std::get<2>(inp);
-    graph.weights = std::get<3>(inp);
-    graph.vertices = static_cast<int>(graph.offsets.size()) - 1;
+    graph.source = std::get<0>(input);
+    offsets = std::get<1>(input);
+    edges = std::get<2>(input);
+    weights = std::get<3>(input);
   }
 
-  MPI_Bcast(&graph.vertices, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&graph.source, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&graph.source, 1, MPI_INT, 0, comm);
 
-  if (rank != 0) {
-    graph.offsets.resize(graph.vertices + 1);
-  }
-  MPI_Bcast(graph.offsets.data(), graph.vertices + 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  int total_edges = 0;
-  if (rank == 0) {
-    total_edges = static_cast<int>(graph.edges.size());
-  }
-  MPI_Bcast(&total_edges, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  if (rank != 0) {
-    graph.edges.resize(total_edges);
-    graph.weights.resize(total_edges);
-  }
-  MPI_Bcast(graph.edges.data(), total_edges, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(graph.weights.data(), total_edges, MPI_INT, 0, MPI_COMM_WORLD);
+  // Every process reads the whole graph, so keep a single copy per node instead of one per process
+  graph.offsets = ppc::mpi::NodeSharedArray<int>::Broadcast(offsets, 0, comm);
+  graph.edges = ppc::mpi::NodeSharedArray<int>::Broadcast(edges, 0, comm);
+  graph.weights = ppc::mpi::NodeSharedArray<int>::Broadcast(weights, 0, comm);
+  graph.vertices = static_cast<int>(graph.offsets.Size()) - 1;
 
   return graph;
 }
@@ -262,9 +252,9 @@ bool OlesnitskiyVDijkstraCrsMPI::FindLocalBestVertex(DijkstraContext &ctx, DistV
 }
 
 OlesnitskiyVDijkstraCrsMPI::DistVertexPair OlesnitskiyVDijkstraCrsMPI::FindGlobalBestVertex(
-    const DistVertexPair &local_best) {
+    const DistVertexPair &local_best, MPI_Comm comm) {
   DistVertexPair global_best{};
-  MPI_Allreduce(&local_best, &global_best, 1, MPI_2INT, MPI_MINLOC, MPI_COMM_WORLD);
+  MPI_Allreduce(&local_best, &global_best, 1, MPI_2INT, MPI_MINLOC, comm);
   return global_best;
 }
 
@@ -288,7 +278,7 @@ void OlesnitskiyVDijkstraCrsMPI::ProcessGlobalVertex(const DistVertexPair &globa
     ctx.pq.pop();
   }
 
-  ProcessLocalVertex(global_best.vertex, global_best.dist, graph.offsets, graph.edges, graph.weights, ctx, rank, size);
+  ProcessLocalVertex(global_best.vertex, global_best.dist, graph, ctx, rank, size);
 }
 
 bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph, DijkstraContext &ctx, int rank,
@@ -298,7 +288,7 @@ bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph
     return true;
   }
 
-  DistVertexPair global_best = FindGlobalBestVertex(local_best);
+  DistVertexPair global_best = FindGlobalBestVertex(local_best, ctx.comm);
 
   if (ShouldStopAlgorithm(global_best)) {
     return false;
@@ -308,7 +298,7 @@ bool OlesnitskiyVDijkstraCrsMPI::PerformDijkstraIteration(const GraphData &graph
   ExchangeUpdates(ctx);
 
   int local_active = !ctx.pq.empty() ? 1 : 0;
-  MPI_Allreduce(&local_active, &ctx.active, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(&local_active, &ctx.active, 1, MPI_INT, MPI_SUM, ctx.comm);
 
   return true;
 }
@@ -330,13 +320,13 @@ void OlesnitskiyVDijkstraCrsMPI::CollectResults(const GraphData &graph, const Di
     std::ranges::copy(ctx.local_distances, global_distances.begin() + ctx.start_idx);
 
     for (int src = 1; src < size; ++src) {
-      MPI_Recv(global_distances.data() + ctx.displs[src], ctx.counts[src], MPI_INT, src, 0, MPI_COMM_WORLD,
+      MPI_Recv(global_distances.data() + ctx.displs[src], ctx.counts[src], MPI_INT, src, 0, GetComm(),
                MPI_STATUS_IGNORE);
     }
 
     GetOutput() = global_distances;
   } else {
-    MPI_Send(ctx.local_distances.data(), ctx.local_vertices, MPI_INT, 0, 0, MPI_COMM_WORLD);
+    MPI_Send(ctx.local_distances.data(), ctx.local_vertices, MPI_INT, 0, 0, GetComm());
     GetOutput() = std::vector<int>();
   }
 }
@@ -344,12 +334,13 @@ void OlesnitskiyVDijkstraCrsMPI::CollectResults(const GraphData &graph, const Di
 bool OlesnitskiyVDijkstraCrsMPI::RunImpl() {
   int rank = 0;
   int size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
-  GraphData graph = BroadcastGraphData(rank, size, GetInput());
+  GraphData graph = BroadcastGraphData(rank, GetComm(), GetInputView());
 
   DijkstraContext ctx = InitializeLocalData(graph.vertices, size, rank, graph.source);
+  ctx.comm = GetComm();
 
   RunDijkstraAlgorithm(graph, ctx, rank, size);
 
@@ -11,7 +11,7 @@ class OlesnitskiyVDijkstraCrsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit OlesnitskiyVDijkstraCrsSEQ(const InType &in);
+  explicit OlesnitskiyVDijkstraCrsSEQ(ppc::task::SharedInput<InType> in);
 
  private:
   bool ValidationImpl() override;
@@ -10,14 +10,14 @@
 
 namespace olesnitskiy_v_dijkstra_crs {
 
-OlesnitskiyVDijkstraCrsSEQ::OlesnitskiyVDijkstraCrsSEQ(const InType &in) {
+OlesnitskiyVDijkstraCrsSEQ::OlesnitskiyVDijkstraCrsSEQ(ppc::task::SharedInput<InType> in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  BorrowInput(std::move(in));
   GetOutput() = std::vector<int>();
 }
 
 bool OlesnitskiyVDijkstraCrsSEQ::ValidationImpl() {
-  const auto &input = GetInput();
+  const auto &input = GetInputView();
   int source = std::get<0>(input);
   const auto &offsets = std::get<1>(input);
   const auto &edges = std::get<2>(input);
@@ -43,7 +43,7 @@ bool OlesnitskiyVDijkstraCrsSEQ::PreProcessingImpl() {
 }
 
 bool OlesnitskiyVDijkstraCrsSEQ::RunImpl() {
-  const auto &input = GetInput();
+  const auto &input = GetInputView();
   int source = std::get<0>(input);
   const auto &offsets = std::get<1>(input);
   const auto &edges = std::get<2>(input);
@@ -1,75 +1,78 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <limits>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
 #include "olesnitskiy_v_dijkstra_crs/mpi/include/ops_mpi.hpp"
 #include "olesnitskiy_v_dijkstra_crs/seq/include/ops_seq.hpp"
+#include "task/include/task.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/sweep.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
-class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  const int kVertices_ = 1000000;
-  [[nodiscard]] InType GenerateTestGraph() const {
-    std::vector<int> offsets(kVertices_ + 1, 0);
-    std::vector<int> edges;
-    std::vector<int> weights;
-    for (int i = 0; i < kVertices_; ++i) {
-      for (int edge_num = 0; edge_num < 100; ++edge_num) {
-        int j = (i + edge_num * 97) % kVertices_;
-        if (j == i) {
-          j = (j + 1) % kVertices_;
-        }
-        edges.push_back(j);
-        int weight = 1 + ((i + j + edge_num) % 20);
-        weights.push_back(weight);
-        offsets[i + 1]++;
+
+namespace {
+
+constexpr int kVertices = 1000000;
+
+InType GenerateTestGraph(int vertices) {
+  std::vector<int> offsets(vertices + 1, 0);
+  std::vector<int> edges;
+  std::vector<int> weights;
+  for (int i = 0; i < vertices; ++i) {
+    for (int edge_num = 0; edge_num < 100; ++edge_num) {
+      int j = (i + edge_num * 97) % vertices;
+      if (j == i) {
+        j = (j + 1) % vertices;
       }
+      edges.push_back(j);
+      int weight = 1 + ((i + j + edge_num) % 20);
+      weights.push_back(weight);
+      offsets[i + 1]++;
     }
-    for (int i = 0; i < kVertices_; ++i) {
-      offsets[i + 1] += offsets[i];
-    }
-    int source = 0;
-    return std::make_tuple(source, offsets, edges, weights);
   }
-
-  InType input_data_;
-
-  void SetUp() override {
-    input_data_ = GenerateTestGraph();
+  for (int i = 0; i < vertices; ++i) {
+    offsets[i + 1] += offsets[i];
   }
+  int source = 0;
+  return std::make_tuple(source, std::move(offsets), std::move(edges), std::move(weights));
+}
 
-  bool CheckTestOutputData(OutType &output_data) final {
-    if (output_data.empty()) {
-      return true;
+bool CheckDistances(int vertices, const OutType &output_data) {
+  if (output_data.empty()) {
+    return true;
+  }
+  if (output_data[0] != 0) {
+    return false;
+  }
+  for (int dist : output_data) {
+    if (dist < 0) {
+      return false;
     }
-    if (!output_data.empty()) {
-      if (output_data[0] != 0) {
-        return false;
-      }
-      for (int dist : output_data) {
-        if (dist < 0) {
-          return false;
-        }
-      }
-      int reachable_count = 0;
-      for (int dist : output_data) {
-        if (dist < std::numeric_limits<int>::max()) {
-          reachable_count++;
-        }
-      }
-      if (reachable_count < kVertices_ / 2) {
-        return false;
-      }
+  }
+  int reachable_count = 0;
+  for (int dist : output_data) {
+    if (dist < std::numeric_limits<int>::max()) {
+      reachable_count++;
     }
+  }
+  return reachable_count >= vertices / 2;
+}
 
-    return true;
+}  // namespace
+
+class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  bool CheckTestOutputData(OutType &output_data) final {
+    return CheckDistances(kVertices, output_data);
   }
 
-  InType GetTestInputData() final {
-    return input_data_;
+  // Generated once per suite; both implementations borrow the shared graph instead of copying it
+  ppc::task::SharedInput<InType> GetSharedTestInputData() final {
+    return GetSharedInput([] { return GenerateTestGraph(kVertices); });
   }
 };
 
@@ -86,4 +89,31 @@ const auto kPerfTestName = OlesnitskiyVDijkstraCrsPerfTest::CustomPerfTestName;
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, OlesnitskiyVDijkstraCrsPerfTest, kGtestValues, kPerfTestName);
 
+// Graph sizes from 1000 vertices up to the perf test size, to find where MPI overtakes SEQ
+class OlesnitskiyVDijkstraCrsSweepPerfTest : public ppc::util::BaseRunSweepPerfTests<InType, OutType> {
+  ppc::util::SizeSweep GetSizeSweep() final {
+    return {.min_size = 1000, .max_size = kVertices, .factor = 4.0};
+  }
+
+  InType GetSweepInput(std::size_t size) final {
+    return GenerateTestGraph(static_cast<int>(size));
+  }
+
+  bool CheckSweepOutput(std::size_t size, OutType &output_data) final {
+    return CheckDistances(static_cast<int>(size), output_data);
+  }
+};
+
+TEST_P(OlesnitskiyVDijkstraCrsSweepPerfTest, RunSizeSweep) {
+  ExecuteSweep(GetParam());
+}
+
+const auto kSweepPerfTasks =
+    ppc::util::MakeSweepPerfTasks<InType, OlesnitskiyVDijkstraCrsSEQ, OlesnitskiyVDijkstraCrsMPI>(
+        PPC_SETTINGS_olesnitskiy_v_dijkstra_crs);
+
+INSTANTIATE_TEST_SUITE_P(SizeSweepTests, OlesnitskiyVDijkstraCrsSweepPerfTest,
+                         ppc::util::TupleToGTestValues(kSweepPerfTasks),
+                         OlesnitskiyVDijkstraCrsSweepPerfTest::CustomSweepTestName);
+
 }  // namespace olesnitskiy_v_dijkstra_crs
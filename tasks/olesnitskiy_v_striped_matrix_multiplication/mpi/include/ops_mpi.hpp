@@ -22,8 +22,10 @@ class OlesnitskiyVStripedMatrixMultiplicationMPI : public ppc::task::Task<InType
   bool PostProcessingImpl() override;
 
  private:
-  static std::vector<int> CalculateCounts(int total, int num_parts);
-  static std::vector<int> CalculateDisplacements(const std::vector<int> &counts);
+  void ReuseImpl() override;
+  static void CalculateCounts(int total, int num_parts, std::vector<int> &counts);
+  static void CalculateDisplacements(const std::vector<int> &counts, std::vector<int> &displs);
+  void StoreOutput(size_t rows, size_t cols, const std::vector<double> &data);
   bool RunOnSingleProcess();
   bool ScatterData();
   bool BroadcastMatrixB();
@@ -19,24 +19,38 @@ OlesnitskiyVStripedMatrixMultiplicationMPI::OlesnitskiyVStripedMatrixMultiplicat
   MPI_Comm_size(MPI_COMM_WORLD, &world_size_);
 }
 
-std::vector<int> OlesnitskiyVStripedMatrixMultiplicationMPI::CalculateCounts(int total, int num_parts) {
-  std::vector<int> counts(num_parts, 0);
+void OlesnitskiyVStripedMatrixMultiplicationMPI::CalculateCounts(int total, int num_parts, std::vector<int> &counts) {
+  counts.assign(num_parts, 0);
   int base = total / num_parts;
   int remainder = total % num_parts;
 
   for (int i = 0; i < num_parts; ++i) {
     counts[i] = base + (i < remainder ? 1 : 0);
   }
-
-  return counts;
 }
 
-std::vector<int> OlesnitskiyVStripedMatrixMultiplicationMPI::CalculateDisplacements(const std::vector<int> &counts) {
-  std::vector<int> displs(counts.size(), 0);
+void OlesnitskiyVStripedMatrixMultiplicationMPI::CalculateDisplacements(const std::vector<int> &counts,
+                                                                        std::vector<int> &displs) {
+  displs.assign(counts.size(), 0);
   for (size_t i = 1; i < counts.size(); ++i) {
     displs[i] = displs[i - 1] + counts[i - 1];
   }
-  return displs;
+}
+
+void OlesnitskiyVStripedMatrixMultiplicationMPI::ReuseImpl() {
+  // Keep the capacity of the output matrix for the next input
+  auto &[rows, cols, data] = GetOutput();
+  rows = 0;
+  cols = 0;
+  data.clear();
+}
+
+void OlesnitskiyVStripedMatrixMultiplicationMPI::StoreOutput(size_t rows, size_t cols,
+                                                             const std::vector<double> &data) {
+  auto &[out_rows, out_cols, out_data] = GetOutput();
+  out_rows = rows;
+  out_cols = cols;
+  out_data.assign(data.begin(), data.end());
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::ValidationImpl() {
@@ -68,22 +82,17 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::PreProcessingImpl() {
 }
 
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::PrepareScatterData() {
-  auto row_counts = CalculateCounts(static_cast<int>(rows_a_), world_size_);
-  auto row_displs = CalculateDisplacements(row_counts);
-  rows_a_local_ = row_counts[rank_];
+  CalculateCounts(static_cast<int>(rows_a_), world_size_, row_counts_);
+  CalculateDisplacements(row_counts_, row_displs_);
+  rows_a_local_ = row_counts_[rank_];
 
-  std::vector<int> sendcounts_a(world_size_);
-  std::vector<int> displs_a(world_size_);
+  sendcounts_a_.resize(world_size_);
+  displs_a_.resize(world_size_);
   for (int i = 0; i < world_size_; ++i) {
-    sendcounts_a[i] = row_counts[i] * static_cast<int>(cols_a_);
-    displs_a[i] = row_displs[i] * static_cast<int>(cols_a_);
+    sendcounts_a_[i] = row_counts_[i] * static_cast<int>(cols_a_);
+    displs_a_[i] = row_displs_[i] * static_cast<int>(cols_a_);
   }
 
-  sendcounts_a_ = std::move(sendcounts_a);
-  displs_a_ = std::move(displs_a);
-  row_counts_ = std::move(row_counts);
-  row_displs_ = std::move(row_displs);
-
   return true;
 }
 
@@ -192,9 +201,9 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::BroadcastResultsFromRoot() {
   }
 
   if (result_c_.empty()) {
-    GetOutput() = {0UL, 0UL, std::vector<double>()};
+    StoreOutput(0UL, 0UL, {});
   } else {
-    GetOutput() = {rows_c_, cols_c_, result_c_};
+    StoreOutput(rows_c_, cols_c_, result_c_);
   }
 
   return true;
@@ -207,11 +216,11 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::ReceiveResultsFromRoot() {
   MPI_Bcast(&result_cols, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
   if (result_rows > 0 && result_cols > 0) {
-    std::vector<double> received_result(static_cast<size_t>(result_rows) * static_cast<size_t>(result_cols));
-    MPI_Bcast(received_result.data(), static_cast<int>(received_result.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
-    GetOutput() = {static_cast<size_t>(result_rows), static_cast<size_t>(result_cols), std::move(received_result)};
+    result_c_.resize(static_cast<size_t>(result_rows) * static_cast<size_t>(result_cols));
+    MPI_Bcast(result_c_.data(), static_cast<int>(result_c_.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    StoreOutput(static_cast<size_t>(result_rows), static_cast<size_t>(result_cols), result_c_);
   } else {
-    GetOutput() = {0UL, 0UL, std::vector<double>()};
+    StoreOutput(0UL, 0UL, {});
   }
 
   return true;
@@ -228,9 +237,9 @@ bool OlesnitskiyVStripedMatrixMultiplicationMPI::BroadcastResults() {
 bool OlesnitskiyVStripedMatrixMultiplicationMPI::SetOutput() {
   if (rank_ == 0) {
     if (result_c_.empty()) {
-      GetOutput() = {0UL, 0UL, std::vector<double>()};
+      StoreOutput(0UL, 0UL, {});
     } else {
-      GetOutput() = {rows_c_, cols_c_, result_c_};
+      StoreOutput(rows_c_, cols_c_, result_c_);
     }
   }
   return true;
@@ -1,16 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
-#include <fstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
 #include "perepelkin_i_string_diff_char_count/common/include/common.hpp"
 #include "perepelkin_i_string_diff_char_count/mpi/include/ops_mpi.hpp"
 #include "perepelkin_i_string_diff_char_count/seq/include/ops_seq.hpp"
+#include "util/include/data_file.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -29,18 +31,15 @@ class PerepelkinIStringDiffCharCountFuncTestProcesses : public ppc::util::BaseRu
     expected_count_ = params.second;
 
     std::string file_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_perepelkin_i_string_diff_char_count, file_name);
-    std::ifstream file(file_path);
-
-    if (!file.is_open()) {
-      throw std::runtime_error("Failed to open file: " + file_path);
-    }
+    const ppc::util::MappedFile file(file_path);
+    std::string_view text = file.Text();
 
     std::string str_1;
     std::string str_2;
-    if (!std::getline(file, str_1)) {
+    if (!NextLine(text, str_1)) {
       throw std::runtime_error("Failed to read first string from: " + file_path);
     }
-    if (!std::getline(file, str_2)) {
+    if (!NextLine(text, str_2)) {
       throw std::runtime_error("Failed to read second string from: " + file_path);
     }
 
@@ -49,12 +48,11 @@ class PerepelkinIStringDiffCharCountFuncTestProcesses : public ppc::util::BaseRu
     TrimCr(str_2);
 
     std::string extra_line;
-    if (std::getline(file, extra_line) && !extra_line.empty()) {
+    if (NextLine(text, extra_line) && !extra_line.empty()) {
       throw std::runtime_error("Unexpected extra data in: " + file_path + " (expected only two strings)");
     }
 
     input_data_ = std::make_pair(str_1, str_2);
-    file.close();
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -77,6 +75,17 @@ class PerepelkinIStringDiffCharCountFuncTestProcesses : public ppc::util::BaseRu
     return filename;
   }
 
+  // Reads the next line of text like std::getline
+  static bool NextLine(std::string_view &text, std::string &line) {
+    if (text.empty()) {
+      return false;
+    }
+    const std::size_t end = std::min(text.find('\n'), text.size());
+    line = text.substr(0, end);
+    text.remove_prefix(std::min(end + 1, text.size()));
+    return true;
+  }
+
   static void TrimCr(std::string &s) {
     if (!s.empty() && s.back() == '\r') {
       s.pop_back();
@@ -4,12 +4,13 @@
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace remizov_k_max_in_matrix_string {
 
-using InType = std::vector<std::vector<int>>;
+using InType = ppc::util::Matrix<int>;
 using OutType = std::vector<int>;
-using TestType = std::tuple<std::vector<std::vector<int>>, std::vector<int>>;
+using TestType = std::tuple<InType, std::vector<int>>;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
 }  // namespace remizov_k_max_in_matrix_string
@@ -13,8 +13,7 @@ namespace remizov_k_max_in_matrix_string {
 
 RemizovKMaxInMatrixStringMPI::RemizovKMaxInMatrixStringMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = in;
 }
 
 bool RemizovKMaxInMatrixStringMPI::ValidationImpl() {
@@ -31,7 +30,7 @@ std::vector<int> RemizovKMaxInMatrixStringMPI::FindMaxValues(const int start, co
     return {};
   }
 
-  const std::size_t input_size = GetInput().size();
+  const std::size_t input_size = GetInput().Rows();
   const int input_size_int = static_cast<int>(input_size);
 
   if (start >= input_size_int) {
@@ -49,9 +48,10 @@ std::vector<int> RemizovKMaxInMatrixStringMPI::FindMaxValues(const int start, co
   result.reserve(static_cast<std::size_t>(num_rows));
 
   for (int i = start; i <= actual_end; ++i) {
-    if (!GetInput()[i].empty()) {
+    const auto row = GetInput().Row(static_cast<std::size_t>(i));
+    if (!row.empty()) {
       int max_val = std::numeric_limits<int>::min();
-      for (const auto &val : GetInput()[i]) {
+      for (const auto &val : row) {
         max_val = std::max(val, max_val);
       }
       result.push_back(max_val);
@@ -94,7 +94,7 @@ std::vector<int> RemizovKMaxInMatrixStringMPI::CalculatingInterval(int size_prcs
 }
 
 bool RemizovKMaxInMatrixStringMPI::RunImpl() {
-  if (GetInput().empty()) {
+  if (GetInput().Rows() == 0) {
     return true;
   }
 
@@ -103,7 +103,7 @@ bool RemizovKMaxInMatrixStringMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  const int count_rows = static_cast<int>(GetInput().size());
+  const int count_rows = static_cast<int>(GetInput().Rows());
 
   std::vector<int> local_interval(2);
 
@@ -1,6 +1,7 @@
 #include "remizov_k_max_in_matrix_string/seq/include/ops_seq.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <vector>
 
@@ -10,8 +11,7 @@ namespace remizov_k_max_in_matrix_string {
 
 RemizovKMaxInMatrixStringSEQ::RemizovKMaxInMatrixStringSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = in;
 }
 
 bool RemizovKMaxInMatrixStringSEQ::ValidationImpl() {
@@ -24,12 +24,13 @@ bool RemizovKMaxInMatrixStringSEQ::PreProcessingImpl() {
 }
 
 bool RemizovKMaxInMatrixStringSEQ::RunImpl() {
-  if (GetInput().empty()) {
+  if (GetInput().Rows() == 0) {
     return true;
   }
 
   std::vector<int> result;
-  for (const auto &row : GetInput()) {
+  for (std::size_t i = 0; i < GetInput().Rows(); ++i) {
+    const auto row = GetInput().Row(i);
     if (!row.empty()) {
       int max_val = *std::ranges::max_element(row);
       result.push_back(max_val);
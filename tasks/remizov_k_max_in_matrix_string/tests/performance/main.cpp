@@ -17,7 +17,7 @@ class RemizovKMaxInMatrixStringPerfTest : public ppc::util::BaseRunPerfTests<InT
 
   void SetUp() override {
     int n = static_cast<int>(std::sqrt(kCount_));
-    input_data_ = std::vector<std::vector<int>>(n, std::vector<int>(n, 2));
+    input_data_ = InType(n, n, 2);
     res_ = std::vector<int>(n, 2);
   }
 
@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "mpi/include/shared_array.hpp"
 #include "safronov_m_bubble_sort_odd_even/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -20,7 +21,7 @@ class SafronovMBubbleSortOddEvenMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
   static std::vector<int> CalculatingInterval(int size_prcs, int rank, int size_arr);
-  void SendingVector(int rank);
+  ppc::mpi::NodeSharedArray<int> SendingVector(int rank);
   static void OddEvenBubble(std::vector<int> &own_data, int own_size, int begin, int phase);
   static void DataExchange(std::vector<int> &own_data, int rank, int neighbor);
   static void BasisSortingLocalArrays(std::vector<int> &own_data, std::vector<int> &interval, int size_arr, int rank,
@@ -3,8 +3,10 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <span>
 #include <vector>
 
+#include "mpi/include/shared_array.hpp"
 #include "safronov_m_bubble_sort_odd_even/common/include/common.hpp"
 
 namespace safronov_m_bubble_sort_odd_even {
@@ -23,16 +25,13 @@ bool SafronovMBubbleSortOddEvenMPI::PreProcessingImpl() {
   return true;
 }
 
-void SafronovMBubbleSortOddEvenMPI::SendingVector(int rank) {
-  int size_vec = 0;
+ppc::mpi::NodeSharedArray<int> SafronovMBubbleSortOddEvenMPI::SendingVector(int rank) {
+  std::span<const int> input;
   if (rank == 0) {
-    size_vec = static_cast<int>(GetInput().size());
+    input = GetInput();
   }
-  MPI_Bcast(&size_vec, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  if (rank != 0) {
-    GetInput().resize(size_vec);
-  }
-  MPI_Bcast(GetInput().data(), size_vec, MPI_INT, 0, MPI_COMM_WORLD);
+  // Each process copies only its interval, so a single copy per node is enough
+  return ppc::mpi::NodeSharedArray<int>::Broadcast(input, 0, MPI_COMM_WORLD);
 }
 
 std::vector<int> SafronovMBubbleSortOddEvenMPI::CalculatingInterval(int size_prcs, int rank, int size_arr) {
@@ -137,10 +136,11 @@ bool SafronovMBubbleSortOddEvenMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  SendingVector(rank);
+  const ppc::mpi::NodeSharedArray<int> shared_input = SendingVector(rank);
+  const std::span<const int> input = shared_input.View();
 
   if (rank == 0) {
-    int size_arr = static_cast<int>(GetInput().size());
+    int size_arr = static_cast<int>(input.size());
     std::vector<int> sizes_local_arrays(size);
     for (int i = 1; i < size; i++) {
       std::vector<int> interval = CalculatingInterval(size, i, size_arr);
@@ -150,7 +150,7 @@ bool SafronovMBubbleSortOddEvenMPI::RunImpl() {
     std::vector<int> interval = CalculatingInterval(size, 0, size_arr);
     std::vector<int> own_data = {};
     if (interval[0] <= interval[1]) {
-      own_data = std::vector<int>(GetInput().begin() + interval[0], GetInput().begin() + interval[1] + 1);
+      own_data = std::vector<int>(input.begin() + interval[0], input.begin() + interval[1] + 1);
     }
     BasisSortingLocalArrays(own_data, interval, size_arr, rank, size);
     GetOutput().insert(GetOutput().end(), own_data.begin(), own_data.end());
@@ -166,9 +166,9 @@ bool SafronovMBubbleSortOddEvenMPI::RunImpl() {
     MPI_Recv(buf.data(), 2, MPI_INT, 0, 0, MPI_COMM_WORLD, &status);
     std::vector<int> own_data = {};
     if (buf[0] <= buf[1]) {
-      own_data = std::vector<int>(GetInput().begin() + buf[0], GetInput().begin() + buf[1] + 1);
+      own_data = std::vector<int>(input.begin() + buf[0], input.begin() + buf[1] + 1);
     }
-    int size_arr = static_cast<int>(GetInput().size());
+    int size_arr = static_cast<int>(input.size());
     BasisSortingLocalArrays(own_data, buf, size_arr, rank, size);
     MPI_Send(own_data.data(), static_cast<int>(own_data.size()), MPI_INT, 0, 2, MPI_COMM_WORLD);
   }
@@ -5,12 +5,13 @@
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace safronov_m_sum_values_matrix {
 
-using InType = std::vector<std::vector<double>>;
+using InType = ppc::util::Matrix<double>;
 using OutType = std::vector<double>;
-using TestType = std::tuple<std::string, std::vector<std::vector<double>>, std::vector<double>>;
+using TestType = std::tuple<std::string, InType, std::vector<double>>;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
 }  // namespace safronov_m_sum_values_matrix
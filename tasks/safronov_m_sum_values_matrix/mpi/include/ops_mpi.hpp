@@ -19,9 +19,7 @@ class SafronovMSumValuesMatrixMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
   std::vector<double> SummValues(int start, int end);
-  bool SendingOutMatrix(int rank);
-  std::vector<double> ConversionToVector(int rows, int cols, int rank);
-  void ConversionToMatrix(const std::vector<double> &vector, int rows, int cols, int rank);
+  bool SendingOutMatrix();
   static std::vector<int> CalculatingInterval(int size_prcs, int rank, int count_column);
 };
 
@@ -5,26 +5,22 @@
 #include <cstddef>
 #include <vector>
 
+#include "mpi/include/matrix.hpp"
 #include "safronov_m_sum_values_matrix/common/include/common.hpp"
 
 namespace safronov_m_sum_values_matrix {
 
 SafronovMSumValuesMatrixMPI::SafronovMSumValuesMatrixMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = in;
 }
 
 bool SafronovMSumValuesMatrixMPI::ValidationImpl() {
-  if (GetInput().empty()) {
+  if (GetInput().Rows() == 0) {
     return true;
   }
-  size_t cols = GetInput()[0].size();
-  std::size_t total = 0;
-  for (const auto &row : GetInput()) {
-    total += row.size();
-  }
-  return GetOutput().empty() && (cols != 0) && ((cols * GetInput().size()) == total);
+  // Matrix rows always have equal length
+  return GetOutput().empty() && (GetInput().Cols() != 0);
 }
 
 bool SafronovMSumValuesMatrixMPI::PreProcessingImpl() {
@@ -36,8 +32,8 @@ std::vector<double> SafronovMSumValuesMatrixMPI::SummValues(const int start, con
   std::vector<double> vec;
   for (int i = start; i <= end; i++) {
     double summa = 0;
-    for (const auto &row : GetInput()) {
-      summa += row[i];
+    for (std::size_t row = 0; row < GetInput().Rows(); row++) {
+      summa += GetInput()(row, i);
     }
     vec.push_back(summa);
   }
@@ -63,50 +59,10 @@ std::vector<int> SafronovMSumValuesMatrixMPI::CalculatingInterval(int size_prcs,
   return vec;
 }
 
-std::vector<double> SafronovMSumValuesMatrixMPI::ConversionToVector(int rows, int cols, int rank) {
-  std::vector<double> vector(static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols));
-  if (rank == 0) {
-    for (int i = 0; i < rows; i++) {
-      for (int j = 0; j < cols; j++) {
-        vector[(i * cols) + j] = GetInput()[i][j];
-      }
-    }
-  }
-  return vector;
-}
-
-void SafronovMSumValuesMatrixMPI::ConversionToMatrix(const std::vector<double> &vector, int rows, int cols, int rank) {
-  if (rank != 0) {
-    GetInput() = std::vector<std::vector<double>>(rows, std::vector<double>(cols));
-    for (int i = 0; i < rows; i++) {
-      for (int j = 0; j < cols; j++) {
-        GetInput()[i][j] = vector[(i * cols) + j];
-      }
-    }
-  }
-}
-
-bool SafronovMSumValuesMatrixMPI::SendingOutMatrix(int rank) {
-  int rows = 0;
-  int cols = 0;
-  if (rank == 0) {
-    rows = static_cast<int>(GetInput().size());
-    cols = (rows != 0) ? static_cast<int>(GetInput()[0].size()) : 0;
-  }
-
-  MPI_Bcast(&rows, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&cols, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  if (rows == 0) {
-    return true;
-  }
-
-  std::vector<double> vector = ConversionToVector(rows, cols, rank);
-
-  MPI_Bcast(vector.data(), rows * cols, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-  ConversionToMatrix(vector, rows, cols, rank);
-
-  return false;
+bool SafronovMSumValuesMatrixMPI::SendingOutMatrix() {
+  // The matrix is one contiguous buffer, so it is broadcast together with its shape without flattening
+  ppc::mpi::Bcast(GetInput(), 0, MPI_COMM_WORLD);
+  return GetInput().Rows() == 0;
 }
 
 bool SafronovMSumValuesMatrixMPI::RunImpl() {
@@ -115,13 +71,13 @@ bool SafronovMSumValuesMatrixMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  bool flag = SendingOutMatrix(rank);
+  bool flag = SendingOutMatrix();
   if (flag) {
     return true;
   }
 
   if (rank == 0) {
-    int count_column = static_cast<int>(GetInput()[0].size());
+    int count_column = static_cast<int>(GetInput().Cols());
 
     for (int i = 1; i < size; i++) {
       std::vector<int> interval = CalculatingInterval(size, i, count_column);
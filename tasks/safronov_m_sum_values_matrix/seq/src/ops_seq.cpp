@@ -9,20 +9,15 @@ namespace safronov_m_sum_values_matrix {
 
 SafronovMSumValuesMatrixSEQ::SafronovMSumValuesMatrixSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = in;
 }
 
 bool SafronovMSumValuesMatrixSEQ::ValidationImpl() {
-  if (GetInput().empty()) {
+  if (GetInput().Rows() == 0) {
     return true;
   }
-  size_t cols = GetInput()[0].size();
-  std::size_t total = 0;
-  for (const auto &row : GetInput()) {
-    total += row.size();
-  }
-  return GetOutput().empty() && (cols != 0) && ((cols * GetInput().size()) == total);
+  // Matrix rows always have equal length
+  return GetOutput().empty() && (GetInput().Cols() != 0);
 }
 
 bool SafronovMSumValuesMatrixSEQ::PreProcessingImpl() {
@@ -31,16 +26,15 @@ bool SafronovMSumValuesMatrixSEQ::PreProcessingImpl() {
 }
 
 bool SafronovMSumValuesMatrixSEQ::RunImpl() {
-  if (GetInput().empty()) {
+  if (GetInput().Rows() == 0) {
     return true;
   }
-  std::vector<double> vector(GetInput()[0].size());
-  for (size_t i = 0; i < GetInput()[0].size(); i++) {
-    double summa = 0;
-    for (const auto &row : GetInput()) {
-      summa += row[i];
+  std::vector<double> vector(GetInput().Cols(), 0.0);
+  for (size_t row = 0; row < GetInput().Rows(); row++) {
+    const auto values = GetInput().Row(row);
+    for (size_t i = 0; i < values.size(); i++) {
+      vector[i] += values[i];
     }
-    vector[i] = summa;
   }
   GetOutput() = vector;
   return true;
@@ -57,30 +57,30 @@ TEST_P(SafronovMSumValuesMatrixFuncTests, SumColumnsMatrix) {
 }
 
 const std::array<TestType, 10> kTestParam = {
-    std::make_tuple("a", std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
+    std::make_tuple("a", InType{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
                     std::vector<double>({12.0, 15.0, 18.0})),
-    std::make_tuple("b", std::vector<std::vector<double>>{{1, 2, 3}}, std::vector<double>({1.0, 2.0, 3.0})),
-    std::make_tuple("v", std::vector<std::vector<double>>{{1, 2, 3, 4}, {4, 5, 6, 7}, {7, 8, 9, 10}},
+    std::make_tuple("b", InType{{1, 2, 3}}, std::vector<double>({1.0, 2.0, 3.0})),
+    std::make_tuple("v", InType{{1, 2, 3, 4}, {4, 5, 6, 7}, {7, 8, 9, 10}},
                     std::vector<double>({12.0, 15.0, 18.0, 21.0})),
-    std::make_tuple("d", std::vector<std::vector<double>>{{-1.1, -2.2, -3.3}, {-4.4, 5, 6}, {2.4, 6, 4.5}},
+    std::make_tuple("d", InType{{-1.1, -2.2, -3.3}, {-4.4, 5, 6}, {2.4, 6, 4.5}},
                     std::vector<double>({-3.1, 8.8, 7.2})),
-    std::make_tuple("e", std::vector<std::vector<double>>(100, std::vector<double>(100, 1)),
+    std::make_tuple("e", InType(100, 100, 1),
                     std::vector<double>(100, 100.0)),
-    std::make_tuple("i", std::vector<std::vector<double>>(0), std::vector<double>(0)),
+    std::make_tuple("i", InType(), std::vector<double>(0)),
     std::make_tuple("g",
-                    std::vector<std::vector<double>>{
+                    InType{
                         {1.5, -2.0, 3.3, 4.1}, {0.5, 2.2, -1.3, 0.9}, {-3.0, 1.1, 4.0, -2.0}, {2.0, 0.0, -2.0, 1.0}},
                     std::vector<double>({1.0, 1.3, 4.0, 4.0})),
     std::make_tuple("c",
-                    std::vector<std::vector<double>>{
+                    InType{
                         {-10.0, 2.5, 3.0, -4.0, 100.0}, {5.0, -1.5, 20.0, 3.0, -50.0}, {2.0, 0.0, -5.0, 1.0, 25.0}},
                     std::vector<double>({-3.0, 1.0, 18.0, 0.0, 75.0})),
     std::make_tuple("j",
-                    std::vector<std::vector<double>>{
+                    InType{
                         {1.1, 2.2, 3.3}, {1.1, 2.2, 3.3}, {1.1, 2.2, 3.3}, {1.1, 2.2, 3.3}, {1.1, 2.2, 3.3}},
                     std::vector<double>({5.5, 11.0, 16.5})),
     std::make_tuple("m",
-                    std::vector<std::vector<double>>{{3.0, 1.0, -2.0, 4.0, 0.5, -1.5},
+                    InType{{3.0, 1.0, -2.0, 4.0, 0.5, -1.5},
                                                      {-1.0, 2.5, 3.5, -2.0, 4.0, 0.0},
                                                      {5.0, -3.0, 1.0, 0.0, -2.5, 10.0},
                                                      {0.0, 4.0, -1.0, 3.0, 1.0, -4.0}},
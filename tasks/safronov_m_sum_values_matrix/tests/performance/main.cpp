@@ -18,7 +18,7 @@ class SafronovMSumValuesMatrixPerfTest : public ppc::util::BaseRunPerfTests<InTy
 
   void SetUp() override {
     int n = static_cast<int>(std::sqrt(kCount_));
-    input_data_ = std::vector<std::vector<double>>(n, std::vector<double>(n, 2));
+    input_data_ = InType(n, n, 2);
     res_ = std::vector<double>(2000, 4000.0);
   }
 
@@ -2,16 +2,16 @@
 
 #include <tuple>
 #include <utility>
-#include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
-using InType = std::pair<std::vector<std::vector<double>>, std::vector<std::vector<double>>>;
-using OutType = std::vector<std::vector<double>>;
-using TestType = std::tuple<int, std::vector<std::vector<double>>, std::vector<std::vector<double>>,
-                            std::vector<std::vector<double>>>;
+using Matrix = ppc::util::Matrix<double>;
+using InType = std::pair<Matrix, Matrix>;
+using OutType = Matrix;
+using TestType = std::tuple<int, Matrix, Matrix, Matrix>;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
 }  // namespace sosnina_a_matrix_mult_horizontal
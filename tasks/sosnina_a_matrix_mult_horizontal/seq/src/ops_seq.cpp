@@ -2,42 +2,29 @@
 
 #include <cstddef>
 #include <utility>
-#include <vector>
+
+#include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
-SosninaAMatrixMultHorizontalSEQ::SosninaAMatrixMultHorizontalSEQ(InTypeTriple in) : input_(std::move(in)) {
+SosninaAMatrixMultHorizontalSEQ::SosninaAMatrixMultHorizontalSEQ(InType in) : input_(std::move(in)) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetOutput() = std::vector<std::vector<double>>();
+  GetOutput() = Matrix();
 }
 
 bool SosninaAMatrixMultHorizontalSEQ::ValidationImpl() {
   const auto &matrix_a = input_.first;
   const auto &matrix_b = input_.second;
 
-  if (matrix_a.empty() || matrix_b.empty()) {
+  if (matrix_a.Empty() || matrix_b.Empty()) {
     return false;
   }
 
-  size_t cols_a = matrix_a[0].size();
-  for (size_t i = 1; i < matrix_a.size(); i++) {
-    if (matrix_a[i].size() != cols_a) {
-      return false;
-    }
-  }
-
-  size_t cols_b = matrix_b[0].size();
-  for (size_t i = 1; i < matrix_b.size(); i++) {
-    if (matrix_b[i].size() != cols_b) {
-      return false;
-    }
-  }
-
-  return cols_a == matrix_b.size();
+  return matrix_a.Cols() == matrix_b.Rows();
 }
 
 bool SosninaAMatrixMultHorizontalSEQ::PreProcessingImpl() {
-  GetOutput().clear();
+  GetOutput() = Matrix();
   return true;
 }
 
@@ -45,19 +32,19 @@ bool SosninaAMatrixMultHorizontalSEQ::RunImpl() {
   const auto &matrix_a = input_.first;
   const auto &matrix_b = input_.second;
 
-  size_t rows_a = matrix_a.size();
-  size_t cols_a = matrix_a[0].size();
-  size_t cols_b = matrix_b[0].size();
+  size_t rows_a = matrix_a.Rows();
+  size_t cols_a = matrix_a.Cols();
+  size_t cols_b = matrix_b.Cols();
 
   auto &output = GetOutput();
-  output = std::vector<std::vector<double>>(rows_a, std::vector<double>(cols_b, 0.0));
+  output = Matrix(rows_a, cols_b, 0.0);
 
   // Умножение матриц
   for (size_t i = 0; i < rows_a; i++) {
     for (size_t k = 0; k < cols_a; k++) {
-      double aik = matrix_a[i][k];
+      double aik = matrix_a(i, k);
       for (size_t j = 0; j < cols_b; j++) {
-        output[i][j] += aik * matrix_b[k][j];
+        output(i, j) += aik * matrix_b(k, j);
       }
     }
   }
@@ -6,7 +6,6 @@
 #include <string>
 #include <tuple>
 #include <utility>
-#include <vector>
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_mpi.hpp"
@@ -33,19 +32,16 @@ class SosninaAMatrixMultHorizontalFuncTests : public ppc::util::BaseRunFuncTests
 
   bool CheckTestOutputData(OutType &output_data) final {
     // Проверяем размеры
-    if (output_data.size() != expected_.size()) {
-      return false;
-    }
-    if (!output_data.empty() && output_data[0].size() != expected_[0].size()) {
+    if (output_data.Rows() != expected_.Rows() || output_data.Cols() != expected_.Cols()) {
       return false;
     }
 
     // Используем достаточно маленький допуск
     const double tolerance = 1e-10;
 
-    for (size_t i = 0; i < expected_.size(); i++) {
-      for (size_t j = 0; j < expected_[i].size(); j++) {
-        if (std::abs(output_data[i][j] - expected_[i][j]) > tolerance) {
+    for (size_t i = 0; i < expected_.Rows(); i++) {
+      for (size_t j = 0; j < expected_.Cols(); j++) {
+        if (std::abs(output_data(i, j) - expected_(i, j)) > tolerance) {
           return false;
         }
       }
@@ -59,9 +55,9 @@ class SosninaAMatrixMultHorizontalFuncTests : public ppc::util::BaseRunFuncTests
   }
 
  private:
-  std::vector<std::vector<double>> matrixA_;
-  std::vector<std::vector<double>> matrixB_;
-  std::vector<std::vector<double>> expected_;
+  Matrix matrixA_;
+  Matrix matrixB_;
+  Matrix expected_;
 };
 
 namespace {
@@ -79,135 +75,98 @@ TEST_P(SosninaAMatrixMultHorizontalFuncTests, CoverageTests) {
 // Тестовые случаи: (id, matrixA, matrixB, expected)
 const std::array<TestType, 22> kFunctionalTests = {
     // 1. Базовое умножение 2x2
-    std::make_tuple(1, std::vector<std::vector<double>>{{1, 2}, {3, 4}},
-                    std::vector<std::vector<double>>{{5, 6}, {7, 8}},
-                    std::vector<std::vector<double>>{{19, 22}, {43, 50}}),
+    std::make_tuple(1, Matrix{{1, 2}, {3, 4}}, Matrix{{5, 6}, {7, 8}}, Matrix{{19, 22}, {43, 50}}),
 
     // 2. Единичная матрица
-    std::make_tuple(2, std::vector<std::vector<double>>{{1, 0}, {0, 1}},
-                    std::vector<std::vector<double>>{{1, 2}, {3, 4}}, std::vector<std::vector<double>>{{1, 2}, {3, 4}}),
+    std::make_tuple(2, Matrix{{1, 0}, {0, 1}}, Matrix{{1, 2}, {3, 4}}, Matrix{{1, 2}, {3, 4}}),
 
     // 3. Матрица из единиц
-    std::make_tuple(3, std::vector<std::vector<double>>{{1, 1}, {1, 1}},
-                    std::vector<std::vector<double>>{{1, 1}, {1, 1}}, std::vector<std::vector<double>>{{2, 2}, {2, 2}}),
+    std::make_tuple(3, Matrix{{1, 1}, {1, 1}}, Matrix{{1, 1}, {1, 1}}, Matrix{{2, 2}, {2, 2}}),
 
     // 4. Диагональные матрицы
-    std::make_tuple(4, std::vector<std::vector<double>>{{2, 0}, {0, 2}},
-                    std::vector<std::vector<double>>{{3, 0}, {0, 3}}, std::vector<std::vector<double>>{{6, 0}, {0, 6}}),
+    std::make_tuple(4, Matrix{{2, 0}, {0, 2}}, Matrix{{3, 0}, {0, 3}}, Matrix{{6, 0}, {0, 6}}),
 
     // 5. Вектор-строка на вектор-столбец
-    std::make_tuple(5, std::vector<std::vector<double>>{{1, 2, 3}}, std::vector<std::vector<double>>{{4}, {5}, {6}},
-                    std::vector<std::vector<double>>{{32}}),
+    std::make_tuple(5, Matrix{{1, 2, 3}}, Matrix{{4}, {5}, {6}}, Matrix{{32}}),
 
     // 6. Вектор-столбец на вектор-строку
-    std::make_tuple(6, std::vector<std::vector<double>>{{1}, {2}, {3}}, std::vector<std::vector<double>>{{4, 5, 6}},
-                    std::vector<std::vector<double>>{{4, 5, 6}, {8, 10, 12}, {12, 15, 18}}),
+    std::make_tuple(6, Matrix{{1}, {2}, {3}}, Matrix{{4, 5, 6}}, Matrix{{4, 5, 6}, {8, 10, 12}, {12, 15, 18}}),
 
     // 7. Неквадратные матрицы
-    std::make_tuple(7, std::vector<std::vector<double>>{{1, 2}, {3, 4}},
-                    std::vector<std::vector<double>>{{5, 6}, {7, 8}},
-                    std::vector<std::vector<double>>{{19, 22}, {43, 50}}),
+    std::make_tuple(7, Matrix{{1, 2}, {3, 4}}, Matrix{{5, 6}, {7, 8}}, Matrix{{19, 22}, {43, 50}}),
 
     // 8. 1x1 матрицы
-    std::make_tuple(8, std::vector<std::vector<double>>{{1}}, std::vector<std::vector<double>>{{1}},
-                    std::vector<std::vector<double>>{{1}}),
+    std::make_tuple(8, Matrix{{1}}, Matrix{{1}}, Matrix{{1}}),
 
     // 9. Нулевая матрица
-    std::make_tuple(9, std::vector<std::vector<double>>{{0, 0}, {0, 0}},
-                    std::vector<std::vector<double>>{{1, 2}, {3, 4}}, std::vector<std::vector<double>>{{0, 0}, {0, 0}}),
+    std::make_tuple(9, Matrix{{0, 0}, {0, 0}}, Matrix{{1, 2}, {3, 4}}, Matrix{{0, 0}, {0, 0}}),
 
     // 10. Скалярное умножение
-    std::make_tuple(10, std::vector<std::vector<double>>{{2}}, std::vector<std::vector<double>>{{3}},
-                    std::vector<std::vector<double>>{{6}}),
+    std::make_tuple(10, Matrix{{2}}, Matrix{{3}}, Matrix{{6}}),
 
     // 11. 2x3 на 3x2
-    std::make_tuple(11, std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}},
-                    std::vector<std::vector<double>>{{7, 8}, {9, 10}, {11, 12}},
-                    std::vector<std::vector<double>>{{58, 64}, {139, 154}}),
+    std::make_tuple(11, Matrix{{1, 2, 3}, {4, 5, 6}}, Matrix{{7, 8}, {9, 10}, {11, 12}}, Matrix{{58, 64}, {139, 154}}),
 
     // 12. Единичная матрица 3x3
-    std::make_tuple(12, std::vector<std::vector<double>>{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
-                    std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
-                    std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}),
+    std::make_tuple(12, Matrix{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}, Matrix{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
+                    Matrix{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}),
 
     // 13. Дробные числа
-    std::make_tuple(13, std::vector<std::vector<double>>{{0.5, 0.5}, {0.5, 0.5}},
-                    std::vector<std::vector<double>>{{2, 4}, {6, 8}}, std::vector<std::vector<double>>{{4, 6}, {4, 6}}),
+    std::make_tuple(13, Matrix{{0.5, 0.5}, {0.5, 0.5}}, Matrix{{2, 4}, {6, 8}}, Matrix{{4, 6}, {4, 6}}),
 
     // 14. 3x2 на 2x3
-    std::make_tuple(14, std::vector<std::vector<double>>{{1, 1}, {1, 1}, {1, 1}},
-                    std::vector<std::vector<double>>{{1, 1, 1}, {1, 1, 1}},
-                    std::vector<std::vector<double>>{{2, 2, 2}, {2, 2, 2}, {2, 2, 2}}),
+    std::make_tuple(14, Matrix{{1, 1}, {1, 1}, {1, 1}}, Matrix{{1, 1, 1}, {1, 1, 1}},
+                    Matrix{{2, 2, 2}, {2, 2, 2}, {2, 2, 2}}),
 
     // 15. Обратное умножение
-    std::make_tuple(15, std::vector<std::vector<double>>{{2, 4}, {6, 8}},
-                    std::vector<std::vector<double>>{{1, 0}, {0, 1}}, std::vector<std::vector<double>>{{2, 4}, {6, 8}}),
+    std::make_tuple(15, Matrix{{2, 4}, {6, 8}}, Matrix{{1, 0}, {0, 1}}, Matrix{{2, 4}, {6, 8}}),
 
     // 16. 3x2 на 2x3
-    std::make_tuple(16, std::vector<std::vector<double>>{{1, 2}, {3, 4}, {5, 6}},
-                    std::vector<std::vector<double>>{{7, 8, 9}, {10, 11, 12}},
-                    std::vector<std::vector<double>>{{27, 30, 33}, {61, 68, 75}, {95, 106, 117}}),
+    std::make_tuple(16, Matrix{{1, 2}, {3, 4}, {5, 6}}, Matrix{{7, 8, 9}, {10, 11, 12}},
+                    Matrix{{27, 30, 33}, {61, 68, 75}, {95, 106, 117}}),
 
     // 17. Дробные числа 2
-    std::make_tuple(17, std::vector<std::vector<double>>{{0.1, 0.2}, {0.3, 0.4}},
-                    std::vector<std::vector<double>>{{5, 6}, {7, 8}},
-                    std::vector<std::vector<double>>{{1.9, 2.2}, {4.3, 5.0}}),
+    std::make_tuple(17, Matrix{{0.1, 0.2}, {0.3, 0.4}}, Matrix{{5, 6}, {7, 8}}, Matrix{{1.9, 2.2}, {4.3, 5.0}}),
 
     // 18. Матрица из двоек
-    std::make_tuple(18, std::vector<std::vector<double>>{{1, 1}, {1, 1}},
-                    std::vector<std::vector<double>>{{2, 2}, {2, 2}}, std::vector<std::vector<double>>{{4, 4}, {4, 4}}),
+    std::make_tuple(18, Matrix{{1, 1}, {1, 1}}, Matrix{{2, 2}, {2, 2}}, Matrix{{4, 4}, {4, 4}}),
 
     // 19. Скаляр 3x4
-    std::make_tuple(19, std::vector<std::vector<double>>{{3}}, std::vector<std::vector<double>>{{4}},
-                    std::vector<std::vector<double>>{{12}}),
+    std::make_tuple(19, Matrix{{3}}, Matrix{{4}}, Matrix{{12}}),
 
     // 20. Частично нулевая матрица
-    std::make_tuple(20, std::vector<std::vector<double>>{{1, 0}, {0, 0}},
-                    std::vector<std::vector<double>>{{0, 1}, {0, 0}}, std::vector<std::vector<double>>{{0, 1}, {0, 0}}),
+    std::make_tuple(20, Matrix{{1, 0}, {0, 0}}, Matrix{{0, 1}, {0, 0}}, Matrix{{0, 1}, {0, 0}}),
 
     // 21. Обратная единичная
-    std::make_tuple(21, std::vector<std::vector<double>>{{2, 3}, {4, 5}},
-                    std::vector<std::vector<double>>{{1, 0}, {0, 1}}, std::vector<std::vector<double>>{{2, 3}, {4, 5}}),
+    std::make_tuple(21, Matrix{{2, 3}, {4, 5}}, Matrix{{1, 0}, {0, 1}}, Matrix{{2, 3}, {4, 5}}),
 
     // 22. Умножение на нулевую матрицу
-    std::make_tuple(22, std::vector<std::vector<double>>{{1, 2}, {3, 4}},
-                    std::vector<std::vector<double>>{{0, 0}, {0, 0}},
-                    std::vector<std::vector<double>>{{0, 0}, {0, 0}})};
+    std::make_tuple(22, Matrix{{1, 2}, {3, 4}}, Matrix{{0, 0}, {0, 0}}, Matrix{{0, 0}, {0, 0}})};
 
 const std::array<TestType, 10> kCoverageTests = {
-    std::make_tuple(23, std::vector<std::vector<double>>{{1}}, std::vector<std::vector<double>>{{1}},
-                    std::vector<std::vector<double>>{{1}}),
+    std::make_tuple(23, Matrix{{1}}, Matrix{{1}}, Matrix{{1}}),
 
-    std::make_tuple(24, std::vector<std::vector<double>>{{0}}, std::vector<std::vector<double>>{{0}},
-                    std::vector<std::vector<double>>{{0}}),
+    std::make_tuple(24, Matrix{{0}}, Matrix{{0}}, Matrix{{0}}),
 
-    std::make_tuple(25, std::vector<std::vector<double>>{{1, 2}, {3, 4}},
-                    std::vector<std::vector<double>>{{1, 0}, {0, 1}}, std::vector<std::vector<double>>{{1, 2}, {3, 4}}),
+    std::make_tuple(25, Matrix{{1, 2}, {3, 4}}, Matrix{{1, 0}, {0, 1}}, Matrix{{1, 2}, {3, 4}}),
 
-    std::make_tuple(26, std::vector<std::vector<double>>{{1, 1}, {1, 1}},
-                    std::vector<std::vector<double>>{{2, 2}, {2, 2}}, std::vector<std::vector<double>>{{4, 4}, {4, 4}}),
+    std::make_tuple(26, Matrix{{1, 1}, {1, 1}}, Matrix{{2, 2}, {2, 2}}, Matrix{{4, 4}, {4, 4}}),
 
-    std::make_tuple(27, std::vector<std::vector<double>>{{0.5}}, std::vector<std::vector<double>>{{2}},
-                    std::vector<std::vector<double>>{{1}}),
+    std::make_tuple(27, Matrix{{0.5}}, Matrix{{2}}, Matrix{{1}}),
 
-    std::make_tuple(28, std::vector<std::vector<double>>{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
-                    std::vector<std::vector<double>>{{5, 6, 7}, {8, 9, 10}, {11, 12, 13}},
-                    std::vector<std::vector<double>>{{5, 6, 7}, {8, 9, 10}, {11, 12, 13}}),
+    std::make_tuple(28, Matrix{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}, Matrix{{5, 6, 7}, {8, 9, 10}, {11, 12, 13}},
+                    Matrix{{5, 6, 7}, {8, 9, 10}, {11, 12, 13}}),
 
-    std::make_tuple(29, std::vector<std::vector<double>>{{2, 4}, {6, 8}},
-                    std::vector<std::vector<double>>{{0.5, 0}, {0, 0.5}},
-                    std::vector<std::vector<double>>{{1, 2}, {3, 4}}),
+    std::make_tuple(29, Matrix{{2, 4}, {6, 8}}, Matrix{{0.5, 0}, {0, 0.5}}, Matrix{{1, 2}, {3, 4}}),
 
     // 30. Исправленная версия: 2x3 на 3x2 (как тест 11)
-    std::make_tuple(30, std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}},   // 2x3
-                    std::vector<std::vector<double>>{{7, 8}, {9, 10}, {11, 12}},  // 3x2
-                    std::vector<std::vector<double>>{{58, 64}, {139, 154}}),      // 2x2
+    std::make_tuple(30, Matrix{{1, 2, 3}, {4, 5, 6}},   // 2x3
+                    Matrix{{7, 8}, {9, 10}, {11, 12}},  // 3x2
+                    Matrix{{58, 64}, {139, 154}}),      // 2x2
 
-    std::make_tuple(31, std::vector<std::vector<double>>{{1}, {2}, {3}}, std::vector<std::vector<double>>{{4, 5, 6}},
-                    std::vector<std::vector<double>>{{4, 5, 6}, {8, 10, 12}, {12, 15, 18}}),
+    std::make_tuple(31, Matrix{{1}, {2}, {3}}, Matrix{{4, 5, 6}}, Matrix{{4, 5, 6}, {8, 10, 12}, {12, 15, 18}}),
 
-    std::make_tuple(32, std::vector<std::vector<double>>{{1, 2, 3}}, std::vector<std::vector<double>>{{4}, {5}, {6}},
-                    std::vector<std::vector<double>>{{32}})};
+    std::make_tuple(32, Matrix{{1, 2, 3}}, Matrix{{4}, {5}, {6}}, Matrix{{32}})};
 
 const auto kFunctionalTasksList =
     std::tuple_cat(ppc::util::AddFuncTask<sosnina_a_matrix_mult_horizontal::SosninaAMatrixMultHorizontalMPI, InType>(
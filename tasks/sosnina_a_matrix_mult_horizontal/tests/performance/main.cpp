@@ -1,44 +1,54 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
-#include <vector>
 
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "sosnina_a_matrix_mult_horizontal/mpi/include/ops_mpi.hpp"
 #include "sosnina_a_matrix_mult_horizontal/seq/include/ops_seq.hpp"
+#include "util/include/bench.hpp"
+#include "task/include/task.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
 
-class SosninaAMatrixMultHorizontalRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
- public:
-  static constexpr size_t kSize = 800;
+namespace {
 
- protected:
-  void SetUp() override {
-    matrix_a_ = std::vector<std::vector<double>>(kSize, std::vector<double>(kSize));
-    matrix_b_ = std::vector<std::vector<double>>(kSize, std::vector<double>(kSize));
-
-    for (size_t i = 0; i < kSize; ++i) {
-      for (size_t j = 0; j < kSize; ++j) {
-        matrix_a_[i][j] = static_cast<double>((i * kSize) + j) * 0.001;
-        matrix_b_[i][j] = static_cast<double>(i + j) * 0.002;
-      }
+constexpr size_t kSize = 800;
+
+InType GenerateMatrices(size_t size) {
+  Matrix matrix_a(size, size);
+  Matrix matrix_b(size, size);
+
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      matrix_a(i, j) = static_cast<double>((i * size) + j) * 0.001;
+      matrix_b(i, j) = static_cast<double>(i + j) * 0.002;
     }
   }
+  return std::make_pair(std::move(matrix_a), std::move(matrix_b));
+}
+
+bool CheckProductShape(size_t size, const OutType &output_data) {
+  return output_data.Rows() == size && output_data.Cols() == size;
+}
+
+}  // namespace
 
+class SosninaAMatrixMultHorizontalRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
+ protected:
   bool CheckTestOutputData(OutType &output_data) final {
-    return !output_data.empty();
+    return CheckProductShape(kSize, output_data);
   }
 
-  InType GetTestInputData() final {
-    return std::make_pair(matrix_a_, matrix_b_);
+  ppc::task::SharedInput<InType> GetSharedTestInputData() final {
+    return GetSharedInput([] { return GenerateMatrices(kSize); });
   }
 
- private:
-  std::vector<std::vector<double>> matrix_a_;
-  std::vector<std::vector<double>> matrix_b_;
+  uint64_t GetNumElements() final {
+    return static_cast<uint64_t>(kSize) * kSize;
+  }
 };
 
 TEST_P(SosninaAMatrixMultHorizontalRunPerfTests, RunPerfModes) {
@@ -54,4 +64,9 @@ const auto kPerfTestName = SosninaAMatrixMultHorizontalRunPerfTests::CustomPerfT
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, SosninaAMatrixMultHorizontalRunPerfTests, kGtestValues, kPerfTestName);
 
+[[maybe_unused]] const bool kBenchRegistered =
+    ppc::util::RegisterBenchTasks<InType, OutType, SosninaAMatrixMultHorizontalMPI, SosninaAMatrixMultHorizontalSEQ>(
+        PPC_ID_sosnina_a_matrix_mult_horizontal,
+        {.default_size = kSize, .make = GenerateMatrices, .check = CheckProductShape, .work_exponent = 3.0});
+
 }  // namespace sosnina_a_matrix_mult_horizontal
@@ -4,10 +4,11 @@
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace trofimov_n_max_val_matrix {
 
-using InType = std::vector<std::vector<int>>;
+using InType = ppc::util::Matrix<int>;
 using OutType = std::vector<int>;
 using TestType = std::tuple<InType, OutType>;
 using BaseTask = ppc::task::Task<InType, OutType>;
@@ -3,12 +3,12 @@
 #include <mpi.h>
 
 #include <algorithm>
-#include <array>
 #include <cstddef>
+#include <span>
 #include <tuple>
-#include <utility>
 #include <vector>
 
+#include "mpi/include/matrix.hpp"
 #include "trofimov_n_max_val_matrix/common/include/common.hpp"
 
 namespace trofimov_n_max_val_matrix {
@@ -19,22 +19,16 @@ constexpr int kRootRank = 0;
 
 TrofimovNMaxValMatrixMPI::TrofimovNMaxValMatrixMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in.begin(), in.end());
+  GetInput() = in;
   GetOutput() = OutType();
 }
 
 bool TrofimovNMaxValMatrixMPI::ValidationImpl() {
-  if (GetInput().empty()) {
+  // Matrix rows always have equal length
+  if (GetInput().Rows() == 0) {
     return false;
   }
 
-  const std::size_t cols = GetInput()[0].size();
-  for (const auto &row : GetInput()) {
-    if (row.size() != cols) {
-      return false;
-    }
-  }
-
   return GetOutput().empty();
 }
 
@@ -43,7 +37,7 @@ bool TrofimovNMaxValMatrixMPI::PreProcessingImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   if (rank == kRootRank) {
-    GetOutput() = std::vector<int>(GetInput().size(), 0);
+    GetOutput() = std::vector<int>(GetInput().Rows(), 0);
   } else {
     GetOutput().clear();
   }
@@ -63,14 +57,13 @@ std::tuple<int, int> CalculateLocalRows(int rank, int size, int total_rows) {
   return {start_row, local_rows};
 }
 
-std::vector<int> CalculateLocalMaxima(const std::vector<std::vector<int>> &local_input) {
+std::vector<int> CalculateLocalMaxima(std::span<const int> local_input, int cols) {
+  const auto row_size = static_cast<std::size_t>(cols);
   std::vector<int> local_maxima;
-  local_maxima.reserve(local_input.size());
+  local_maxima.reserve(local_input.size() / row_size);
 
-  for (const auto &row : local_input) {
-    if (!row.empty()) {
-      local_maxima.push_back(*std::ranges::max_element(row));
-    }
+  for (std::size_t offset = 0; offset < local_input.size(); offset += row_size) {
+    local_maxima.push_back(std::ranges::max(local_input.subspan(offset, row_size)));
   }
 
   return local_maxima;
@@ -110,54 +103,23 @@ void GatherResults(int rank, int size, int local_rows, const std::vector<int> &l
               displacements.data(), MPI_INT, kRootRank, MPI_COMM_WORLD);
 }
 
-bool SendRowsToProcess(int dest, int total_rows, int total_cols, int size,
-                       const std::vector<std::vector<int>> &original_input) {
+void SendRowsToProcess(int dest, int total_rows, int total_cols, int size, const InType &original_input) {
   auto [dest_start_row, dest_local_rows] = CalculateLocalRows(dest, size, total_rows);
 
   if (dest_local_rows <= 0) {
-    return false;
-  }
-
-  std::array<int, 2> dest_info = {dest_local_rows, total_cols};
-  MPI_Send(dest_info.data(), 2, MPI_INT, dest, 0, MPI_COMM_WORLD);
-
-  for (int i = 0; i < dest_local_rows; ++i) {
-    int global_row = dest_start_row + i;
-    MPI_Send(original_input[static_cast<std::size_t>(global_row)].data(), total_cols, MPI_INT, dest, i + 1,
-             MPI_COMM_WORLD);
+    return;
   }
 
-  return true;
-}
-
-void ProcessRootData(int local_rows, int start_row, const std::vector<std::vector<int>> &original_input,
-                     std::vector<std::vector<int>> &local_input) {
-  local_input.reserve(static_cast<std::size_t>(local_rows));
-  for (int i = 0; i < local_rows; ++i) {
-    int global_row = start_row + i;
-    local_input.push_back(original_input[static_cast<std::size_t>(global_row)]);
-  }
+  // The block of rows is contiguous in the matrix, so it goes out as one message without a staging copy
+  const auto block = original_input.Tile(dest_start_row, 0, dest_local_rows, total_cols);
+  const auto block_type = ppc::mpi::ViewDatatype(block);
+  MPI_Send(block.Data(), 1, block_type.Get(), dest, 0, MPI_COMM_WORLD);
 }
 
-bool ReceiveRowsFromRoot(std::vector<std::vector<int>> &local_input) {
-  std::array<int, 2> recv_info = {0, 0};
-  MPI_Recv(recv_info.data(), 2, MPI_INT, kRootRank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-  int recv_rows = recv_info[0];
-  int recv_cols = recv_info[1];
-
-  if (recv_rows <= 0 || recv_cols <= 0) {
-    return false;
-  }
-
-  local_input.reserve(static_cast<std::size_t>(recv_rows));
-  for (int i = 0; i < recv_rows; ++i) {
-    std::vector<int> row(static_cast<std::size_t>(recv_cols));
-    MPI_Recv(row.data(), recv_cols, MPI_INT, kRootRank, i + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    local_input.push_back(std::move(row));
-  }
-
-  return true;
+std::vector<int> ReceiveRowsFromRoot(int local_rows, int total_cols) {
+  std::vector<int> local_input(static_cast<std::size_t>(local_rows) * static_cast<std::size_t>(total_cols));
+  MPI_Recv(local_input.data(), local_rows * total_cols, MPI_INT, kRootRank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  return local_input;
 }
 
 }  // namespace
@@ -173,10 +135,8 @@ bool TrofimovNMaxValMatrixMPI::RunImpl() {
 
   if (rank == kRootRank) {
     const auto &input = GetInput();
-    total_rows = static_cast<int>(input.size());
-    if (total_rows > 0) {
-      total_cols = static_cast<int>(input[0].size());
-    }
+    total_rows = static_cast<int>(input.Rows());
+    total_cols = static_cast<int>(input.Cols());
   }
 
   MPI_Bcast(&total_rows, 1, MPI_INT, kRootRank, MPI_COMM_WORLD);
@@ -193,12 +153,7 @@ bool TrofimovNMaxValMatrixMPI::RunImpl() {
 
   auto [start_row, local_rows] = CalculateLocalRows(rank, size, total_rows);
 
-  if (local_rows <= 0) {
-    HandleEmptyCase(rank, total_rows);
-    return true;
-  }
-
-  std::vector<std::vector<int>> local_input;
+  std::vector<int> local_maxima;
 
   if (rank == kRootRank) {
     const auto &original_input = GetInput();
@@ -207,22 +162,14 @@ bool TrofimovNMaxValMatrixMPI::RunImpl() {
       SendRowsToProcess(dest, total_rows, total_cols, size, original_input);
     }
 
-    ProcessRootData(local_rows, start_row, original_input, local_input);
-  } else {
-    const bool received = ReceiveRowsFromRoot(local_input);
-    if (!received) {
-      HandleEmptyCase(rank, total_rows);
-      return true;
-    }
-  }
-
-  if (local_input.empty()) {
-    HandleEmptyCase(rank, total_rows);
-    return true;
+    const auto own_rows = original_input.Flat().subspan(static_cast<std::size_t>(start_row) * total_cols,
+                                                        static_cast<std::size_t>(local_rows) * total_cols);
+    local_maxima = CalculateLocalMaxima(own_rows, total_cols);
+  } else if (local_rows > 0) {
+    local_maxima = CalculateLocalMaxima(ReceiveRowsFromRoot(local_rows, total_cols), total_cols);
   }
 
-  auto local_maxima = CalculateLocalMaxima(local_input);
-  GatherResults(rank, size, static_cast<int>(local_input.size()), local_maxima, GetOutput(), total_rows);
+  GatherResults(rank, size, local_rows, local_maxima, GetOutput(), total_rows);
 
   return true;
 }
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <vector>
 
 #include "trofimov_n_max_val_matrix/common/include/common.hpp"
 
@@ -10,27 +9,21 @@ namespace trofimov_n_max_val_matrix {
 
 TrofimovNMaxValMatrixSEQ::TrofimovNMaxValMatrixSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in.begin(), in.end());
+  GetInput() = in;
   GetOutput() = OutType();
 }
 
 bool TrofimovNMaxValMatrixSEQ::ValidationImpl() {
-  if (GetInput().empty()) {
+  // Matrix rows always have equal length
+  if (GetInput().Rows() == 0) {
     return false;
   }
 
-  const std::size_t cols = GetInput()[0].size();
-  for (const auto &row : GetInput()) {
-    if (row.size() != cols) {
-      return false;
-    }
-  }
-
   return GetOutput().empty();
 }
 
 bool TrofimovNMaxValMatrixSEQ::PreProcessingImpl() {
-  GetOutput().resize(GetInput().size());
+  GetOutput().resize(GetInput().Rows());
   return true;
 }
 
@@ -38,9 +31,9 @@ bool TrofimovNMaxValMatrixSEQ::RunImpl() {
   const auto &input = GetInput();
   auto &output = GetOutput();
 
-  for (std::size_t i = 0; i < input.size(); ++i) {
-    if (!input[i].empty()) {
-      output[i] = *std::ranges::max_element(input[i]);
+  for (std::size_t i = 0; i < input.Rows(); ++i) {
+    if (input.Cols() != 0) {
+      output[i] = std::ranges::max(input.Row(i));
     } else {
       output[i] = 0;
     }
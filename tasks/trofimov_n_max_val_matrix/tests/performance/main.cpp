@@ -25,22 +25,16 @@ class MaxValMatrixRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InTy
   OutType expected_output;
 
   void SetUp() override {
-    input_data.clear();
+    input_data = InType(k_matrix_size, k_matrix_size);
     expected_output.clear();
-
-    input_data.reserve(static_cast<std::size_t>(k_matrix_size));
     expected_output.reserve(static_cast<std::size_t>(k_matrix_size));
 
     for (int i = 0; i < k_matrix_size; ++i) {
-      std::vector<int> row;
-      row.reserve(static_cast<std::size_t>(k_matrix_size));
-
       for (int j = 0; j < k_matrix_size; ++j) {
-        row.push_back((i * k_matrix_size) + j);
+        input_data(i, j) = (i * k_matrix_size) + j;
       }
-      input_data.push_back(row);
 
-      expected_output.push_back(*std::ranges::max_element(input_data.back()));
+      expected_output.push_back(std::ranges::max(input_data.Row(i)));
     }
   }
 
@@ -5,10 +5,11 @@
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace zaharov_g_matrix_col_sum {
 
-using InType = std::vector<std::vector<double>>;
+using InType = ppc::util::Matrix<double>;
 using OutType = std::vector<double>;
 using TestType = std::tuple<int, std::string>;
 using BaseTask = ppc::task::Task<InType, OutType>;
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <vector>
-
 #include "task/include/task.hpp"
 #include "zaharov_g_matrix_col_sum/common/include/common.hpp"
 
@@ -12,6 +10,7 @@ class ZaharovGMatrixColSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
   explicit ZaharovGMatrixColSumMPI(const InType &in);
 
  private:
@@ -20,7 +19,6 @@ class ZaharovGMatrixColSumMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
   OutType SumColValues(int start, int end);
-  static std::vector<int> CalcInterval(int thread_amount, int rank, int column_amount);
 };
 
 }  // namespace zaharov_g_matrix_col_sum
@@ -1,29 +1,22 @@
 #include "zaharov_g_matrix_col_sum/mpi/include/ops_mpi.hpp"
 
-#include <mpi.h>
-
-#include <algorithm>
 #include <cstddef>
 #include <utility>
-#include <vector>
 
+#include "mpi/include/collectives.hpp"
+#include "mpi/include/distribution.hpp"
 #include "zaharov_g_matrix_col_sum/common/include/common.hpp"
 
 namespace zaharov_g_matrix_col_sum {
 
 ZaharovGMatrixColSumMPI::ZaharovGMatrixColSumMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = in;
 }
 
 bool ZaharovGMatrixColSumMPI::ValidationImpl() {
-  if (GetInput().empty()) {
-    return true;
-  }
-
-  size_t cols = GetInput()[0].size();
-  return std::all_of(GetInput().begin(), GetInput().end(), [cols](const auto &row) { return row.size() == cols; });
+  // Matrix rows always have equal length
+  return true;
 }
 
 bool ZaharovGMatrixColSumMPI::PreProcessingImpl() {
@@ -33,72 +26,19 @@ bool ZaharovGMatrixColSumMPI::PreProcessingImpl() {
 
 bool ZaharovGMatrixColSumMPI::RunImpl() {
   const InType &in = GetInput();
-  if (in.empty()) {
+  if (in.Rows() == 0) {
     return false;
   }
 
-  int size = 0;
-  int rank = 0;
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-
-  const int column_amount = static_cast<int>(in[0].size());
-
-  if (rank == 0) {
-    for (int i = 1; i < size; i++) {
-      std::vector<int> interval = CalcInterval(size, i, column_amount);
-      MPI_Send(interval.data(), 2, MPI_INT, i, 0, MPI_COMM_WORLD);
-    }
-
-    std::vector<int> interval = CalcInterval(size, 0, column_amount);
-    OutType elems = SumColValues(interval[0], interval[1]);
-
-    GetOutput().resize(column_amount);
-    for (size_t i = 0; i < elems.size(); i++) {
-      GetOutput()[interval[0] + i] = elems[i];
-    }
-
-    MPI_Status status;
-    for (int i = 1; i < size; i++) {
-      int elems_size = 0;
-      MPI_Recv(&elems_size, 1, MPI_INT, i, 1, MPI_COMM_WORLD, &status);
-
-      std::vector<int> remote_interval(2);
-      MPI_Recv(remote_interval.data(), 2, MPI_INT, i, 3, MPI_COMM_WORLD, &status);
-
-      OutType buf(elems_size);
-      MPI_Recv(buf.data(), elems_size, MPI_DOUBLE, i, 2, MPI_COMM_WORLD, &status);
-
-      for (size_t j = 0; j < buf.size(); j++) {
-        GetOutput()[remote_interval[0] + j] = buf[j];
-      }
-    }
-  } else {
-    MPI_Status status;
+  const int column_amount = static_cast<int>(in.Cols());
+  const ppc::mpi::BlockDistribution columns(column_amount, ppc::mpi::CommSize(GetComm()));
+  const int rank = ppc::mpi::CommRank(GetComm());
 
-    std::vector<int> buf(2);
-    MPI_Recv(buf.data(), 2, MPI_INT, 0, 0, MPI_COMM_WORLD, &status);
+  const int start = columns.Offset(rank);
+  const OutType elems = SumColValues(start, start + columns.Count(rank));
 
-    OutType elems = SumColValues(buf[0], buf[1]);
-    int elems_size = static_cast<int>(elems.size());
-
-    MPI_Send(buf.data(), 2, MPI_INT, 0, 3, MPI_COMM_WORLD);
-    MPI_Send(&elems_size, 1, MPI_INT, 0, 1, MPI_COMM_WORLD);
-    MPI_Send(elems.data(), elems_size, MPI_DOUBLE, 0, 2, MPI_COMM_WORLD);
-  }
-
-  int total_size = 0;
-  if (rank == 0) {
-    total_size = static_cast<int>(GetOutput().size());
-  }
-
-  MPI_Bcast(&total_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  if (rank != 0) {
-    GetOutput().resize(total_size);
-  }
-
-  MPI_Bcast(GetOutput().data(), total_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  GetOutput().resize(column_amount);
+  ppc::mpi::Allgather(elems, GetOutput(), columns, GetComm());
 
   return true;
 }
@@ -107,34 +47,21 @@ bool ZaharovGMatrixColSumMPI::PostProcessingImpl() {
   return true;
 }
 
-std::vector<int> ZaharovGMatrixColSumMPI::CalcInterval(int thread_amount, int rank, int column_amount) {
-  int base_chunk = column_amount / thread_amount;
-  int remainder = column_amount % thread_amount;
-
-  int start = (rank * base_chunk) + std::min(rank, remainder);
-  int end = start + base_chunk + (rank < remainder ? 1 : 0);
-
-  return {start, end};  // end is exclusive
-}
-
 OutType ZaharovGMatrixColSumMPI::SumColValues(const int start, const int end) {
   OutType out;
   const InType &in = GetInput();
 
-  if (start < 0 || std::cmp_greater(end, in[0].size()) || start >= end) {
+  if (start < 0 || std::cmp_greater(end, in.Cols()) || start >= end) {
     return out;
   }
 
-  out.reserve(end - start);
-
-  for (int col = start; col < end; col++) {
-    double sum = 0.0;
+  out.assign(end - start, 0.0);
 
-    for (const auto &row : in) {
-      sum += row[col];
+  for (size_t row = 0; row < in.Rows(); row++) {
+    const auto values = in.Row(row);
+    for (int col = start; col < end; col++) {
+      out[col - start] += values[col];
     }
-
-    out.push_back(sum);
   }
 
   return out;
@@ -1,6 +1,5 @@
 #include "zaharov_g_matrix_col_sum/seq/include/ops_seq.hpp"
 
-#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -10,17 +9,12 @@ namespace zaharov_g_matrix_col_sum {
 
 ZaharovGMatrixColSumSEQ::ZaharovGMatrixColSumSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  InType tmp(in);
-  GetInput().swap(tmp);
+  GetInput() = in;
 }
 
 bool ZaharovGMatrixColSumSEQ::ValidationImpl() {
-  if (GetInput().empty()) {
-    return true;
-  }
-
-  size_t cols = GetInput()[0].size();
-  return std::all_of(GetInput().begin(), GetInput().end(), [cols](const auto &row) { return row.size() == cols; });
+  // Matrix rows always have equal length
+  return true;
 }
 
 bool ZaharovGMatrixColSumSEQ::PreProcessingImpl() {
@@ -29,20 +23,15 @@ bool ZaharovGMatrixColSumSEQ::PreProcessingImpl() {
 }
 
 bool ZaharovGMatrixColSumSEQ::RunImpl() {
-  if (GetInput().empty()) {
-    return true;
-  }
-
-  OutType out(GetInput()[0].size());
-
-  for (size_t i = 0; i < GetInput()[0].size(); i++) {
-    double sum = 0;
-
-    for (const auto &row : GetInput()) {
-      sum += row[i];
+  const InType &in = GetInput();
+  OutType out(in.Cols(), 0.0);
+
+  // Walk the rows in storage order and accumulate each one into the column sums
+  for (size_t row = 0; row < in.Rows(); row++) {
+    const auto values = in.Row(row);
+    for (size_t col = 0; col < values.size(); col++) {
+      out[col] += values[col];
     }
-
-    out[i] = sum;
   }
   GetOutput() = out;
   return true;
@@ -2,8 +2,8 @@
 
 #include <cmath>
 #include <cstddef>
-#include <vector>
 
+#include "util/include/bench.hpp"
 #include "util/include/perf_test_util.hpp"
 #include "zaharov_g_matrix_col_sum/common/include/common.hpp"
 #include "zaharov_g_matrix_col_sum/mpi/include/ops_mpi.hpp"
@@ -11,40 +11,48 @@
 
 namespace zaharov_g_matrix_col_sum {
 
-class ZaharovGMatrixColSumPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
-  std::vector<double> expected_sums_;
+namespace {
 
-  void SetUp() override {
-    GenerateLargeMatrix(10000);
-  }
+constexpr size_t kSize = 10000;
 
-  void GenerateLargeMatrix(size_t size) {
-    input_data_.resize(size);
-    expected_sums_.resize(size, 0.0);
-
-    for (size_t i = 0; i < size; ++i) {
-      input_data_[i].resize(size);
-      for (size_t j = 0; j < size; ++j) {
-        auto value = static_cast<double>((i * size) + j + 1);
-        input_data_[i][j] = value;
-        expected_sums_[j] += value;
-      }
+InType GenerateLargeMatrix(size_t size) {
+  InType matrix(size, size);
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      matrix(i, j) = static_cast<double>((i * size) + j + 1);
     }
   }
+  return matrix;
+}
+
+// Column j holds (i * size) + j + 1 for every row i
+bool CheckColumnSums(size_t size, const OutType &output_data) {
+  if (output_data.empty() || output_data.size() != size) {
+    return false;
+  }
 
-  bool CheckTestOutputData(OutType &output_data) final {
-    if (output_data.empty() || output_data.size() != expected_sums_.size()) {
+  const auto n = static_cast<double>(size);
+  for (size_t j = 0; j < output_data.size(); j++) {
+    const double expected = (n * n * (n - 1.0) / 2.0) + (n * static_cast<double>(j + 1));
+    if (std::abs(output_data[j] - expected) > 1) {
       return false;
     }
+  }
 
-    for (size_t i = 0; i < output_data.size(); i++) {
-      if (std::abs(output_data[i] - expected_sums_[i]) > 1) {
-        return false;
-      }
-    }
+  return true;
+}
+
+}  // namespace
+
+class ZaharovGMatrixColSumPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  InType input_data_;
 
-    return true;
+  void SetUp() override {
+    input_data_ = GenerateLargeMatrix(kSize);
+  }
+
+  bool CheckTestOutputData(OutType &output_data) final {
+    return CheckColumnSums(kSize, output_data);
   }
 
   InType GetTestInputData() final {
@@ -65,4 +73,9 @@ const auto kPerfTestName = ZaharovGMatrixColSumPerfTestProcesses::CustomPerfTest
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, ZaharovGMatrixColSumPerfTestProcesses, kGtestValues, kPerfTestName);
 
+[[maybe_unused]] const bool kBenchRegistered =
+    ppc::util::RegisterBenchTasks<InType, OutType, ZaharovGMatrixColSumMPI, ZaharovGMatrixColSumSEQ>(
+        PPC_ID_zaharov_g_matrix_col_sum,
+        {.default_size = kSize, .make = GenerateLargeMatrix, .check = CheckColumnSums, .work_exponent = 2.0});
+
 }  // namespace zaharov_g_matrix_col_sum